@@ -46,7 +46,9 @@
 %   <a href="matlab:help classes\+utils\@math\ecdf">classes\+utils\@math\ecdf</a>                         -  Compute empirical cumulative distribution function
 %   <a href="matlab:help classes\+utils\@math\eigcsd">classes\+utils\@math\eigcsd</a>                       -  calculates TFs from 2D cross-correlated spectra.
 %   <a href="matlab:help classes\+utils\@math\eigpsd">classes\+utils\@math\eigpsd</a>                       -  calculates TFs from 2D cross-correlated spectra.
+%   <a href="matlab:help classes\+utils\@math\fdelay">classes\+utils\@math\fdelay</a>                       -  delays data by fractional numbers of samples with the kernel of fdkernel.
 %   <a href="matlab:help classes\+utils\@math\fdfilt_delay_core">classes\+utils\@math\fdfilt_delay_core</a>            -  core method to implement fractional delay filtering
+%   <a href="matlab:help classes\+utils\@math\fdkernel">classes\+utils\@math\fdkernel</a>                     -  builds the windowed-sinc kernel of the fractional delay filter.
 %   <a href="matlab:help classes\+utils\@math\fftdelay_core">classes\+utils\@math\fftdelay_core</a>                -  applies a delay to a timeseries using the FFT/IFFT method
 %   <a href="matlab:help classes\+utils\@math\filtfilt_filterbank">classes\+utils\@math\filtfilt_filterbank</a>          -  computes filtfilt for filterbank objects
 %   <a href="matlab:help classes\+utils\@math\filtpz">classes\+utils\@math\filtpz</a>                       - (No help available)
@@ -70,6 +72,8 @@
 %   <a href="matlab:help classes\+utils\@math\getjacobian">classes\+utils\@math\getjacobian</a>                  -  Calculate Jacobian of a given model function.
 %   <a href="matlab:help classes\+utils\@math\getk">classes\+utils\@math\getk</a>                         -  get the mathematical gain factor for a pole-zero model
 %   <a href="matlab:help classes\+utils\@math\heaviside">classes\+utils\@math\heaviside</a>                    - (No help available)
+%   <a href="matlab:help classes\+utils\@math\iirbank">classes\+utils\@math\iirbank</a>                      -  filters data with a bank of IIR filters in a single pass.
+%   <a href="matlab:help classes\+utils\@math\iirchunk">classes\+utils\@math\iirchunk</a>                     -  filters a long series with an IIR filter in parallel chunks.
 %   <a href="matlab:help classes\+utils\@math\iirinit">classes\+utils\@math\iirinit</a>                      -  defines the initial state of an IIR filter.
 %   <a href="matlab:help classes\+utils\@math\intfact">classes\+utils\@math\intfact</a>                      -  computes integer factorisation
 %   <a href="matlab:help classes\+utils\@math\isequal">classes\+utils\@math\isequal</a>                      -  test if two matrices are equal to within the given tolerance.
@@ -83,9 +87,11 @@
 %   <a href="matlab:help classes\+utils\@math\loglikelihood_matrix">classes\+utils\@math\loglikelihood_matrix</a>         - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\loglikelihood_ssm">classes\+utils\@math\loglikelihood_ssm</a>            - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\loglikelihood_ssm_td">classes\+utils\@math\loglikelihood_ssm_td</a>         - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   <a href="matlab:help classes\+utils\@math\loglikelihood_ssm_td_core">classes\+utils\@math\loglikelihood_ssm_td_core</a>    - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\loglikelihood_td">classes\+utils\@math\loglikelihood_td</a>             - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\lp2z">classes\+utils\@math\lp2z</a>                         -  converts a continous TF in to a discrete TF.
 %   <a href="matlab:help classes\+utils\@math\math">classes\+utils\@math\math</a>                         -  helper class for math utility functions.
+%   <a href="matlab:help classes\+utils\@math\mchiir">classes\+utils\@math\mchiir</a>                       -  filters many channels, each with its own IIR filter, in a single pass.
 %   <a href="matlab:help classes\+utils\@math\mhsample">classes\+utils\@math\mhsample</a>                     - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\mhsample_td">classes\+utils\@math\mhsample_td</a>                  - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\mtxiirresp">classes\+utils\@math\mtxiirresp</a>                   -  calculate iir resp by matrix product
@@ -95,6 +101,8 @@
 %   <a href="matlab:help classes\+utils\@math\music">classes\+utils\@math\music</a>                        -   Implements the heart of the MUSIC algorithm of line spectra estimation.
 %   <a href="matlab:help classes\+utils\@math\ndeigcsd">classes\+utils\@math\ndeigcsd</a>                     -  calculates TFs from ND cross-correlated spectra.
 %   <a href="matlab:help classes\+utils\@math\normalPDF">classes\+utils\@math\normalPDF</a>                    - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   <a href="matlab:help classes\+utils\@math\olsfilt">classes\+utils\@math\olsfilt</a>                      -  filters data by overlap-save with the kernel of olskernel.
+%   <a href="matlab:help classes\+utils\@math\olskernel">classes\+utils\@math\olskernel</a>                    -  builds the kernel of the overlap-save block filter from a frequency response.
 %   <a href="matlab:help classes\+utils\@math\overlapCorr">classes\+utils\@math\overlapCorr</a>                  -  Compute correlation introduced by segment overlapping
 %   <a href="matlab:help classes\+utils\@math\pf2ss">classes\+utils\@math\pf2ss</a>                        -  Convert partial fraction models to state space matrices
 %   <a href="matlab:help classes\+utils\@math\pfallps">classes\+utils\@math\pfallps</a>                      -  all pass filtering in order to stabilize TF poles and zeros.
@@ -107,6 +115,8 @@
 %   <a href="matlab:help classes\+utils\@math\pfallpz2">classes\+utils\@math\pfallpz2</a>                     -  all pass filtering to stabilize TF poles and zeros.
 %   <a href="matlab:help classes\+utils\@math\pfresp">classes\+utils\@math\pfresp</a>                       -  returns frequency response of a partial fraction TF.
 %   <a href="matlab:help classes\+utils\@math\phase">classes\+utils\@math\phase</a>                        -  return the phase in degrees for a given complex input.
+%   <a href="matlab:help classes\+utils\@math\philoxrandn">classes\+utils\@math\philoxrandn</a>                  -  draws the normal deviates of the counter-based generator of the mex files.
+%   <a href="matlab:help classes\+utils\@math\polyresample">classes\+utils\@math\polyresample</a>                 -  resamples data by P/Q with the polyphase filter of resamplekernel.
 %   <a href="matlab:help classes\+utils\@math\ppplot">classes\+utils\@math\ppplot</a>                       -  makes probability-probability plot
 %   <a href="matlab:help classes\+utils\@math\psd">classes\+utils\@math\psd</a>                          - UTILS.MATH.PSD: Pure Matlab function that performs the PSD using LTPDA machinery
 %   <a href="matlab:help classes\+utils\@math\psd2tf">classes\+utils\@math\psd2tf</a>                       -  Input power spectral density (psd) and output a stable and minimum
@@ -120,11 +130,15 @@
 %   <a href="matlab:help classes\+utils\@math\randelement">classes\+utils\@math\randelement</a>                  - RANDELEMENT(VECTOR,J) returns J random samples chosen in the VECTOR array.
 %   <a href="matlab:help classes\+utils\@math\randomWalkGen">classes\+utils\@math\randomWalkGen</a>                - Generate a random walk
 %   <a href="matlab:help classes\+utils\@math\regularizePSDForFit">classes\+utils\@math\regularizePSDForFit</a>          - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   <a href="matlab:help classes\+utils\@math\resamplekernel">classes\+utils\@math\resamplekernel</a>               -  builds the kernel of the polyphase resampler by P/Q.
 %   <a href="matlab:help classes\+utils\@math\ri2fq">classes\+utils\@math\ri2fq</a>                        -  Convert complex pole/zero into frequency/Q pole/zero representation.
 %   <a href="matlab:help classes\+utils\@math\rjsample">classes\+utils\@math\rjsample</a>                     - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\+utils\@math\rootmusic">classes\+utils\@math\rootmusic</a>                    -    Computes the frequencies and powers of sinusoids via the
 %   <a href="matlab:help classes\+utils\@math\roundn">classes\+utils\@math\roundn</a>                       -   Round to multiple of 10^n
 %   <a href="matlab:help classes\+utils\@math\slopefit">classes\+utils\@math\slopefit</a>                     -  returns the fit parameters for a linear fit of the form  y = m*x.
+%   <a href="matlab:help classes\+utils\@math\sosfilt">classes\+utils\@math\sosfilt</a>                      -  filters data with a cascade of second-order sections.
+%   <a href="matlab:help classes\+utils\@math\sosfiltfilt">classes\+utils\@math\sosfiltfilt</a>                  -  zero-phase filtering with a cascade of second-order sections.
+%   <a href="matlab:help classes\+utils\@math\sosinit">classes\+utils\@math\sosinit</a>                      -  defines the initial states of a cascade of second-order sections.
 %   <a href="matlab:help classes\+utils\@math\spcorr">classes\+utils\@math\spcorr</a>                       -  calculate Spearman Rank-Order Correlation Coefficient
 %   <a href="matlab:help classes\+utils\@math\spflat">classes\+utils\@math\spflat</a>                       -  measures the flatness of a given spectrum
 %   <a href="matlab:help classes\+utils\@math\startpoles">classes\+utils\@math\startpoles</a>                   -  defines starting poles for fitting procedures ctfit, dtfit.
@@ -2,12 +2,11 @@ function d = ctmult(C, A)
   % Multiplication function designed for the
   % purposes of the log-likelihood calculations:
   % The first input is transformed to it's conjugate
+  d = zeros(size(C,1), 1);
   for ii=1:size(C,2)
 
-    m(:,ii) = conj(C(:,ii)).*A(:,ii);
+    d = d + conj(C(:,ii)).*A(:,ii);
 
   end
-  
-  d = sum(m,2);
 
 end
\ No newline at end of file
@@ -12,12 +12,8 @@ if exist('diffStepFish.txt','file') == 2
     ! rm diffStepFish.txt
 end
 
-Nin  = size(fin,2);
-
-% defining # of inputs and outputs
-Nout = numel(outNames);
-
-step = ones(ngrid,numel(params));
+step  = ones(ngrid,numel(params));
+cache = [];
 % build matrix of steps
 % for ii = 1:length(params)
 %       step(:,ii) = [] logspace(ranges(1,ii),ranges(2,ii),ngrid);
@@ -34,46 +30,24 @@ for kk = 1:length(params)
   Rmat = [];
 
   for jj = 1:ngrid
-    for ii = 1:length(params)
-
-      tic
-      % differentiate numerically
-      dH = meval.parameterDiff(plist('names', params(ii),'values',step(jj,ii)));
-      % create plist with correct outNames (since parameterDiff change them)
-      for ll = 1:Nout
-        % create plist with correct outNames (since parameterDiff change them)
-        outputs{ll} = strrep(outNames{ll},'.', sprintf('_DIFF_%s.',params{ii})); % 2x2 case
-      end
-
-      spl = plist(...
-        'outputs',    outputs, ...
-        'inputs',     inNames, ...
-        'reorganize', true,    ...
-        'f',          freqs);
-
-      % do bode
-      dd  = bode(dH, spl);
-
-      % get numbers
-      dd = dd.objs.y;
-
-      % rearrange the transfer functions
-      d(:,:,:,ii) = reshape(dd,numel(dd(:,1)),Nout,Nin);
-
+    tic
+    % differentiate numerically. The base response of the model does not
+    % depend on the steps, so it is computed once for the whole grid.
+    [d, cache] = meval.responseDerivatives(params, step(jj,:), inNames, outNames, freqs, cache);
+
+    % get the templates
+    h = cell(1,length(params));
+    g = cell(1,length(params));
+    for i = 1:length(params)
+      h{i} = utils.math.mult(d(:,:,:,i), fin);
+      % Multiplying at once produces error.
+      g{i} = utils.math.mult(S, h{i});
     end
 
     % compute Fisher Matrix
     for i =1:length(params)
       for j =1:length(params)
-
-        % Get the template
-        h = utils.math.mult(d(:,:,:,i), fin);
-
-        % Multiplying at once produces error.
-        g = utils.math.mult(S, utils.math.mult(d(:,:,:,j), fin));
-
-        FisMat(i,j) = sum(real(utils.math.ctmult(h , g)));
-
+        FisMat(i,j) = sum(real(utils.math.ctmult(h{i} , g{j})));
       end
     end
 
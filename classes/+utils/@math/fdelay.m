@@ -0,0 +1,155 @@
+% FDELAY delays data by fractional numbers of samples with the kernel of fdkernel.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     fdelay applies the windowed-sinc fractional delay filters of
+%     fdfilt_delay_core, but the filter of each output sample is built
+%     from the kernel with a division per tap: the delays may change from
+%     a sample to the next, and many delays can be applied to the same
+%     channel at once, as in the combinations of time-delay
+%     interferometry. The cost is N operations per output sample.
+%
+%     The work is done by the ltpda_fdelay mex file when it is available:
+%     the blocks of output samples of all the delays are shared between
+%     threads.
+%
+%     Data streamed in consecutive chunks are delayed by passing the
+%     maximum delay of the stream, in samples, as the initial state of the
+%     first call, and the final state of a call as the initial state of
+%     the next one. The delays of a stream are positive. Each call gives
+%     the output samples up to (N-1)/2 samples before the last input
+%     sample received: the last ones are flushed by a final call with
+%     (N-1)/2 zeros. The samples before the stream are zeros.
+%
+% CALL:
+%
+%     y        = fdelay(x, D, kernel)
+%     [y, zf]  = fdelay(x, D, kernel, zi)
+%
+% INPUT:
+%
+%     x       data, a vector or a Nsamples x Nchannels matrix. The chunks
+%             of a stream are columns.
+%     D       delays in samples: a row of constant delays, or a matrix
+%             with the delays of each sample in a row. There is a column
+%             per channel, or any number of columns for a single channel.
+%     kernel  the kernel from fdkernel
+%     zi      initial state of a stream: its maximum delay for the first
+%             chunk, then the final state of the previous chunk
+%
+% OUTPUT:
+%
+%     y       delayed data, a column per delay. Without a state, the
+%             samples before and after x take the mean of the channel in
+%             the filters of fractional delays, and the samples delayed
+%             by a whole number of samples from outside x are zeros, as
+%             in fdfilt_delay_core.
+%     zf      final state of the stream
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, zf] = fdelay(x, D, kernel, zi)
+
+  isrow = nargin < 4 && size(x, 1) == 1 && size(D, 2) == 1;
+  if isrow
+    x = x(:);
+    D = D(:);
+  end
+  Nch = size(x, 2);
+  Nd  = size(D, 2);
+  if Nch ~= 1 && Nd == 1
+    D  = repmat(D, 1, Nch);
+    Nd = Nch;
+  end
+  if Nch ~= 1 && Nd ~= Nch
+    error('### There must be a delay per channel, or a single channel.');
+  end
+  if Nch == 1
+    chan = ones(1, Nd);
+  else
+    chan = 1:Nch;
+  end
+  if size(D, 1) ~= 1 && size(D, 1) ~= size(x, 1)
+    error('### There must be a row of delays, or a row per sample.');
+  end
+
+  if nargin < 4
+    % the samples of fdfilt_delay_core
+    Nx = size(x, 1);
+    y  = fdengine(x, D, chan, kernel, mean(x, 1), 0, Nx);
+    % whole-sample delays from outside the data give zeros
+    D  = bsxfun(@plus, zeros(Nx, Nd), D);
+    j  = bsxfun(@minus, (0:Nx-1).', round(D));
+    y(D == round(D) & (j < 0 | j >= Nx)) = 0;
+  else
+    if ~isstruct(zi)
+      zi = struct('x', zeros(0, Nch), 'n0', 0, 'ny', 0, 'D', zeros(0, Nd), 'Dmax', zi);
+    end
+    if size(zi.x, 2) ~= Nch || size(zi.D, 2) ~= Nd
+      error('### The initial state must have %d channels and %d delays.', Nch, Nd);
+    end
+    if size(D, 1) == 1
+      D = repmat(D, size(x, 1), 1);
+    end
+    x  = [zi.x; x];
+    D  = [zi.D; D];
+    n0 = zi.n0;
+    % the output samples of the input samples received so far
+    Ny = max(0, n0 + size(x, 1) - kernel.half - zi.ny);
+    if any(any(round(D(1:Ny, :)) < 0))
+      error('### The delays of a stream must be positive.');
+    end
+    if any(any(D(1:Ny, :) > zi.Dmax))
+      error('### The delays of a stream must not exceed its maximum delay %g.', zi.Dmax);
+    end
+    y = fdengine(x, D(1:Ny, :), chan, kernel, zeros(1, Nch), zi.ny - n0, Ny);
+    % and the input samples of the next ones
+    ny = zi.ny + Ny;
+    nk = max(n0, ny - ceil(zi.Dmax) - kernel.half - 1);
+    zf = struct('x', x(nk-n0+1:end, :), 'n0', nk, 'ny', ny, 'D', D(Ny+1:end, :), 'Dmax', zi.Dmax);
+  end
+
+  if isrow
+    y = y.';
+  end
+
+end
+
+function y = fdengine(x, D, chan, kernel, fill, off, Ny)
+
+  if exist('ltpda_fdelay', 'file') == 3
+    y = ltpda_fdelay(x, D, chan, kernel.ws, fill, off, Ny);
+    return
+  end
+
+  % MATLAB version: the taps of all the output samples, one after the
+  % other. The row after x holds the fill values.
+  Nx   = size(x, 1);
+  xp   = [x; fill];
+  Nd   = numel(chan);
+  D    = bsxfun(@plus, zeros(Ny, Nd), D);
+  Di   = round(D);
+  f    = D - Di;
+  j    = bsxfun(@minus, (off:off+Ny-1).', Di);
+  base = repmat((Nx+1)*(chan(:).'-1) + 1, Ny, 1);
+
+  num = zeros(Ny, Nd);
+  den = zeros(Ny, Nd);
+  for kk = -kernel.half:kernel.half
+    c   = kernel.ws(kk+kernel.half+1)./(f - kk);
+    idx = j - kk;
+    idx(idx < 0 | idx >= Nx) = Nx;
+    num = num + c.*xp(base + idx);
+    den = den + c;
+  end
+  y = num./den;
+
+  % integer delays
+  ii = f == 0;
+  idx = j(ii);
+  idx(idx < 0 | idx >= Nx) = Nx;
+  y(ii) = xp(base(ii) + idx);
+
+end
@@ -7,6 +7,9 @@
 %
 % CALL:        yd = fdfilt_delay_core(y,D,N,w)
 %
+% Except for the lagrange window, the filtering is done by utils.math.fdelay
+% with the kernel of utils.math.fdkernel.
+%
 % INPUTS:      y: input time series
 %              D: delay in samples, can be integer or fractional
 %              N: kernel length, odd positive integer (Default 51)
@@ -46,6 +49,12 @@ function yd = fdfilt_delay_core(y,D,N,w)
     if nargin < 4, w = 'blackman3'; end
     if nargin < 3, w = getDefaultWin(); N = numel(w); end
     
+    % the window does not depend on the delay: use the cached kernel
+    if ~(ischar(w) && strcmpi(w, 'lagrange'))
+      yd = utils.math.fdelay(y, D, utils.math.fdkernel(N, w));
+      return
+    end
+    
     % define k
     k = (-(N-1)/2):1:((N-1)/2);
     
@@ -0,0 +1,108 @@
+% FDKERNEL builds the windowed-sinc kernel of the fractional delay filter.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     fdkernel returns the kernel used by fdelay to delay data by
+%     fractional numbers of samples with the filters of
+%     fdfilt_delay_core: the sinc of the fraction of the delay, times a
+%     window of N taps. The window does not depend on the delay, so it is
+%     computed once: the last windows are kept for the MATLAB session.
+%
+%     The filter of a delay D with the fraction f = D - round(D) is
+%
+%       h(k) = sinc(f-k)*w(k)/sum(sinc(f-k)*w(k)),   k = -(N-1)/2..(N-1)/2
+%
+%     and, as sin(pi*(f-k)) = (-1)^k*sin(pi*f), it is built from the
+%     signed window (-1)^k*w(k) with a division per tap.
+%
+% CALL:
+%
+%     kernel = fdkernel(N)
+%     kernel = fdkernel(N, w)
+%
+% INPUT:
+%
+%     N      number of taps, odd positive integer. Default 51.
+%     w      window 'none', 'blackman' or 'blackman3' (default), or the
+%            N values of a window
+%
+% OUTPUT:
+%
+%     kernel structure with the fields
+%              N    - the number of taps
+%              half - (N-1)/2
+%              w    - the window
+%              ws   - the signed window
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function kernel = fdkernel(N, w)
+
+  persistent cache
+
+  % Number of windows kept in memory
+  Nmax = 20;
+
+  if nargin < 1 || isempty(N)
+    N = 51;
+  end
+  if nargin < 2 || isempty(w)
+    w = 'blackman3';
+  end
+
+  if ~ischar(w)
+    kernel = buildKernel(reshape(w, 1, []));
+    return
+  end
+
+  if N < 1 || mod(N, 2) ~= 1
+    error('### The number of taps must be an odd positive integer.');
+  end
+
+  key = sprintf('%s/%d', lower(w), N);
+  if isempty(cache)
+    cache = containers.Map();
+  end
+  if isKey(cache, key)
+    kernel = cache(key);
+    return
+  end
+
+  k = (-(N-1)/2):1:((N-1)/2);
+  switch lower(w)
+    case 'none'
+      w = ones(1,N);
+    case 'blackman'
+      w = 0.42+0.5*cos((2*pi*k)/(N-1))+0.08*cos((4*pi*k)/(N-1));
+    case 'blackman3'
+      w = (0.42+0.5*cos((2*pi*k)/(N-1))+0.08*cos((4*pi*k)/(N-1))).^3;
+    case 'lagrange'
+      error('### The lagrange window depends on the delay: use fdfilt_delay_core.');
+    otherwise
+      error('### Unknown window [%s]', w);
+  end
+  kernel = buildKernel(w);
+
+  if cache.Count >= Nmax
+    cache = containers.Map();
+  end
+  cache(key) = kernel;
+
+end
+
+function kernel = buildKernel(w)
+
+  N = numel(w);
+  if mod(N, 2) ~= 1
+    error('### The window must have an odd number of taps.');
+  end
+  k = (-(N-1)/2):1:((N-1)/2);
+
+  kernel.N    = N;
+  kernel.half = (N-1)/2;
+  kernel.w    = w;
+  kernel.ws   = (-1).^k.*w;
+
+end
@@ -6,70 +6,90 @@
 % INPUTS: input   -  input timeseries AO
 %         fbk     -  filterbank object
 %
+% The data are filtered forward and backward by the whole bank: a
+% parallel bank sums the outputs of its filters in each pass, a serial
+% bank filters the output of each filter with the next one. As in
+% FILTFILT, the data are extended by odd reflections of 3 times the order
+% of the bank at both ends, and each pass starts from the steady state of
+% the filters for its first sample (see iirinit).
+%
+% The work is done by the ltpda_iirfiltfilt mex file when it is
+% available; otherwise each pass is a call to iirbank.
+%
 
 function varargout = filtfilt_filterbank(input,fbk)
 
-% get filter type
-type = fbk.type;
+  % get filter type
+  switch lower(fbk.type)
+    case 'parallel'
+      serial = 0;
+    case 'serial'
+      serial = 1;
+    otherwise
+      error('### filterbank must be either ''serial'' or ''parallel''.');
+  end
 
-% if parallel: loop over filters, add the outputs
-if strcmpi(type,'parallel')
-    % initialise
-    y = zeros(size(input.y));
-    % first loop do forward filter
-    for ii = 1:numel(fbk.filters)
-        filt_in = filter(fbk.filters(ii).a, fbk.filters(ii).b, input.y);
-        y = y + filt_in;
-    end
-    
-    % reverse data series
-    yy = y(length(y):-1:1);
-    
-    y = zeros(size(input.y));
-    % second loop do backward filter
-    for ii = 1:numel(fbk.filters)
-        filt_in = filter(fbk.filters(ii).a, fbk.filters(ii).b, yy);
-        y = y + filt_in;
-    end
-    
-    % reverse data series again
-    y = y(length(y):-1:1);
-    
-    % if serial: sequentially filter, output of first is input to second
-elseif strcmpi(type,'serial')
-       
-    % first loop do forward filter
-    for ii = 1:numel(fbk.filters)
-        % initialise
-        if ii == 1
-            y = input.y;
-        end
-        % in each iteration the output of filter k                            
-        % is the input of filter k+1
-        y = filter(fbk.filters(ii).a, fbk.filters(ii).b, y);
-    end
-    
-    % reverse data series
-    yy = y(length(y):-1:1);
-    
-    % second loop do backward filter
-    for ii = 1:numel(fbk.filters)
-        yy = filter(fbk.filters(ii).a, fbk.filters(ii).b, yy);
-    end
-    
-    % reverse data series again
-    y = yy(length(yy):-1:1);
-    
-else
-    error('### filterbank must be either ''serial'' or ''parallel''.');
-end
+  filts = fbk.filters;
+  Nfilt = numel(filts);
+  x     = input.y;
 
+  % Coefficients padded to a common length, and steady states of the
+  % filters for a unit input
+  nz = zeros(1, Nfilt);
+  for ff = 1:Nfilt
+    nz(ff) = max(numel(filts(ff).a), numel(filts(ff).b)) - 1;
+  end
+  M   = max(nz) + 1;
+  num = zeros(Nfilt, M);
+  den = zeros(Nfilt, M);
+  zi  = zeros(M-1, Nfilt);
+  for ff = 1:Nfilt
+    num(ff, 1:numel(filts(ff).a)) = filts(ff).a;
+    den(ff, 1:numel(filts(ff).b)) = filts(ff).b;
+    zi(1:nz(ff), ff) = utils.math.iirinit(filts(ff).a, filts(ff).b);
+  end
 
-varargout{1} = y;
+  % the order of the bank is the sum of the orders of the filters
+  nfact = 3*sum(nz);
+  if numel(x) <= nfact
+    error('### Data must have length more than 3 times the filter order.');
+  end
 
-end
+  if exist('ltpda_iirfiltfilt', 'file') == 3
+    varargout{1} = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact);
+    return
+  end
+
+  % MATLAB version
+  sx = size(x);
+  x  = x(:);
+  xt = [2*x(1)-x(nfact+1:-1:2); x; 2*x(end)-x(end-1:-1:end-nfact)];
+
+  % forward
+  y = utils.math.iirbank(xt, filts, fbk.type, initialStates(zi, filts, serial, xt(1)));
+  % backward
+  y = y(end:-1:1);
+  y = utils.math.iirbank(y, filts, fbk.type, initialStates(zi, filts, serial, y(1)));
+  y = y(end:-1:1);
 
+  varargout{1} = reshape(y(nfact+1:end-nfact), sx);
 
+end
 
+%--------------------------------------------------------------------------
+% The states of the filters for the first sample u of a pass. In a serial
+% bank each filter sees the steady output of the previous ones.
+%--------------------------------------------------------------------------
+function Zi = initialStates(zi, filts, serial, u)
 
+  Zi = zeros(size(zi));
+  for ff = 1:numel(filts)
+    Zi(:, ff) = zi(:, ff)*u;
+    if serial && sum(filts(ff).b) ~= 0
+      u = u*sum(filts(ff).a)/sum(filts(ff).b);
+    elseif serial
+      u = 0;
+    end
+  end
 
+end
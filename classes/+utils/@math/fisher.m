@@ -64,9 +64,6 @@ function [FisMat dstep] = fisher(fin,S,mdl,params,numparams,lp,freqs,dstep,ngrid
     % set parameter values
     meval.doSetParameters(params, numparams);
     
-    % defining # of inputs and outputs
-    Nout = numel([meval.outputs(:).ports]);
-
     % case no diff. step introduced
     if isempty(dstep)
 
@@ -96,35 +93,13 @@ function [FisMat dstep] = fisher(fin,S,mdl,params,numparams,lp,freqs,dstep,ngrid
       outNames{ii} = ports(ii).name;
     end
     
-    % differentiate and eval
-    for i = 1:length(params)
-
-      utils.helper.msg(msg.IMPORTANT, ...
-      sprintf('computing numerical differentiation with respect %s, Step:%4.2d ',params{i},dstep(i)), mfilename('class'), mfilename);
+    utils.helper.msg(msg.IMPORTANT, ...
+    sprintf('computing numerical differentiation with respect to %d parameters', numel(params)), mfilename('class'), mfilename);
     
-      % differentiate numerically
-      dH = meval.parameterDiff(plist('names', params(i),'values',dstep(i)));
-
-      for jj = 1:Nout
-        % create plist with correct outNames (since parameterDiff change them)
-        outputs{jj} = strrep(outNames{jj},'.', sprintf('_DIFF_%s.',params{i})); 
-      end
-      
-      spl = plist(...
-          'outputs',    outputs, ...
-          'inputs',     inNames, ...
-          'reorganize', true,    ...
-          'f',          freqs);
-
-      % do bode
-      dd  = bode(dH, spl);
-
-      % get numbers
-      dd = con(i)*dd.objs.y;
-
-      % rearrange the transfer functions
-      d(:,:,:,i) = reshape(dd,numel(dd(:,1)),Nout,Nin);
-
+    % differentiate numerically, all parameters at once
+    d = meval.responseDerivatives(params, dstep, inNames, outNames, freqs);
+    for i = 1:length(params)
+      d(:,:,:,i) = con(i)*d(:,:,:,i);
     end
 
   else
@@ -133,18 +108,19 @@ function [FisMat dstep] = fisher(fin,S,mdl,params,numparams,lp,freqs,dstep,ngrid
 
   FisMat = zeros(length(params));
    
+  % get the templates, once per parameter
+  h = cell(1,length(params));
+  g = cell(1,length(params));
+  for i = 1:length(params)
+    h{i} = utils.math.mult(d(:,:,:,i), fin);
+    % Multiplying at once produces error.
+    g{i} = utils.math.mult(S, h{i});
+  end
+   
   % compute Fisher Matrix (only upper triangle, it must be symmetric)
   for i =1:length(params)
     for j =i:length(params)
-
-      % Get the template
-      h = utils.math.mult(d(:,:,:,i), fin);
-
-      % Multiplying at once produces error.
-      g = utils.math.mult(S, utils.math.mult(d(:,:,:,j), fin));
-
-      FisMat(i,j) = sum(real(utils.math.ctmult(h , g)));
-
+      FisMat(i,j) = sum(real(utils.math.ctmult(h{i} , g{j})));
     end
   end
 
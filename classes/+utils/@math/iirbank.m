@@ -0,0 +1,112 @@
+% IIRBANK filters data with a bank of IIR filters in a single pass.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     iirbank applies all the filters of a bank to the data. In a
+%     'parallel' bank the outputs of the filters are summed, in a 'serial'
+%     bank each filter filters the output of the previous one. The
+%     coefficients of the filters are padded with zeros to a common length,
+%     which leaves the responses and the states unchanged.
+%
+%     The work is done by the ltpda_iirbank mex file when it is available:
+%     it reads each sample once, runs all the sections on a block of data
+%     while it is in the cache, and shares the channels and the sections of
+%     a parallel bank between threads. Otherwise the filters are applied
+%     one after the other with FILTER.
+%
+% CALL:
+%
+%     [y, Zf, nz] = iirbank(x, filts, bank)
+%     [y, Zf, nz] = iirbank(x, filts, bank, Zi)
+%
+% INPUT:
+%
+%     x      data, a vector or a Nsamples x Nchannels matrix
+%     filts  array of miir filters
+%     bank   'parallel' or 'serial'
+%     Zi     initial states, (M-1) x Nfilters x Nchannels. If not given,
+%            the histout of each filter is used for all the channels.
+%
+% OUTPUT:
+%
+%     y      filtered data, with the size of x
+%     Zf     final states, (M-1) x Nfilters x Nchannels
+%     nz     number of states of each filter: the final states of the
+%            filter ff in the channel cc are Zf(1:nz(ff), ff, cc)
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, Zf, nz] = iirbank(x, filts, bank, Zi)
+
+  switch lower(bank)
+    case 'parallel'
+      serial = 0;
+    case 'serial'
+      serial = 1;
+    otherwise
+      error('### Unknown filter bank option. Choose ''serial'' or ''parallel''.');
+  end
+
+  Nfilt = numel(filts);
+  if isvector(x)
+    Nch = 1;
+  else
+    Nch = size(x, 2);
+  end
+
+  % Coefficients padded to a common length
+  nz = zeros(1, Nfilt);
+  for ff = 1:Nfilt
+    nz(ff) = max(numel(filts(ff).a), numel(filts(ff).b)) - 1;
+  end
+  M   = max(nz) + 1;
+  num = zeros(Nfilt, M);
+  den = zeros(Nfilt, M);
+  for ff = 1:Nfilt
+    num(ff, 1:numel(filts(ff).a)) = filts(ff).a;
+    den(ff, 1:numel(filts(ff).b)) = filts(ff).b;
+  end
+
+  % Initial states
+  if nargin < 4 || isempty(Zi)
+    Zi = zeros(M-1, Nfilt, Nch);
+    for ff = 1:Nfilt
+      h = filts(ff).histout(:);
+      if ~isempty(h)
+        Zi(1:numel(h), ff, :) = repmat(h, [1 1 Nch]);
+      end
+    end
+  end
+
+  if exist('ltpda_iirbank', 'file') == 3
+    [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial);
+    return
+  end
+
+  % MATLAB version
+  Zf = reshape(Zi, M-1, Nfilt, Nch);
+  if isvector(x)
+    xc = x(:);
+  else
+    xc = x;
+  end
+  y = zeros(size(xc));
+  for cc = 1:Nch
+    u = xc(:, cc);
+    for ff = 1:Nfilt
+      [yf, Zf(:, ff, cc)] = filter(num(ff,:), den(ff,:), u, Zf(:, ff, cc));
+      if serial
+        u = yf;
+      else
+        y(:, cc) = y(:, cc) + yf;
+      end
+    end
+    if serial
+      y(:, cc) = u;
+    end
+  end
+  y = reshape(y, size(x));
+
+end
@@ -0,0 +1,126 @@
+% IIRCHUNK filters a long series with an IIR filter in parallel chunks.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     iirchunk gives the result of FILTER, but splits the series into
+%     chunks which do not depend on each other. In state-space form (see
+%     ssm/ssmFromMiir) the filter is z(n+1) = F*z(n) + g*x(n), so the output
+%     of a chunk is its output from zero state plus the free response of
+%     the state at its start. The chunks are filtered from zero state in
+%     parallel, the states at their boundaries are propagated with F^L,
+%     L being the length of a chunk, and the free responses are added to
+%     the chunks in parallel.
+%
+%     The work is done by the ltpda_iirchunk mex file when it is
+%     available, with one chunk per thread by default. Otherwise the chunks
+%     are filtered with FILTER in a PARFOR loop.
+%
+% CALL:
+%
+%     [y, Zf] = iirchunk(x, a, b)
+%     [y, Zf] = iirchunk(x, a, b, Zi)
+%     [y, Zf] = iirchunk(x, a, b, Zi, nchunks)
+%
+% INPUT:
+%
+%     x        data, a vector or a Nsamples x Nchannels matrix
+%     a, b     numerator and denominator coefficients, as for FILTER
+%     Zi       initial states, (M-1) x Nchannels with M the number of
+%              coefficients. Zeros by default.
+%     nchunks  number of chunks, 0 (default) for one per thread
+%
+% OUTPUT:
+%
+%     y        filtered data, with the size of x
+%     Zf       final states, (M-1) x Nchannels
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, Zf] = iirchunk(x, a, b, Zi, nchunks)
+
+  if isvector(x)
+    Nch = 1;
+  else
+    Nch = size(x, 2);
+  end
+  if nargin < 5 || isempty(nchunks)
+    nchunks = 0;
+  end
+
+  % Coefficients padded to a common length
+  M   = max(numel(a), numel(b));
+  num = zeros(1, M);
+  den = zeros(1, M);
+  num(1:numel(a)) = a;
+  den(1:numel(b)) = b;
+
+  if nargin < 4 || isempty(Zi)
+    Zi = zeros(M-1, Nch);
+  end
+  Zi = reshape(Zi, M-1, Nch);
+
+  if exist('ltpda_iirchunk', 'file') == 3
+    [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks);
+    return
+  end
+
+  % MATLAB version
+  if isvector(x)
+    xc = x(:);
+  else
+    xc = x;
+  end
+  N  = size(xc, 1);
+  Ns = M - 1;
+  if N == 0 || Ns == 0
+    [y, Zf] = filter(num, den, x, Zi);
+    return
+  end
+  if nchunks <= 0
+    nchunks = maxNumCompThreads;
+  end
+  L = ceil(N/min(nchunks, N));
+  P = ceil(N/L);
+
+  % Companion matrix of the transposed direct form and its power over
+  % one chunk
+  F  = [-den(2:end).'/den(1) eye(Ns, Ns-1)];
+  FL = F^L;
+
+  y  = zeros(size(xc));
+  Zf = Zi;
+  for cc = 1:Nch
+    % the chunks from zero state, the first one from Zi
+    yc = cell(1, P);
+    E  = zeros(Ns, P);
+    parfor pp = 1:P
+      idx = (pp-1)*L+1:min(pp*L, N);
+      if pp == 1
+        z0 = Zi(:, cc);
+      else
+        z0 = zeros(Ns, 1);
+      end
+      [yc{pp}, E(:, pp)] = filter(num, den, xc(idx, cc), z0);
+    end
+    % the states at the start of the chunks
+    S = zeros(Ns, P);
+    if P > 1
+      S(:, 2) = E(:, 1);
+    end
+    for pp = 2:P-1
+      S(:, pp+1) = E(:, pp) + FL*S(:, pp);
+    end
+    % the free responses of these states
+    parfor pp = 2:P
+      [yfree, zfree] = filter(0, den, zeros(numel(yc{pp}), 1), S(:, pp));
+      yc{pp} = yc{pp} + yfree;
+      E(:, pp) = E(:, pp) + zfree;
+    end
+    y(:, cc)  = vertcat(yc{:});
+    Zf(:, cc) = E(:, P);
+  end
+  y = reshape(y, size(x));
+
+end
@@ -17,6 +17,13 @@
 %
 function [L snr Lf] = loglikelihood(in, out, S, TF)
   
+  % The compiled kernel does all the sums below in a single pass
+  if exist('ltpda_loglikelihood', 'file') == 3 && ...
+      isa(in, 'double') && isa(out, 'double') && isa(S, 'double') && isa(TF, 'double')
+    [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF);
+    return
+  end
+  
   % Get the template
   h = utils.math.mult(TF, in);
   
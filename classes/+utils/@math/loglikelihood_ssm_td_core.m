@@ -0,0 +1,143 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Compute log-likelihood and chi-square in time domain for SSM objects,
+% on preloaded numerical data
+%
+% This is the lean counterpart of loglikelihood_ssm_td and
+% chisquare_ssm_td for use inside fitting loops. The model is propagated
+% directly by the ltpda_ssmsim mex file, which compares the outputs with
+% the data and only accumulates the cross-products of the residuals
+% R = sum(r*r.'), so no AO and no output series are built. The symbolic
+% matrices are translated once into a parameter evaluator and kept with
+% the model between calls.
+%
+% The noise is taken as white, with covariance S between the channels:
+%
+%   loglk = trace(S\R)/N
+%   chi2  = trace(R)/(N*Nout - numel(xp))
+%
+% with N the number of samples used.
+%
+% INPUT
+%
+% - xp, a vector with parameters values
+% - model, an ssm model
+% - in, a Nin x Nsamples matrix with the input signals
+% - out, a Nout x Nsamples matrix with the output data
+% - S, the Nout x Nout covariance matrix of the noise
+% - fs, the sampling frequency of the data
+% - parnames, a cell array with parameters names
+% - inNames, A cell-array of input port names corresponding to the rows
+% of in
+% - outNames, A cell-array of output port names corresponding to the rows
+% of out
+% - cutbefore, followed by the data samples to cut at the starting of the
+% data series
+% - cutafter, followed by the data samples to cut at the ending of the
+% data series
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+function [loglk, chi2] = loglikelihood_ssm_td_core(xp,model,in,out,S,fs,parnames,inNames,outNames,varargin)
+
+  persistent processedModel
+  persistent sourceModel
+  persistent evaluator
+  persistent mexBroken
+
+  cutbefore = [];
+  cutafter = [];
+  if ~isempty(varargin)
+    for j=1:length(varargin)
+      if strcmp(varargin{j},'cutbefore')
+        cutbefore = varargin{j+1};
+      end
+      if strcmp(varargin{j},'cutafter')
+        cutafter = varargin{j+1};
+      end
+    end
+  end
+
+  xp = double(xp);
+  Nsamples = size(out,2);
+  Nout = size(out,1);
+
+  if size(in,2) ~= Nsamples
+    error('### The input and output data must have the same number of samples');
+  end
+
+  % samples used, as in chisquare_ssm_td
+  first = 1;
+  last = Nsamples;
+  if ~isempty(cutbefore)
+    first = cutbefore + 1;
+  end
+  if ~isempty(cutafter)
+    last = Nsamples - cutafter - 1;
+  end
+  if first > last
+    error('### No samples left after cutting the data');
+  end
+
+  if isempty(processedModel) || ~strcmp(sourceModel, model.UUID) || ...
+      isempty(evaluator) || ~isequal(evaluator.params, parnames)
+    processedModel = copy(model, 1);
+    sourceModel = model.UUID;
+    % Translate the symbolic matrices once
+    evaluator = processedModel.buildParameterEvaluator(parnames);
+  end
+
+  % set parameters in the model
+  evalm = copy(processedModel, 1);
+  evaluator = evalm.applyParameterEvaluator(evaluator, xp);
+  if evalm.timestep ~= 1/fs
+    evalm.modifyTimeStep(plist('newtimestep',1/fs));
+  end
+  evalm.reshuffle(inNames, {}, {}, 'ALL', outNames, 'NONE');
+
+  A        = full(evalm.amats{1,1});
+  Baos     = full(evalm.bmats{1,1});
+  Coutputs = full(evalm.cmats{2,1});
+  Daos     = full(evalm.dmats{2,1});
+  SSini    = zeros(size(A,1),1);
+  Cstates  = zeros(0,size(A,1));
+
+  % residual cross-products
+  if isempty(mexBroken)
+    mexBroken = exist('ltpda_ssmsim', 'file') ~= 3;
+  end
+  if ~mexBroken
+    try
+      % call to the mex file
+      R = ltpda_ssmsim(SSini, A.', Coutputs.', Cstates.', Baos.', Daos.', in, out, first, last);
+    catch
+      % backup if the mex-file is broken or has no residual mode, only
+      % warn once as we are called inside fitting loops
+      warning('Failed to run mex file ltpda_ssmsim');
+      mexBroken = true;
+    end
+  end
+  if mexBroken
+    R = residualProducts(SSini, A, Baos, Coutputs, Daos, in, out, first, last);
+  end
+
+  N = last - first + 1;
+  loglk = trace(S\R)/N;
+  chi2 = trace(R)/(N*Nout - numel(xp));
+
+end
+
+%--------------------------------------------------------------------------
+% MATLAB version of the residual mode of ltpda_ssmsim
+%--------------------------------------------------------------------------
+function R = residualProducts(x, A, B, C, D, in, out, first, last)
+
+  R = zeros(size(C,1));
+  for k = 1:last
+    if k >= first
+      r = out(:,k) - C*x - D*in(:,k);
+      R = R + r*r.';
+    end
+    x = A*x + B*in(:,k);
+  end
+
+end
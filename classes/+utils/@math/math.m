@@ -92,6 +92,7 @@ classdef math
     [loglk, snr] = loglikelihood_matrix(varargin)
     snrexp = stnr(in, out, S, TF)
     loglk = loglikelihood_ssm_td(xp,in,out,parnames,model,inNames,outNames,Noise,varargin)
+    [loglk, chi2] = loglikelihood_ssm_td_core(xp,model,in,out,S,fs,parnames,inNames,outNames,varargin)
     loglk = loglikelihood_td(res,noise,varargin)
     params = fitPrior(prior,nparam,chain,bins)
     Xt = blwhitenoise(npts,fs,fl,fh)
@@ -103,6 +104,17 @@ classdef math
     dc = getdc(z,p,k)
     [A,B,C,D] = pzmodel2SSMats(pzm)
     varargout = filtfilt_filterbank(fbk,in)
+    [y, Zf, nz] = iirbank(x, filts, bank, Zi)
+    [y, Zf] = iirchunk(x, a, b, Zi, nchunks)
+    [y, Zf] = mchiir(x, a, b, Zi)
+    kernel = olskernel(H, tol)
+    [y, zf] = olsfilt(x, kernel, zi)
+    r = philoxrandn(seed, sample, stream, n)
+    kernel = resamplekernel(P, Q, h)
+    [y, zf] = polyresample(x, kernel, zi)
+    [y, Zf] = sosfilt(x, sos, Zi)
+    y = sosfiltfilt(x, sos)
+    zi = sosinit(sos)
     cmat = xCovmat(x,y,varargin)
     chi2 = chisquare_ssm_td(xp,in,out,parnames,model,inNames,outNames,varargin)
     [CorrC,SigC] = cov2corr(Covar)
@@ -157,6 +169,8 @@ classdef math
     x = roundn(x, n)
     varargout = fftdelay_core(x,tau,fs)
     varargout = fdfilt_delay_core(y,D,N,w)
+    kernel = fdkernel(N, w)
+    [y, zf] = fdelay(x, D, kernel, zi)
     [res,poles,dterm,psdmod] = psdvectorfit(y,f,params)
     p = gammapdf(x,A,B)
     p = gammacdf(x,A,B)
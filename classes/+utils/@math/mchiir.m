@@ -0,0 +1,89 @@
+% MCHIIR filters many channels, each with its own IIR filter, in a single pass.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     mchiir gives the result of FILTER applied to each channel with its
+%     own coefficients. The coefficients are padded with zeros to a common
+%     length, so that the filters of all the channels run in the same
+%     recursion.
+%
+%     The work is done by the ltpda_mchiir mex file when it is available:
+%     it interleaves the channels so that each step of the recursion is
+%     done for many channels at once. Otherwise a filter shared by all the
+%     channels is a single call to FILTER, and different filters are
+%     applied channel by channel.
+%
+% CALL:
+%
+%     [y, Zf] = mchiir(x, a, b)
+%     [y, Zf] = mchiir(x, a, b, Zi)
+%
+% INPUT:
+%
+%     x     data, a Nsamples x Nchannels matrix
+%     a, b  numerator and denominator coefficients: cell arrays with the
+%           coefficients of each channel, or single vectors shared by all
+%           the channels
+%     Zi    initial states, (M-1) x Nchannels with M the number of
+%           coefficients of the longest filter. Zeros by default.
+%
+% OUTPUT:
+%
+%     y     filtered data, with the size of x
+%     Zf    final states, (M-1) x Nchannels
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, Zf] = mchiir(x, a, b, Zi)
+
+  if ~iscell(a)
+    a = {a};
+  end
+  if ~iscell(b)
+    b = {b};
+  end
+  Nf = numel(a);
+  if numel(b) ~= Nf
+    error('### There must be as many numerators as denominators.');
+  end
+  Nch = size(x, 2);
+  if Nf ~= 1 && Nf ~= Nch
+    error('### There must be one filter per channel, or a single filter.');
+  end
+
+  % Coefficients padded to a common length, one row per filter
+  M = 1;
+  for ff = 1:Nf
+    M = max([M numel(a{ff}) numel(b{ff})]);
+  end
+  num = zeros(Nf, M);
+  den = zeros(Nf, M);
+  for ff = 1:Nf
+    num(ff, 1:numel(a{ff})) = a{ff};
+    den(ff, 1:numel(b{ff})) = b{ff};
+  end
+
+  if nargin < 4 || isempty(Zi)
+    Zi = zeros(M-1, Nch);
+  end
+  Zi = reshape(Zi, M-1, Nch);
+
+  if exist('ltpda_mchiir', 'file') == 3
+    [y, Zf] = ltpda_mchiir(x, num, den, Zi);
+    return
+  end
+
+  % MATLAB version
+  if Nf == 1
+    [y, Zf] = filter(num, den, x, Zi);
+    return
+  end
+  y  = zeros(size(x));
+  Zf = zeros(size(Zi));
+  for cc = 1:Nch
+    [y(:, cc), Zf(:, cc)] = filter(num(cc, :), den(cc, :), x(:, cc), Zi(:, cc));
+  end
+
+end
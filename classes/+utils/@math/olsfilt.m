@@ -0,0 +1,77 @@
+% OLSFILT filters data by overlap-save with the kernel of olskernel.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     olsfilt convolves the data with the impulse response of the kernel,
+%     from its acausal tap -Ka to its causal tap Kc-1, by FFTs of
+%     kernel.Nfft samples. Each block gives kernel.hop output samples, and
+%     consecutive blocks overlap by the Kc-1+Ka samples of the history of
+%     the filter. The blocks of a group are transformed together, as the
+%     columns of a matrix, and the memory used does not depend on the
+%     length of the data.
+%
+%     The filter can be applied to data streamed in consecutive chunks by
+%     passing the final state of a call as the initial state of the next
+%     one. The output of a call is delayed by the Ka acausal taps: the
+%     output sample y(j) is the filtered data at the time of x(j-Ka). The
+%     last Ka samples are flushed by a final call with zeros(Ka, 1).
+%
+% CALL:
+%
+%     [y, zf] = olsfilt(x, kernel)
+%     [y, zf] = olsfilt(x, kernel, zi)
+%
+% INPUT:
+%
+%     x       data vector
+%     kernel  the kernel from olskernel
+%     zi      initial state, the Kc-1+Ka samples before x. Zeros by
+%             default.
+%
+% OUTPUT:
+%
+%     y       filtered data, with the size of x
+%     zf      final state, the last Kc-1+Ka samples
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, zf] = olsfilt(x, kernel, zi)
+
+  % number of samples of the blocks of a group
+  groupSamples = 2^22;
+
+  Nfft = kernel.Nfft;
+  hop  = kernel.hop;
+  Lh   = kernel.Kc - 1 + kernel.Ka;
+
+  if nargin < 3 || isempty(zi)
+    zi = zeros(Lh, 1);
+  end
+  if numel(zi) ~= Lh
+    error('### The initial state must have %d samples.', Lh);
+  end
+
+  sx = size(x);
+  L  = numel(x);
+  xp = [zi(:); x(:)];
+  zf = xp(end-Lh+1:end);
+
+  % pad the last block
+  Nb = ceil(L/hop);
+  xp(end+1:(Nb-1)*hop+Nfft) = 0;
+
+  y    = zeros(Nb*hop, 1);
+  G    = max(1, floor(groupSamples/Nfft));
+  rows = (kernel.Kc:kernel.Kc+hop-1).';
+  for b0 = 0:G:Nb-1
+    nb  = min(G, Nb-b0);
+    idx = bsxfun(@plus, (1:Nfft).', (b0:b0+nb-1)*hop);
+    Y   = ifft(bsxfun(@times, fft(xp(idx)), kernel.H), 'symmetric');
+    y(b0*hop+1:(b0+nb)*hop) = reshape(Y(rows, :), [], 1);
+  end
+
+  y = reshape(y(1:L), sx);
+
+end
@@ -0,0 +1,78 @@
+% OLSKERNEL builds the kernel of the overlap-save block filter from a frequency response.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     olskernel takes the response of a filter on the one-sided frequency
+%     grid of a block of Nfft samples, (0:Nfft/2)*fs/Nfft, and returns the
+%     kernel used by olsfilt. The impulse response on the block is cut to
+%     its Kc causal taps 0..Kc-1 and its Ka acausal taps -Ka..-1, keeping
+%     all but a fraction tol of its energy. Kc+Ka is at most Nfft/2, so
+%     each block gives at least Nfft/2 output samples; a warning is issued
+%     if the impulse response has to be cut further.
+%
+% CALL:
+%
+%     kernel = olskernel(H)
+%     kernel = olskernel(H, tol)
+%
+% INPUT:
+%
+%     H      response on the one-sided grid, Nfft/2+1 values
+%     tol    fraction of the energy of the impulse response which may be
+%            dropped. Default eps.
+%
+% OUTPUT:
+%
+%     kernel structure with the fields
+%              H    - the two-sided response of the cut impulse response
+%              Nfft - the block size
+%              Kc   - the number of causal taps
+%              Ka   - the number of acausal taps
+%              hop  - the number of output samples of a block
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function kernel = olskernel(H, tol)
+
+  if nargin < 2 || isempty(tol)
+    tol = eps;
+  end
+
+  H    = H(:);
+  Nfft = 2*(numel(H) - 1);
+  if Nfft < 2
+    error('### The response must be given on at least two frequencies.');
+  end
+  half = Nfft/2;
+
+  h = ifft([H; conj(H(end-1:-1:2))], 'symmetric');
+
+  % energy dropped when keeping Kc = 1..half causal taps, and Ka = 0..half
+  % acausal taps
+  E      = sum(h.^2);
+  hc     = h(1:half);
+  ha     = h(end:-1:half+1);
+  dropc  = [flipud(cumsum(flipud(hc(2:end).^2))); 0];
+  dropa  = [flipud(cumsum(flipud(ha.^2))); 0];
+  Kc     = find(dropc <= tol*E/2, 1);
+  Ka     = find(dropa <= tol*E/2, 1) - 1;
+
+  if Kc + Ka > half
+    warning('!!! The impulse response of the filter is longer than half the block size. It is cut to %d samples.', half);
+    Kc = max(1, round(half*Kc/(Kc + Ka)));
+    Ka = half - Kc;
+  end
+
+  hk = zeros(Nfft, 1);
+  hk(1:Kc) = h(1:Kc);
+  hk(end-Ka+1:end) = h(end-Ka+1:end);
+
+  kernel.H    = fft(hk);
+  kernel.Nfft = Nfft;
+  kernel.Kc   = Kc;
+  kernel.Ka   = Ka;
+  kernel.hop  = Nfft - Kc + 1 - Ka;
+
+end
@@ -0,0 +1,105 @@
+% PHILOXRANDN draws the normal deviates of the counter-based generator of the mex files.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     philoxrandn is the MATLAB version of philox_randn in
+%     src/c_sources/philox.c, used by the mex files ltpda_ngprop,
+%     ltpda_mchnoise and ltpda_ssmsim. The deviates are a pure function
+%     of the seed, the sample index, the stream and their position: the
+%     Philox4x32-10 bijection of the counter [sample, i/2, stream] with
+%     the seed as key gives two uniform numbers, turned into the deviates
+%     i and i+1 by the Box-Muller transform. The MATLAB versions of the
+%     mex files draw the same noise, up to the rounding of log, cos and
+%     sin.
+%
+%     The counters of all the columns are transformed together.
+%
+% CALL:
+%
+%     r = philoxrandn(seed, sample, stream, n)
+%
+% INPUT:
+%
+%     seed    the seed, an integer in [0, 2^53)
+%     sample  vector of sample indices, integers in [0, 2^53)
+%     stream  the stream of each sample, integers in [0, 2^32), or a
+%             single stream for all the samples
+%     n       the number of deviates of each sample
+%
+% OUTPUT:
+%
+%     r       n x numel(sample) deviates: the column j is
+%             philox_randn(seed, sample(j), stream(j), n)
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function r = philoxrandn(seed, sample, stream, n)
+
+  sample = reshape(double(sample), 1, []);
+  stream = reshape(double(stream), 1, []);
+  if isscalar(stream)
+    stream = repmat(stream, size(sample));
+  end
+  if numel(stream) ~= numel(sample)
+    error('### Please give one stream per sample, or a single stream.');
+  end
+
+  % the 32 bit words of the key and of the counters
+  k0 = uint64(mod(seed, 2^32));
+  k1 = uint64(floor(seed/2^32));
+  c0 = uint64(mod(sample, 2^32));
+  c1 = uint64(floor(sample/2^32));
+  c3 = uint64(stream);
+
+  r = zeros(n, numel(sample));
+  for ii = 0:2:n-1
+    c2 = repmat(uint64(ii/2), size(c0));
+    [w0, w1, w2, w3] = philox(c0, c1, c2, c3, k0, k1);
+    u1  = uniform(w0, w1);
+    u2  = uniform(w2, w3);
+    rho = sqrt(-2*log(u1));
+    r(ii+1, :) = rho.*cos(2*pi*u2);
+    if ii+1 < n
+      r(ii+2, :) = rho.*sin(2*pi*u2);
+    end
+  end
+
+end
+
+%--------------------------------------------------------------------------
+% The Philox4x32 bijection with 10 rounds, on 32 bit words held in uint64
+% so that the products are exact
+%--------------------------------------------------------------------------
+function [c0, c1, c2, c3] = philox(c0, c1, c2, c3, k0, k1)
+
+  M0   = uint64(3528531795); % 0xD2511F53
+  M1   = uint64(3449720151); % 0xCD9E8D57
+  W0   = uint64(2654435769); % 0x9E3779B9
+  W1   = uint64(3144134277); % 0xBB67AE85
+  mask = uint64(4294967295);
+
+  for rr = 1:10
+    if rr > 1
+      k0 = bitand(k0 + W0, mask);
+      k1 = bitand(k1 + W1, mask);
+    end
+    p0 = M0.*c0;
+    p1 = M1.*c2;
+    c0 = bitxor(bitxor(bitshift(p1, -32), c1), k0);
+    c2 = bitxor(bitxor(bitshift(p0, -32), c3), k1);
+    c1 = bitand(p1, mask);
+    c3 = bitand(p0, mask);
+  end
+
+end
+
+%--------------------------------------------------------------------------
+% Uniform double in the open interval (0,1) from two 32 bit words
+%--------------------------------------------------------------------------
+function u = uniform(a, b)
+
+  u = (double(bitshift(a, -5))*2^26 + double(bitshift(b, -6)) + 0.5)/2^53;
+
+end
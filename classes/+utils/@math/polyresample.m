@@ -0,0 +1,108 @@
+% POLYRESAMPLE resamples data by P/Q with the polyphase filter of resamplekernel.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     polyresample gives the result of MATLAB's resample(x, P, Q, b) with
+%     the kernel from resamplekernel, but it only computes the output
+%     samples which are kept, and never multiplies the zeros of the
+%     upsampled data: each output sample is one of the P phases of the
+%     filter applied to the input samples.
+%
+%     The work is done by the ltpda_polyresample mex file when it is
+%     available: the blocks of output samples of all the channels are
+%     shared between threads.
+%
+%     Data streamed in consecutive chunks are resampled by passing [] as
+%     the initial state of the first call, and the final state of a call
+%     as the initial state of the next one. Each call then gives the
+%     output samples of all the input samples received so far, delayed by
+%     kernel.delay samples: the output sample y(j) of the stream is the
+%     sample j-kernel.delay of resample. The last output samples are
+%     flushed by a final call with zeros.
+%
+% CALL:
+%
+%     y        = polyresample(x, kernel)
+%     [y, zf]  = polyresample(x, kernel, zi)
+%
+% INPUT:
+%
+%     x       data, a vector or a Nsamples x Nchannels matrix
+%     kernel  the kernel from resamplekernel
+%     zi      initial state of a stream, [] for the first chunk
+%
+% OUTPUT:
+%
+%     y       resampled data: ceil(Nsamples*P/Q) samples without a state
+%     zf      final state of the stream
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, zf] = polyresample(x, kernel, zi)
+
+  P = kernel.P;
+  Q = kernel.Q;
+
+  isrow = size(x, 1) == 1;
+  if isrow
+    x = x(:);
+  end
+  Nch = size(x, 2);
+
+  if nargin < 3
+    % the samples of resample
+    n0 = 0;
+    m0 = kernel.delay;
+    Ny = ceil(size(x, 1)*P/Q);
+  else
+    if isempty(zi)
+      zi = struct('x', zeros(0, Nch), 'n', 0, 'm', 0);
+    end
+    if size(zi.x, 2) ~= Nch
+      error('### The initial state must have %d channels.', Nch);
+    end
+    x  = [zi.x; x];
+    n0 = zi.n;
+    m0 = zi.m;
+    % the output samples of the input samples received so far
+    Ny = ceil((n0 + size(x, 1))*P/Q) - m0;
+    % and the input samples of the next ones
+    nk = max(n0, floor((m0 + Ny)*Q/P) - kernel.Lp + 1);
+    zf = struct('x', x(nk-n0+1:end, :), 'n', nk, 'm', m0 + Ny);
+  end
+
+  if exist('ltpda_polyresample', 'file') == 3
+    y = ltpda_polyresample(x, kernel.h, P, Q, n0, m0, Ny);
+  else
+    y = polyphase(x, kernel, n0, m0, Ny);
+  end
+
+  if isrow
+    y = y.';
+  end
+
+end
+
+% MATLAB version: the taps of all the output samples, one after the other
+function y = polyphase(x, kernel, n0, m0, Ny)
+
+  P  = kernel.P;
+  Lp = kernel.Lp;
+  H  = zeros(P, Lp);
+  H(1:numel(kernel.h)) = kernel.h;
+
+  Nx = size(x, 1);
+  t  = (m0:m0+Ny-1).'*kernel.Q;
+  r  = mod(t, P);
+  j  = (t - r)/P - n0;
+
+  y = zeros(Ny, size(x, 2));
+  for ii = 0:Lp-1
+    idx = j - ii;
+    ok  = idx >= 0 & idx < Nx;
+    y(ok, :) = y(ok, :) + bsxfun(@times, H(r(ok)+1, ii+1), x(idx(ok)+1, :));
+  end
+
+end
@@ -0,0 +1,99 @@
+% RESAMPLEKERNEL builds the kernel of the polyphase resampler by P/Q.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     resamplekernel returns the kernel used by polyresample to resample
+%     data by the rational factor P/Q with the FIR filter h. Without a
+%     filter, the anti-aliasing filter of MATLAB's resample is designed: a
+%     least-squares low-pass filter of 20*max(P,Q)+1 taps, with a Kaiser
+%     window. These designs only depend on P/Q, and the last ones are kept
+%     for the MATLAB session, so that data resampled by the same factor
+%     again and again, or channel by channel, only design the filter once.
+%
+%     The filter is padded with zeros in front, as in resample, so that
+%     the output samples fall on its center tap.
+%
+% CALL:
+%
+%     kernel = resamplekernel(P, Q)
+%     kernel = resamplekernel(P, Q, h)
+%
+% INPUT:
+%
+%     P, Q   the resampling factor P/Q
+%     h      the FIR filter, at the rate P times the input rate. The
+%            default design when empty.
+%
+% OUTPUT:
+%
+%     kernel structure with the fields
+%              P, Q  - the resampling factor, reduced as in resample
+%              b     - the filter, as returned by resample
+%              h     - the filter padded with zeros
+%              Lp    - the number of taps of a phase of h
+%              delay - the number of output samples of the delay of h
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function kernel = resamplekernel(P, Q, h)
+
+  persistent cache
+
+  % Number of designs kept in memory
+  Nmax = 20;
+
+  [P, Q] = rat(P/Q, 1e-12);
+
+  if nargin < 3 || isempty(h)
+    key = sprintf('%d/%d', P, Q);
+    if isempty(cache)
+      cache = containers.Map();
+    end
+    if isKey(cache, key)
+      kernel = cache(key);
+      return
+    end
+
+    if P == 1 && Q == 1
+      % no resampling: resample returns the data
+      h = 1;
+    else
+      N     = 10;
+      bta   = 5;
+      pqmax = max(P, Q);
+      fc    = 1/2/pqmax;
+      L     = 2*N*pqmax + 1;
+      h     = firls(L-1, [0 2*fc 2*fc 1], [1 1 0 0]).*kaiser(L, bta).';
+      h     = P*h/sum(h);
+    end
+    kernel = buildKernel(P, Q, h);
+
+    if cache.Count >= Nmax
+      cache = containers.Map();
+    end
+    cache(key) = kernel;
+  else
+    kernel = buildKernel(P, Q, h);
+  end
+
+end
+
+function kernel = buildKernel(P, Q, h)
+
+  h     = reshape(h, 1, []);
+  Lhalf = (numel(h)-1)/2;
+
+  % delay the output so that downsampling by Q hits the center tap
+  nz    = floor(Q - mod(Lhalf, Q));
+  Lhalf = Lhalf + nz;
+
+  kernel.P     = P;
+  kernel.Q     = Q;
+  kernel.b     = h;
+  kernel.h     = [zeros(1, nz) h];
+  kernel.Lp    = ceil(numel(kernel.h)/P);
+  kernel.delay = floor(ceil(Lhalf)/Q);
+
+end
@@ -0,0 +1,67 @@
+% SOSFILT filters data with a cascade of second-order sections.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     sosfilt filters the data through each biquad section in turn, in
+%     direct form II transposed. A high-order filter applied this way
+%     keeps the accuracy of its poles and zeros, which the expanded
+%     polynomials lose.
+%
+%     The work is done by the ltpda_sosfilt mex file when it is available:
+%     it vectorises the recursion over the channels, or over the
+%     sections for a single series.
+%     Otherwise FILTER is applied section by section.
+%
+% CALL:
+%
+%     [y, Zf] = sosfilt(x, sos)
+%     [y, Zf] = sosfilt(x, sos, Zi)
+%
+% INPUT:
+%
+%     x    data, a vector or a Nsamples x Nchannels matrix
+%     sos  Nsections x 6 sections, one [a0 a1 a2 b0 b1 b2] per row with a
+%          the numerator and b the denominator (see miir)
+%     Zi   initial states, 2 x Nsections x Nchannels (default zero)
+%
+% OUTPUT:
+%
+%     y    filtered data, with the size of x
+%     Zf   final states, 2 x Nsections x Nchannels
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [y, Zf] = sosfilt(x, sos, Zi)
+
+  Nsec = size(sos, 1);
+  if isvector(x)
+    Nch = 1;
+  else
+    Nch = size(x, 2);
+  end
+  if nargin < 3 || isempty(Zi)
+    Zi = zeros(2, Nsec, Nch);
+  end
+
+  if exist('ltpda_sosfilt', 'file') == 3
+    [y, Zf] = ltpda_sosfilt(x, sos, Zi);
+    return
+  end
+
+  % MATLAB version
+  Zf = reshape(Zi, 2, Nsec, Nch);
+  if isvector(x)
+    y = x(:);
+  else
+    y = x;
+  end
+  for cc = 1:Nch
+    for kk = 1:Nsec
+      [y(:, cc), Zf(:, kk, cc)] = filter(sos(kk, 1:3), sos(kk, 4:6), y(:, cc), Zf(:, kk, cc));
+    end
+  end
+  y = reshape(y, size(x));
+
+end
@@ -0,0 +1,68 @@
+% SOSFILTFILT zero-phase filtering with a cascade of second-order sections.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     sosfiltfilt filters the data forward and backward through the
+%     sections, as FILTFILT does with the coefficient vectors: the data are
+%     extended at both ends by a reflection of 3*order samples and the
+%     states of each pass start at their steady-state for the first sample
+%     (see sosinit).
+%
+% CALL:
+%
+%     y = sosfiltfilt(x, sos)
+%
+% INPUT:
+%
+%     x    data, a vector or a Nsamples x Nchannels matrix
+%     sos  Nsections x 6 sections, one [a0 a1 a2 b0 b1 b2] per row
+%
+% OUTPUT:
+%
+%     y    filtered data, with the size of x
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function y = sosfiltfilt(x, sos)
+
+  sx = size(x);
+  if isvector(x)
+    x = x(:);
+  end
+  [N, Nch] = size(x);
+
+  % order of the filter, without the padding of first-order sections
+  order = nnz(any(sos(:, [2 5]), 2)) + nnz(any(sos(:, [3 6]), 2));
+  nfact = 3*order;
+  if N <= nfact
+    error('### Data must have length more than 3 times the filter order.');
+  end
+
+  % reflect the data at both ends
+  xt = [bsxfun(@minus, 2*x(1,:), x(nfact+1:-1:2,:)); ...
+        x; ...
+        bsxfun(@minus, 2*x(end,:), x(end-1:-1:end-nfact,:))];
+
+  zi = utils.math.sosinit(sos);
+
+  % forward
+  y = utils.math.sosfilt(xt, sos, initialStates(zi, xt(1,:)));
+  % backward
+  y = y(end:-1:1,:);
+  y = utils.math.sosfilt(y, sos, initialStates(zi, y(1,:)));
+  y = y(end:-1:1,:);
+
+  y = reshape(y(nfact+1:end-nfact,:), sx);
+
+end
+
+%--------------------------------------------------------------------------
+% The states of all the channels for their first samples x1
+%--------------------------------------------------------------------------
+function Z = initialStates(zi, x1)
+
+  Z = bsxfun(@times, zi, reshape(x1, 1, 1, []));
+
+end
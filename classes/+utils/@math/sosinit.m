@@ -0,0 +1,40 @@
+% SOSINIT defines the initial states of a cascade of second-order sections.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION
+%
+%     sosinit is the counterpart of iirinit for filters in second-order
+%     sections: it gives the steady-state of each section when the input
+%     of the cascade is a unit step. Each section sees the DC level at the
+%     output of the previous ones.
+%
+% CALL:
+%
+%     zi = sosinit(sos)
+%
+% INPUT:
+%
+%     sos  Nsections x 6 sections, one [a0 a1 a2 b0 b1 b2] per row
+%
+% OUTPUT:
+%
+%     zi   2 x Nsections initial states. As for iirinit, they have to be
+%          multiplied by the first value of the time series, e.g.
+%          [Y,Zf] = utils.math.sosfilt(X,sos,zi*X(1))
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function zi = sosinit(sos)
+
+  Nsec = size(sos, 1);
+  zi   = zeros(2, Nsec);
+  lvl  = 1;
+  for kk = 1:Nsec
+    a = sos(kk, 1:3)/sos(kk, 4);
+    b = sos(kk, 4:6)/sos(kk, 4);
+    zi(:, kk) = lvl*utils.math.iirinit(a, b);
+    lvl = lvl*sum(a)/sum(b);
+  end
+
+end
@@ -1,6 +1,7 @@
 %%%%%%%%%%%%%%%%%%%%   path: classes\@MCMC   %%%%%%%%%%%%%%%%%%%%
 %
 %   <a href="matlab:help classes\@MCMC\MCMC">classes\@MCMC\MCMC</a>                 -  - Markov Chain Monte Carlo algorithm
+%   <a href="matlab:help classes\@MCMC\adaptCovariance">classes\@MCMC\adaptCovariance</a>      - ADAPTCOVARIANCE: Update the running statistics of the adaptive proposal
 %   <a href="matlab:help classes\@MCMC\ao2strucArrays">classes\@MCMC\ao2strucArrays</a>       - AO2NUMMATRICES.m
 %   <a href="matlab:help classes\@MCMC\attachToDom">classes\@MCMC\attachToDom</a>          - % Create empty ao node with the attribute 'shape'
 %   <a href="matlab:help classes\@MCMC\buildLogLikelihood">classes\@MCMC\buildLogLikelihood</a>   - (No help available)
@@ -15,8 +16,10 @@
 %   <a href="matlab:help classes\@MCMC\copy">classes\@MCMC\copy</a>                 -  makes a (deep) copy of the input MCMCs.
 %   <a href="matlab:help classes\@MCMC\decision">classes\@MCMC\decision</a>             - DECISION: Compute the MH acceptance ratio
 %   <a href="matlab:help classes\@MCMC\defineLogLikelihood">classes\@MCMC\defineLogLikelihood</a>  - (No help available)
+%   <a href="matlab:help classes\@MCMC\defineLogLikelihoodGradient">classes\@MCMC\defineLogLikelihoodGradient</a> - (No help available)
 %   <a href="matlab:help classes\@MCMC\drawAdaptiveSample">classes\@MCMC\drawAdaptiveSample</a>   - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   <a href="matlab:help classes\@MCMC\drawSample">classes\@MCMC\drawSample</a>           - %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%   <a href="matlab:help classes\@MCMC\evaluateProposals">classes\@MCMC\evaluateProposals</a>    - EVALUATEPROPOSALS: Evaluate the bounds, prior and log-likelihood of a block of proposals
 %   <a href="matlab:help classes\@MCMC\fromDom">classes\@MCMC\fromDom</a>              - % Get shape
 %   <a href="matlab:help classes\@MCMC\fromStruct">classes\@MCMC\fromStruct</a>           -  creates from a structure a TIMESPAN object.
 %   <a href="matlab:help classes\@MCMC\getLikelihood">classes\@MCMC\getLikelihood</a>        -  Get the likelihood function in a mfh object.
@@ -33,9 +36,11 @@
 %   <a href="matlab:help classes\@MCMC\performDataChecks">classes\@MCMC\performDataChecks</a>    - (No help available)
 %   <a href="matlab:help classes\@MCMC\plotLogLikelihood">classes\@MCMC\plotLogLikelihood</a>    - (No help available)
 %   <a href="matlab:help classes\@MCMC\preprocess">classes\@MCMC\preprocess</a>           - MCMC.preprocess.
+%   <a href="matlab:help classes\@MCMC\preprocessCache">classes\@MCMC\preprocessCache</a>      - PREPROCESSCACHE: Store and retrieve the preprocessed data of MCMC runs
 %   <a href="matlab:help classes\@MCMC\preprocessMFH">classes\@MCMC\preprocessMFH</a>        - (No help available)
 %   <a href="matlab:help classes\@MCMC\preprocessModel">classes\@MCMC\preprocessModel</a>      - --------------------------------------------------------------------------
 %   <a href="matlab:help classes\@MCMC\processChain">classes\@MCMC\processChain</a>         - PROCESSCHAIN: Get the statisticts of the MCMC Chain
+%   <a href="matlab:help classes\@MCMC\readChain">classes\@MCMC\readChain</a>            - READCHAIN: Read the samples of a chain written to disk by MCMC.mhsample
 %   <a href="matlab:help classes\@MCMC\setInputs">classes\@MCMC\setInputs</a>            - (No help available)
 %   <a href="matlab:help classes\@MCMC\setModel">classes\@MCMC\setModel</a>             -  Set the model of the investigation.
 %   <a href="matlab:help classes\@MCMC\setNoise">classes\@MCMC\setNoise</a>             -  Set the measured noise of the experiment.
@@ -127,6 +127,9 @@ classdef MCMC < ltpda_algorithm
     varargout = plotLogLikelihood(varargin)
     varargout = computeICSMatrix(varargin)
     varargout = handle_data_for_icsm(varargin)
+    varargout = preprocessCache(varargin)
+    varargout = evaluateProposals(varargin)
+    varargout = readChain(varargin)
     
     function varargout = getBuiltInModels(varargin)
       if nargout == 0
@@ -204,6 +207,7 @@ classdef MCMC < ltpda_algorithm
   methods (Access = private, Static = true)
     
     varargout = defineLogLikelihood(varargin)
+    varargout = defineLogLikelihoodGradient(varargin)
     varargout = decision(varargin)
     varargout = logDecision(varargin)
     varargout = jump(varargin)
@@ -211,6 +215,7 @@ classdef MCMC < ltpda_algorithm
     varargout = mhutils(varargin)
     varargout = updateFIM(varargin)
     varargout = drawAdaptiveSample(varargin)
+    varargout = adaptCovariance(varargin)
     varargout = checkP0class(varargin)
     
   end
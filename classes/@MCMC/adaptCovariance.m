@@ -0,0 +1,57 @@
+% ADAPTCOVARIANCE: Update the running statistics of the adaptive proposal
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Update the running statistics of the adaptive proposal with the sample x
+%
+% The structure ad holds the number of samples (n), their mean (mean) and
+% the upper triangular Cholesky factor R of the scatter matrix, such that
+% cov = R'*R/(n-1). The mean follows Welford's recursion, and the scatter
+% matrix changes by the rank-one term (n-1)/n*dx'*dx, which is applied to
+% R by Givens rotations. Each update costs O(p^2) for p parameters,
+% independently of the length of the chain.
+%
+% CALL: ad = MCMC.adaptCovariance(ad, x)
+%       ad = MCMC.adaptCovariance([], p)   % empty statistics for p params
+%
+function ad = adaptCovariance(ad, x)
+  
+  if isempty(ad)
+    ad.n    = 0;
+    ad.mean = zeros(1, x);
+    ad.R    = zeros(x);
+    return
+  end
+  
+  % Put in a row vector always
+  if iscolumn(x)
+    x = transpose(x);
+  end
+  
+  ad.n    = ad.n + 1;
+  dx      = x - ad.mean;
+  ad.mean = ad.mean + dx/ad.n;
+  
+  % Rank-one update of the Cholesky factor. The rotations also cope with
+  % the zero pivots of the first few (rank deficient) updates.
+  v = sqrt((ad.n-1)/ad.n)*dx;
+  R = ad.R;
+  p = numel(v);
+  for kk = 1:p
+    r = hypot(R(kk,kk), v(kk));
+    if r == 0
+      continue
+    end
+    c        = R(kk,kk)/r;
+    s        = v(kk)/r;
+    R(kk,kk) = r;
+    if kk < p
+      Rk           = R(kk,kk+1:p);
+      R(kk,kk+1:p) = c*Rk + s*v(kk+1:p);
+      v(kk+1:p)    = c*v(kk+1:p) - s*Rk;
+    end
+  end
+  ad.R = R;
+  
+end
+
+% END
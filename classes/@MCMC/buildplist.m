@@ -73,6 +73,14 @@ function pl = buildplist(set)
       p = param({'YUNITS', 'The Y units of the noise time series, in case the MFH object is a ''core'' type.'}, paramValue.STRING_VALUE('m s^-2'));
       pl.append(p);
       
+      % PREPROCESS CACHE
+      p = param({'PREPROCESS CACHE', 'Set to true to keep the preprocessed frequency domain data (FFTs, inverse cross-spectrum matrices and frequencies) in memory, so that later runs on the same data skip the preprocessing.'}, paramValue.FALSE_TRUE);
+      pl.append(p);
+      
+      % PREPROCESS CACHE DIR
+      p = param({'PREPROCESS CACHE DIR', 'A directory where the preprocessed frequency domain data are also saved, to be used by later MATLAB sessions. Setting it enables the cache.'}, paramValue.EMPTY_STRING);
+      pl.append(p);
+      
       % WINDOW
       pl.combine(plist.WELCH_PLIST);
       
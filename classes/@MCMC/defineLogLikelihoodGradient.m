@@ -0,0 +1,61 @@
+% DEFINELOGLIKELIHOODGRADIENT.M
+% 
+% A utility function that creates a function handle returning the
+% log-likelihood together with its gradient, for the gradient-based
+% samplers of mhsample. Only the built-in log-likelihood of ssm models
+% has an analytic gradient (ssm/loglikelihoodGradient), either computed by
+% mhsample itself or passed as the mfh of MCMC/buildLogLikelihood. The
+% derivatives need the unprocessed model, so the 'DIFF MODEL' is used when
+% given.
+%
+% The handle is called as [loglk, grad, snr, loglkexp] = grad(x)
+%
+function grad = defineLogLikelihoodGradient(xo, model, data, param, lp, minFunc, Nexp, freqs, pl)
+
+  % The built-in log-likelihood of ssm models, as built by MCMC.process:
+  % take the data and the bode plists from its constants
+  spl = [];
+  if isa(minFunc, 'mfh') && strcmp(minFunc.func, 'loglikelihood_core(model, x, data, param, lp, spl)')
+    model   = minFunc.constObjects{1};
+    data    = minFunc.constObjects{2};
+    param   = minFunc.constObjects{3};
+    lp      = minFunc.constObjects{4};
+    spl     = minFunc.constObjects{5};
+    minFunc = [];
+  end
+  
+  dmodel = find(pl, 'diff model');
+  if isa(dmodel, 'ssm')
+    model = dmodel;
+  end
+  
+  if ~isempty(minFunc) || ~isa(model, 'ssm')
+    error(['### The gradient-based samplers need the analytic gradient of the log-likelihood, ' ...
+           'which is only available for ssm models without a user-defined log-likelihood.'])
+  end
+  
+  if isempty(spl)
+    outNames = find(pl, 'outNames');
+    inNames  = find(pl, 'inNames');
+    
+    spl(1:Nexp) = plist();
+    
+    % Define bode plist for ssm models
+    for kk = 1:Nexp
+      spl(kk) = plist('reorganize', false, 'f', freqs{kk},...
+                    'inputs',inNames,'outputs',outNames);
+    end
+  end
+  
+  grad = @(x) loglikelihoodGradient(model, x, data, param, lp, spl);
+  
+  % Evaluate function handle in order to check it
+  try
+    grad(xo);
+  catch Me
+    error('The evaluation of the gradient of the log-likelihood failed. Error: [%s]', Me.message)
+  end
+  
+end
+
+% END
@@ -5,14 +5,26 @@
 %
 % See Roberts, Rosenthal 'Examples of Adaptive MCMC' 
 %
-function [z, newSigma] = drawAdaptiveSample(mu, Sigma, b)
+% If the upper triangular Cholesky factor R of Sigma is given, the sample
+% is drawn as the sum of the two independent terms of the covariance, so
+% no new factorisation is needed.
+%
+function [z, newSigma] = drawAdaptiveSample(mu, Sigma, b, R)
 
   % get parameter space dimension
   dim = length(mu);
 
   % Calculate new covariance
   newSigma = ((2.38)^2)/dim.*Sigma + b.*(diag(ones(size(mu))));
-  z        = MCMC.drawSample(mu, newSigma);
+  
+  if nargin < 4
+    z = MCMC.drawSample(mu, newSigma);
+  else
+    if iscolumn(mu)
+      mu = transpose(mu);
+    end
+    z = mu + 2.38/sqrt(dim)*randn(1,dim)*R + sqrt(b)*randn(1,dim);
+  end
 
 end
 
@@ -0,0 +1,88 @@
+% EVALUATEPROPOSALS: Evaluate the bounds, prior and log-likelihood of a block of proposals
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Evaluate the bounds, the prior and the log-likelihood for a block of
+% proposals at once
+%
+% The bounds are checked for all rows together. The prior and the
+% log-likelihood are evaluated for the proposals inside the bounds only;
+% the others get -inf. By default they are called row by row. When they
+% are declared vectorised, they are called once on the block of the
+% proposals inside the bounds and must return one value per row, so that
+% their setup is shared by the whole block.
+%
+% CALL: [loglk, snr, p, inside, loglkexp] = MCMC.evaluateProposals(X, loglikelihood, prior, bounds)
+%       [loglk, snr, p, inside, loglkexp] = MCMC.evaluateProposals(X, loglikelihood, prior, bounds, vecLoglk, vecPrior)
+%
+% INPUTS:  X             - K x Nparams block of proposals
+%          loglikelihood - the log-likelihood function handle
+%          prior         - the prior function handle, or empty
+%          bounds        - 2 x Nparams lower and upper bounds
+%          vecLoglk      - (optional) true if the log-likelihood takes a
+%                          block of proposals and returns column vectors,
+%                          with one row per proposal of the values per
+%                          experiment [default: false]
+%          vecPrior      - (optional) true if the prior takes a block of
+%                          proposals and returns one value per row
+%                          [default: false]
+%
+% OUTPUTS: loglk, snr, p - K x 1 log-likelihood, SNR and prior values.
+%                          p is empty if there is no prior.
+%          inside        - K x 1 flags of the proposals inside the bounds
+%          loglkexp      - K x 1 cell with the values per experiment
+%
+function [loglk, snr, p, inside, loglkexp] = evaluateProposals(X, loglikelihood, prior, bounds, vecLoglk, vecPrior)
+
+  if nargin < 5
+    vecLoglk = false;
+  end
+  if nargin < 6
+    vecPrior = false;
+  end
+  
+  K = size(X,1);
+
+  % Bounds
+  inside = all(bsxfun(@ge, X, bounds(1,:)), 2) & all(bsxfun(@le, X, bounds(2,:)), 2);
+  idx    = find(inside);
+
+  % Prior
+  p = [];
+  if ~isempty(prior)
+    p = zeros(K,1);
+    if vecPrior && ~isempty(idx)
+      pv = prior(X(idx,:));
+      if numel(pv) ~= numel(idx)
+        error('### The vectorised prior must return one value per proposal.');
+      end
+      p(idx) = pv(:);
+    else
+      for kk = idx(:).'
+        p(kk) = prior(X(kk,:));
+      end
+    end
+  end
+
+  % Log-likelihood
+  loglk    = -inf(K,1);
+  snr      = zeros(K,1);
+  loglkexp = cell(K,1);
+  if vecLoglk && ~isempty(idx)
+    [L, S, Le] = loglikelihood(X(idx,:));
+    if numel(L) ~= numel(idx)
+      error('### The vectorised log-likelihood must return one value per proposal.');
+    end
+    loglk(idx) = L(:);
+    snr(idx)   = S(:);
+    for kk = 1:numel(idx)
+      loglkexp{idx(kk)} = Le(kk,:);
+    end
+  else
+    for kk = idx(:).'
+      [loglk(kk), snr(kk), loglkexp{kk}] = loglikelihood(X(kk,:));
+    end
+  end
+
+end
+
+% END
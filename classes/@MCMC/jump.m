@@ -7,7 +7,7 @@
 %
 % 2012
 %
-function [xn, hjump, Sn] = jump(xo,cvar,hjump,jumps,nacc,search,Tc,proposalSampler,ADAPTIVE, covUpdate, smpl, epsilon)
+function [xn, hjump, Sn] = jump(xo,cvar,hjump,jumps,nacc,search,Tc,proposalSampler,ADAPTIVE, covUpdate, adapt, epsilon)
   
   if search
     if nacc <= Tc(1)
@@ -38,12 +38,14 @@ function [xn, hjump, Sn] = jump(xo,cvar,hjump,jumps,nacc,search,Tc,proposalSampl
   % steps to respect the annealing procedures. Without the annealing, the
   % new covariance could be calculated on every iteration of the main MCMC
   % loop.
-  if ADAPTIVE && nacc > covUpdate && nacc<=Tc(3) && nacc > Tc(1) + covUpdate && mod(nacc, covUpdate) == 0
+  if ADAPTIVE && nacc > covUpdate && nacc<=Tc(3) && nacc > Tc(1) + covUpdate && mod(nacc, covUpdate) == 0 && adapt.n > 1
     
-    % Get the temporal chain & calculate the covariance
-    tempChain = smpl(nacc-covUpdate:nacc, 4:end);
-    newCov    = cov(tempChain);
-    [xn, Sn]  = MCMC.drawAdaptiveSample(xo,newCov,epsilon);
+    % The covariance of the chain is accumulated sample by sample in
+    % 'adapt' (see MCMC.adaptCovariance), together with its Cholesky
+    % factor, so it is not recomputed from the chain history here.
+    L         = adapt.R/sqrt(adapt.n - 1);
+    newCov    = L'*L;
+    [xn, Sn]  = MCMC.drawAdaptiveSample(xo,newCov,epsilon,L);
     
   % the default non-adaptive produces proposals from the normal
   % distribution. Note: this relies on the previous if search above.
@@ -22,6 +22,27 @@
 %              Matlab limitations, the SNR column contains also the
 %              log-likelihood values. 
 %
+%              With 'NCHAINS' larger than one, several chains are run
+%              concurrently (independent, or with parallel tempering if
+%              'TEMPERATURES' is given). The estimates use the chains at
+%              unit temperature, and the procinfo holds all the chains and
+%              their Gelman-Rubin R-hat values.
+%
+%              With 'PROPOSAL BLOCK' larger than one, each step draws a
+%              block of proposals, evaluates their bounds, priors and
+%              likelihoods together (MCMC.evaluateProposals) and uses
+%              the multiple-try Metropolis rule. The prior and the
+%              log-likelihood are called once per block when 'VECTORIZED'
+%              is set; the built-in log-likelihood of ssm models always
+%              is.
+%
+%              With 'SAMPLER' set to 'HMC' or 'NUTS', the proposals are
+%              trajectories of Hamiltonian Monte Carlo, driven by the
+%              analytic gradient of the log-likelihood of ssm models
+%              (ssm/loglikelihoodGradient). The proposal covariance, or
+%              the adaptive one, is used as inverse mass matrix. 'NUTS'
+%              sets the length of each trajectory with the No-U-Turn rule.
+%
 % <a href="matlab:utils.helper.displayMethodInfo('MCMC', 'MCMC.mhsample')">Parameters Description</a>      
 %
 % MN/NK 2013
@@ -72,6 +93,11 @@ function varargout = mhsample(varargin)
   p0            = find(pl, 'x0');
   covUpdate     = find(pl, 'cov update');
   adapt_factor  = find(pl, 'adaptive factor');
+  Nchains       = find(pl, 'Nchains');
+  temps         = find(pl, 'temperatures');
+  loga          = find(pl, 'loga');
+  chainFile     = find(pl, 'chain file');
+  sampler       = upper(find(pl, 'sampler'));
   
   % Sanity checks and utils
   [xo, cvar, jumps, bounds, decision, proposalsamp, issymmetric, Tc, proposalpdf, yunits, param, adaptive] = MCMC.mhutils(pl); 
@@ -102,85 +128,178 @@ function varargout = mhsample(varargin)
   
   smpl(1,:)      = [loglk1*p1 loglk1 snr1 xo];
   smplr(1,:)     = [loglk1*p2 loglk1 snr1 1 xo];
-  nacc           = 1;
-  samples        = 1;
-  nrej           = 0;
-  hjump          = 0;
+  
+  % The state of a chain
+  chain.xo        = xo;
+  chain.cvar      = cvar;
+  chain.hjump     = 0;
+  chain.p1        = p1;
+  chain.p2        = p2;
+  chain.loglk1    = loglk1;
+  chain.snr1      = snr1;
+  chain.loglkexp1 = loglkexp1;
+  chain.loglkexp2 = loglkexp2;
+  chain.samples   = 1;
+  chain.nacc      = 1;
+  chain.nrej      = 0;
+  chain.smpl      = smpl;
+  chain.smplr     = smplr;
+  chain.invT      = 1;
+  chain.stream    = 1;
+  chain.rngState  = [];
+  chain.offset    = 0;
+  chain.file      = '';
+  chain.filer     = '';
+  chain.naccPost  = 0;
+  chain.statN     = 0;
+  chain.statMean  = zeros(size(xo));
+  chain.statM2    = zeros(size(xo));
+  chain.adapt     = MCMC.adaptCovariance([], numel(xo));
+  chain.grad1     = [];
+  
+  % The settings of the sampler, shared by all chains
+  opts.jumps        = jumps;
+  opts.search       = search;
+  opts.Tc           = Tc;
+  opts.proposalsamp = proposalsamp;
+  opts.adaptive     = adaptive;
+  opts.covUpdate    = covUpdate;
+  opts.adapt_factor = adapt_factor;
+  opts.prior        = prior;
+  opts.bounds       = bounds;
+  opts.anneal       = anneal;
+  opts.xi           = xi;
+  opts.decision     = decision;
+  opts.proposalpdf  = proposalpdf;
+  opts.issymmetric  = issymmetric;
+  opts.burnin       = burnInLength(Tc);
+  opts.keep         = historyLength(pl);
+  opts.loga         = loga;
+  opts.block        = find(pl, 'proposal block');
+  opts.vecPrior     = find(pl, 'vectorized');
+  opts.vecLoglk     = opts.vecPrior || (isempty(inLogL) && isa(model, 'ssm'));
+  opts.sampler      = sampler;
+  opts.stepSize     = find(pl, 'step size');
+  opts.leapfrog     = find(pl, 'leapfrog steps');
+  opts.gradient     = [];
+  
+  if opts.block > 1 && ~issymmetric
+    error('### A block of proposals (''PROPOSAL BLOCK'' > 1) requires a symmetric proposal distribution.');
+  end
+  
+  if ~strcmp(sampler, 'MH')
+    if ~loga
+      error('### The %s sampler works with the logarithm of the likelihood. Please set ''LOGA'' to true.', sampler);
+    end
+    if opts.block > 1
+      error('### The %s sampler can not be combined with a block of proposals (''PROPOSAL BLOCK'' > 1).', sampler);
+    end
+    opts.gradient = MCMC.defineLogLikelihoodGradient(xo, model, data, param, lp, inLogL, Nexp, freqs, pl);
+  end
 
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%  Main Loop  %%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   
   utils.helper.msg(msg.IMPORTANT, '\n * Starting Monte Carlo sampling ...', mfilename('class'), mfilename);
   
-  while (samples < Nsamples)
+  if Nchains <= 1
     
-    % Sample new point on the parameter space
-    [xn, hjump, cvar] = MCMC.jump(xo, cvar, hjump, jumps, samples, search, Tc, proposalsamp, adaptive, covUpdate, smpl, adapt_factor);
-    
-    % compute prior probability 
-    if ~isempty(prior)
-      p2 = prior(xn);
+    if ~isempty(chainFile)
+      chain = createChainFiles(chain, chainFile);
     end
     
-    % Check if out of limits
-    if (any(xn < bounds(1,:)) || any(xn > bounds(2,:)))
+    while (chain.samples < Nsamples)
       
-      loglk2 = -inf;
-      snr2   = 0;
-      beta   = inf;
+      [chain, me, loglk2, beta, logr, snr2] = mhstep(chain, loglikelihood, opts);
       
-    else
-      
-      % Compute log-likelihood at proposed point
-      [loglk2, snr2, loglkexp2]  = loglikelihood(xn);
+      % Print to screen
+      if dbg_info
+        printMe(me, chain.loglk1, loglk2, chain.loglkexp1, chain.loglkexp2, beta, logr, chain.snr1, snr2, dof)
+      end
       
-      % Compute annealing factor
-      beta = MCMC.computeBeta(samples,Tc,anneal,xi);
+      % Display and save
+      [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, chain.samples, Fprint, oldsamples, oldacc, oldrej, chain.nrej, parplot, plotvec,...
+                                                      chain.nacc, ratio, param, chain.smpl, chain.smplr, all_param_names, writeToTXT, chain.offset);
       
-    end 
-       
-    % Decide if sample is accepted or not
-    [logr, answ, post] = decision(loglk1, loglk2, beta, proposalpdf, [p1 p2], issymmetric);
+    end % END of main loop
     
-    if answ
-      
-      xo               = xn; 
-      nacc             = nacc + 1;
-      samples          = samples + 1;
-      smpl(samples,:)  = [post(2) loglk2 snr2 xn];
-      p1               = p2;
-      
-      % Keep the rejected proposals also.
-      smplr(samples,:) = [post(2) loglk2 snr2 1 xn];
-      loglk1           = loglk2;
-      snr1             = snr2;
-      
-      % Answer = accepted
-      me = 'acc';
-      
+    if isempty(chainFile)
+      smpl    = chain.smpl;
+      smplr   = chain.smplr;
     else
+      chain   = flushChain(chain, 0);
+      smpl    = chain.file;
+      smplr   = chain.filer;
+    end
+    accRate = chain.naccPost/(chain.samples - opts.burnin);
+    
+  else
+    
+    % Temperature ladder
+    if isempty(temps)
+      temps = ones(1, Nchains);
+    end
+    if numel(temps) ~= Nchains || any(temps <= 0)
+      error('### Please give one positive temperature per chain.');
+    end
+    cold = find(temps == 1);
+    if isempty(cold)
+      error('### At least one of the chains must have unit temperature.');
+    end
+    
+    % Per-chain random streams, seeded from the global stream
+    seed   = randi(2^31-1);
+    chains = startChains(chain, Nchains, temps, loglikelihood, opts);
+    Rhat   = NaN(1, numel(xo));
+    
+    if ~isempty(chainFile)
+      [pth, nm, ext] = fileparts(chainFile);
+      for kk = 1:Nchains
+        chains(kk) = createChainFiles(chains(kk), fullfile(pth, sprintf('%s_%d%s', nm, kk, ext)));
+      end
+    end
+    
+    while (chains(1).samples < Nsamples)
       
-      nrej             = nrej + 1;
-      samples          = samples + 1;
-      smpl(samples,:)  = [post(1) loglk1 snr1 xo];
+      % Advance all chains to the next synchronisation point
+      target = min(Nsamples, (floor(chains(1).samples/Fprint)+1)*Fprint);
+      parfor kk = 1:Nchains
+        chains(kk) = runSegment(chains(kk), loglikelihood, opts, target, seed, Nchains);
+      end
       
-      % Keep the rejected proposals also.
-      smplr(samples,:) = [post(1) loglk1 snr2 0 xn];
+      % Exchange states between neighbouring temperatures
+      if any(temps ~= 1)
+        chains = swapStates(chains, loga);
+      end
       
-      % Answer = rejected
-      me = 'rej';    
+      % Convergence of the chains at unit temperature
+      Rhat = gelmanRubin(chains(cold));
       
-    end
+      % Display and save
+      [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, chains(1).samples, Fprint, oldsamples, oldacc, oldrej, chains(1).nrej, parplot, plotvec,...
+                                                      chains(1).nacc, ratio, param, chains(1).smpl, chains(1).smplr, all_param_names, writeToTXT, chains(1).offset);
+      if mod(chains(1).samples, Fprint) == 0
+        fprintf('      R-hat: %s\n\n', num2str(Rhat, '%8.4f'));
+      end
+      
+    end % END of main loop
     
-    % Print to screen
-    if dbg_info
-      printMe(me, loglk1, loglk2, loglkexp1, loglkexp2, beta, logr, snr1, snr2, dof)
+    % Pool the chains at unit temperature, without their burn-in
+    if isempty(chainFile)
+      smpl  = chains(cold(1)).smpl;
+      for kk = cold(2:end)
+        smpl = [smpl; chains(kk).smpl(opts.burnin+1:end,:)]; %#ok<AGROW>
+      end
+      smplr = chains(cold(1)).smplr;
+    else
+      for kk = 1:Nchains
+        chains(kk) = flushChain(chains(kk), 0);
+      end
+      smpl  = {chains(cold).file};
+      smplr = chains(cold(1)).filer;
     end
+    accRate = chains(cold(1)).naccPost/(chains(cold(1)).samples - opts.burnin);
     
-    % Display and save
-    [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, samples, Fprint, oldsamples, oldacc, oldrej, nrej, parplot, plotvec,...
-                                                    nacc, ratio, param, smpl, smplr, all_param_names, writeToTXT);
-    
-  end % END of main loop
+  end
   
   fprintf('-------------     Finalising    -------------\n');
   
@@ -188,7 +307,7 @@ function varargout = mhsample(varargin)
   [mn, cv, cr, PSRE, T, X, KStest] = MCMC.processChain(smpl, Tc, print_diag, plot_diag);
   
   % Print info on screen
-  totalAccRate = num2str(100*sum(smplr(Tc(end)+1:end,4))/numel(smplr(Tc(end)+1:end,4)), '%5.2f\n');
+  totalAccRate = num2str(100*accRate, '%5.2f\n');
   fprintf('* Total acceptance rate:                : = %s %% \n\n', totalAccRate)
 
   % Print message
@@ -212,15 +331,30 @@ function varargout = mhsample(varargin)
   p.setCorr(cr);
   
   p.setDy(sqrt(diag(cv)));
-  p.setChain(smpl);
+  if isnumeric(smpl)
+    p.setChain(smpl);
+  end
   
   % Save info to procinfo plist
-  p.setProcinfo(plist('smplr',      smplr,...
-                      'acc ratio',  ratio, ...
-                      'PSRE',       PSRE,...
-                      'corr',       T,...
-                      'Yu-Mykland', X,...
-                      'KStest',     KStest));
+  procinfo = plist('smplr',      smplr,...
+                   'acc ratio',  ratio, ...
+                   'PSRE',       PSRE,...
+                   'corr',       T,...
+                   'Yu-Mykland', X,...
+                   'KStest',     KStest);
+  if ~isempty(chainFile)
+    procinfo.append('chain file', smpl);
+  end
+  if Nchains > 1 && isempty(chainFile)
+    procinfo.append('chains',       cat(3, chains.smpl), ...
+                    'temperatures', temps, ...
+                    'Rhat',         Rhat);
+  elseif Nchains > 1
+    procinfo.append('chains',       {chains.file}, ...
+                    'temperatures', temps, ...
+                    'Rhat',         Rhat);
+  end
+  p.setProcinfo(procinfo);
   
 	% Set dof
   p.setDof(dof);
@@ -261,9 +395,14 @@ function [oldacc, oldrej, oldsamples, ...
   loga      = find(pl, 'loga');
   
   % In the first 3 columns of the chains, the log-posterior, the log-likelihood
-  % and the current SNR are stored.
-  smpl            = zeros(Nsamples, numel(param)+3);
-  smplr           = zeros(Nsamples, numel(param)+4);
+  % and the current SNR are stored. When the chain is written to a file, only
+  % the current block and the recent history are kept in memory.
+  Nbuf = Nsamples;
+  if ~isempty(find(pl, 'chain file'))
+    Nbuf = min(Nsamples, find(pl, 'chain block') + historyLength(pl));
+  end
+  smpl            = zeros(Nbuf, numel(param)+3);
+  smplr           = zeros(Nbuf, numel(param)+4);
   all_param_names = cell(1,numel(param)+3);
   ratio           = zeros(floor(Nsamples/Fprint),1);
 
@@ -359,6 +498,665 @@ function [oldacc, oldrej, oldsamples, ...
 
 end
 
+%--------------------------------------------------------------------------
+% One Metropolis-Hastings step of a chain
+%--------------------------------------------------------------------------
+function [ch, me, loglk2, beta, logr, snr2] = mhstep(ch, loglikelihood, opts)
+
+  if opts.block > 1
+    [ch, me, loglk2, beta, logr, snr2] = mtmstep(ch, loglikelihood, opts);
+    return
+  end
+  
+  switch opts.sampler
+    case 'HMC'
+      [ch, me, loglk2, beta, logr, snr2] = hmcstep(ch, opts);
+      return
+    case 'NUTS'
+      [ch, me, loglk2, beta, logr, snr2] = nutsstep(ch, opts);
+      return
+  end
+  
+  % Sample new point on the parameter space
+  [xn, ch.hjump, ch.cvar] = MCMC.jump(ch.xo, ch.cvar, ch.hjump, opts.jumps, ch.samples, opts.search, opts.Tc, ...
+                                      opts.proposalsamp, opts.adaptive, opts.covUpdate, ch.adapt, opts.adapt_factor);
+  
+  % compute prior probability 
+  if ~isempty(opts.prior)
+    ch.p2 = opts.prior(xn);
+  end
+  
+  % Check if out of limits
+  if (any(xn < opts.bounds(1,:)) || any(xn > opts.bounds(2,:)))
+    
+    loglk2 = -inf;
+    snr2   = 0;
+    beta   = inf;
+    
+  else
+    
+    % Compute log-likelihood at proposed point
+    [loglk2, snr2, ch.loglkexp2]  = loglikelihood(xn);
+    
+    % Compute annealing factor, at the temperature of the chain
+    beta = ch.invT*MCMC.computeBeta(ch.samples, opts.Tc, opts.anneal, opts.xi);
+    
+  end 
+  
+  % Decide if sample is accepted or not
+  [logr, answ, post] = opts.decision(ch.loglk1, loglk2, beta, opts.proposalpdf, [ch.p1 ch.p2], opts.issymmetric);
+  
+  [ch, me] = recordStep(ch, opts, answ, xn, post, loglk2, snr2);
+  
+end
+
+%--------------------------------------------------------------------------
+% One multiple-try Metropolis step of a chain [Liu, Liang & Wong, JASA 95
+% (2000) 121]. A block of 'PROPOSAL BLOCK' candidates is drawn and
+% evaluated at once, one of them is selected with a probability
+% proportional to its posterior, and it is accepted against a block of
+% reference points drawn around it. Requires a symmetric proposal.
+%--------------------------------------------------------------------------
+function [ch, me, loglk2, beta, logr, snr2] = mtmstep(ch, loglikelihood, opts)
+
+  K    = opts.block;
+  beta = ch.invT*MCMC.computeBeta(ch.samples, opts.Tc, opts.anneal, opts.xi);
+  
+  % Candidates around the current point
+  [Y, ch] = proposalBlock(ch, opts, ch.xo, K);
+  [L, S, P, ~, Le] = MCMC.evaluateProposals(Y, loglikelihood, opts.prior, opts.bounds, opts.vecLoglk, opts.vecPrior);
+  wy = logTarget(L, P, beta, opts.loga);
+  
+  if all(wy == -inf)
+    
+    % All candidates are out of bounds or impossible
+    jj   = 1;
+    logr = -inf;
+    
+  else
+    
+    % Select one candidate
+    pr = exp(wy - max(wy));
+    jj = find(rand(1)*sum(pr) <= cumsum(pr), 1);
+    
+    % Reference points around the candidate, and the current point
+    Xr = proposalBlock(ch, opts, Y(jj,:), K-1);
+    [Lr, ~, Pr] = MCMC.evaluateProposals(Xr, loglikelihood, opts.prior, opts.bounds, opts.vecLoglk, opts.vecPrior);
+    pcur = [];
+    if ~isempty(opts.prior)
+      pcur = ch.p1;
+    end
+    wx = [logTarget(Lr, Pr, beta, opts.loga); logTarget(ch.loglk1, pcur, beta, opts.loga)];
+    
+    logr = logSumExp(wy) - logSumExp(wx);
+    
+  end
+  
+  xn     = Y(jj,:);
+  loglk2 = L(jj);
+  snr2   = S(jj);
+  ch.loglkexp2 = Le{jj};
+  if ~isempty(opts.prior)
+    ch.p2 = P(jj);
+  end
+  
+  answ = log(rand(1)) < logr;
+  if opts.loga
+    post = [ch.loglk1 + ch.p1, loglk2 + ch.p2];
+  else
+    post = [ch.loglk1 * ch.p1, loglk2 * ch.p2];
+  end
+  
+  [ch, me] = recordStep(ch, opts, answ, xn, post, loglk2, snr2);
+  
+end
+
+%--------------------------------------------------------------------------
+% K proposals around x, drawn as in MCMC.jump
+%--------------------------------------------------------------------------
+function [X, ch] = proposalBlock(ch, opts, x, K)
+
+  X = zeros(K, numel(x));
+  hjump = ch.hjump;
+  for kk = 1:K
+    [X(kk,:), hj, cv] = MCMC.jump(x, ch.cvar, hjump, opts.jumps, ch.samples, opts.search, opts.Tc, ...
+                                  opts.proposalsamp, opts.adaptive, opts.covUpdate, ch.adapt, opts.adapt_factor);
+    if kk == 1
+      newHjump = hj;
+      newCvar  = cv;
+    end
+  end
+  if K > 0
+    ch.hjump = newHjump;
+    ch.cvar  = newCvar;
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Tempered log-posterior of a block of points, -inf where undefined
+%--------------------------------------------------------------------------
+function w = logTarget(L, p, beta, loga)
+
+  if loga
+    w = L;
+    if ~isempty(p)
+      w = w + p;
+    end
+  else
+    % non-positive values, as the -inf given out of the bounds, are
+    % impossible points
+    w = log(max(L, 0));
+    if ~isempty(p)
+      w = w + log(max(p, 0));
+    end
+  end
+  w(~isfinite(w)) = -inf;
+  w = beta*w;
+  w(isnan(w)) = -inf;
+  
+end
+
+%--------------------------------------------------------------------------
+% log(sum(exp(w)))
+%--------------------------------------------------------------------------
+function s = logSumExp(w)
+
+  m = max(w);
+  if isinf(m)
+    s = m;
+  else
+    s = m + log(sum(exp(w - m)));
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% One Hamiltonian Monte Carlo step of a chain [Neal, Handbook of MCMC
+% (2011) ch. 5]. A trajectory of 'LEAPFROG STEPS' steps, with a step size
+% jittered by +-10% around 'STEP SIZE', is accepted with the Metropolis
+% rule on the change of the Hamiltonian.
+%--------------------------------------------------------------------------
+function [ch, me, loglk2, beta, logr, snr2] = hmcstep(ch, opts)
+
+  beta = ch.invT*MCMC.computeBeta(ch.samples, opts.Tc, opts.anneal, opts.xi);
+  
+  [cur, ch]  = currentPoint(ch, opts);
+  [cvar, R]  = massMatrix(ch, opts);
+  r0         = (R\randn(numel(ch.xo),1)).';
+  e          = opts.stepSize*(0.9 + 0.2*rand(1));
+  
+  pt = cur;
+  r  = r0;
+  for ll = 1:opts.leapfrog
+    [pt, r] = leapfrog(pt, r, e, opts, beta, cvar);
+    if pt.U == -inf
+      break
+    end
+  end
+  
+  logr = (beta*pt.U - kinetic(r, cvar)) - (beta*cur.U - kinetic(r0, cvar));
+  if isnan(logr)
+    logr = -inf;
+  end
+  answ = log(rand(1)) < logr;
+  
+  [ch, me, loglk2, snr2] = finishStep(ch, opts, answ, pt);
+  
+end
+
+%--------------------------------------------------------------------------
+% One No-U-Turn step of a chain [Hoffman & Gelman, JMLR 15 (2014) 1593,
+% algorithm 3]. The trajectory is doubled in a random direction until it
+% turns back on itself, and the new point is drawn from the points of the
+% trajectory on the slice. The number of doublings is limited to 10.
+%--------------------------------------------------------------------------
+function [ch, me, loglk2, beta, logr, snr2] = nutsstep(ch, opts)
+
+  maxDepth = 10;
+  beta     = ch.invT*MCMC.computeBeta(ch.samples, opts.Tc, opts.anneal, opts.xi);
+  
+  [cur, ch] = currentPoint(ch, opts);
+  [cvar, R] = massMatrix(ch, opts);
+  r0        = (R\randn(numel(ch.xo),1)).';
+  e         = opts.stepSize*(0.9 + 0.2*rand(1));
+  logu      = beta*cur.U - kinetic(r0, cvar) + log(rand(1));
+  
+  pm = cur; rm = r0;
+  pp = cur; rp = r0;
+  pt    = cur;
+  answ  = false;
+  n     = 1;
+  s     = true;
+  depth = 0;
+  while s && depth < maxDepth
+    v = 2*(rand(1) < 0.5) - 1;
+    if v < 0
+      [pm, rm, ~, ~, prop, n2, s2] = buildTree(pm, rm, logu, v, depth, e, opts, beta, cvar);
+    else
+      [~, ~, pp, rp, prop, n2, s2] = buildTree(pp, rp, logu, v, depth, e, opts, beta, cvar);
+    end
+    if s2 && rand(1) < n2/n
+      pt   = prop;
+      answ = true;
+    end
+    n     = n + n2;
+    s     = s2 && noUTurn(pm, rm, pp, rp, cvar);
+    depth = depth + 1;
+  end
+  
+  logr = beta*(pt.U - cur.U);
+  
+  [ch, me, loglk2, snr2] = finishStep(ch, opts, answ, pt);
+  
+end
+
+%--------------------------------------------------------------------------
+% Subtree of 2^j leapfrog steps from (pt, r) in the direction v
+%--------------------------------------------------------------------------
+function [pm, rm, pp, rp, prop, n, s] = buildTree(pt, r, logu, v, j, e, opts, beta, cvar)
+
+  if j == 0
+    
+    [prop, r] = leapfrog(pt, r, v*e, opts, beta, cvar);
+    H  = beta*prop.U - kinetic(r, cvar);
+    n  = double(logu <= H);
+    s  = logu < H + 1000;
+    pm = prop; rm = r;
+    pp = prop; rp = r;
+    
+  else
+    
+    [pm, rm, pp, rp, prop, n, s] = buildTree(pt, r, logu, v, j-1, e, opts, beta, cvar);
+    if s
+      if v < 0
+        [pm, rm, ~, ~, prop2, n2, s2] = buildTree(pm, rm, logu, v, j-1, e, opts, beta, cvar);
+      else
+        [~, ~, pp, rp, prop2, n2, s2] = buildTree(pp, rp, logu, v, j-1, e, opts, beta, cvar);
+      end
+      if n + n2 > 0 && rand(1) < n2/(n + n2)
+        prop = prop2;
+      end
+      n = n + n2;
+      s = s2 && noUTurn(pm, rm, pp, rp, cvar);
+    end
+    
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% True while the ends of the trajectory still move away from each other
+%--------------------------------------------------------------------------
+function ok = noUTurn(pm, rm, pp, rp, cvar)
+
+  dx = pp.x - pm.x;
+  ok = (dx*cvar*rm.' >= 0) && (dx*cvar*rp.' >= 0);
+  
+end
+
+%--------------------------------------------------------------------------
+% One leapfrog step of size e. The log-posterior is tempered by beta, and
+% cvar is the inverse mass matrix.
+%--------------------------------------------------------------------------
+function [pt, r] = leapfrog(pt, r, e, opts, beta, cvar)
+
+  r  = r + 0.5*e*beta*pt.g;
+  pt = gradientPoint(pt.x + e*r*cvar, opts);
+  r  = r + 0.5*e*beta*pt.g;
+  
+end
+
+%--------------------------------------------------------------------------
+% Kinetic energy of the momentum r
+%--------------------------------------------------------------------------
+function K = kinetic(r, cvar)
+
+  K = 0.5*(r*cvar*r.');
+  
+end
+
+%--------------------------------------------------------------------------
+% The log-posterior U = loglk + prior and its gradient at x. The points
+% out of bounds get U = -inf.
+%--------------------------------------------------------------------------
+function pt = gradientPoint(x, opts)
+
+  pt.x     = x;
+  pt.U     = -inf;
+  pt.g     = zeros(size(x));
+  pt.loglk = -inf;
+  pt.snr   = 0;
+  pt.le    = [];
+  pt.p     = 0;
+  
+  if any(x < opts.bounds(1,:)) || any(x > opts.bounds(2,:))
+    return
+  end
+  
+  [pt.loglk, g, pt.snr, pt.le] = opts.gradient(x);
+  U = pt.loglk;
+  
+  % The prior is cheap: differentiate it numerically
+  if ~isempty(opts.prior)
+    pt.p = opts.prior(x);
+    U    = U + pt.p;
+    for kk = 1:numel(x)
+      h       = 1e-6*max(abs(x(kk)), 1);
+      xh      = x;
+      xh(kk)  = x(kk) + h;
+      pu      = opts.prior(xh);
+      xh(kk)  = x(kk) - h;
+      g(kk)   = g(kk) + (pu - opts.prior(xh))/(2*h);
+    end
+  end
+  
+  if isnan(U) || any(isnan(g))
+    return
+  end
+  pt.U = U;
+  pt.g = g;
+  
+end
+
+%--------------------------------------------------------------------------
+% The current point of the chain. Its gradient is kept in the chain, and
+% evaluated again only when the state was set elsewhere (start, swaps).
+%--------------------------------------------------------------------------
+function [pt, ch] = currentPoint(ch, opts)
+
+  if isempty(ch.grad1)
+    pt       = gradientPoint(ch.xo, opts);
+    ch.grad1 = pt.g;
+  end
+  
+  pt.x     = ch.xo;
+  pt.U     = ch.loglk1;
+  pt.g     = ch.grad1;
+  pt.loglk = ch.loglk1;
+  pt.snr   = ch.snr1;
+  pt.le    = ch.loglkexp1;
+  pt.p     = 0;
+  if ~isempty(opts.prior)
+    pt.p = ch.p1;
+    pt.U = pt.U + ch.p1;
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% The inverse mass matrix and its Cholesky factor: the adaptive covariance
+% of the chain once it is defined, the proposal covariance otherwise
+%--------------------------------------------------------------------------
+function [cvar, R] = massMatrix(ch, opts)
+
+  if opts.adaptive && ch.adapt.n > numel(ch.xo)
+    R    = ch.adapt.R/sqrt(ch.adapt.n-1);
+    cvar = R.'*R;
+  else
+    cvar = ch.cvar;
+    R    = chol(cvar);
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Record the end point of a trajectory
+%--------------------------------------------------------------------------
+function [ch, me, loglk2, snr2] = finishStep(ch, opts, answ, pt)
+
+  loglk2       = pt.loglk;
+  snr2         = pt.snr;
+  ch.loglkexp2 = pt.le;
+  if ~isempty(opts.prior)
+    ch.p2 = pt.p;
+  end
+  post = [ch.loglk1 + ch.p1, loglk2 + ch.p2];
+  
+  [ch, me] = recordStep(ch, opts, answ, pt.x, post, loglk2, snr2);
+  if answ
+    ch.grad1 = pt.g;
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Store the outcome of a step and update the running statistics
+%--------------------------------------------------------------------------
+function [ch, me] = recordStep(ch, opts, answ, xn, post, loglk2, snr2)
+
+  ch.samples = ch.samples + 1;
+  row        = ch.samples - ch.offset;
+  
+  if answ
+    
+    ch.xo            = xn; 
+    ch.nacc          = ch.nacc + 1;
+    ch.smpl(row,:)   = [post(2) loglk2 snr2 xn];
+    ch.p1            = ch.p2;
+    
+    % Keep the rejected proposals also.
+    ch.smplr(row,:)  = [post(2) loglk2 snr2 1 xn];
+    ch.loglk1        = loglk2;
+    ch.snr1          = snr2;
+    
+    % Answer = accepted
+    me = 'acc';
+    
+  else
+    
+    ch.nrej          = ch.nrej + 1;
+    ch.smpl(row,:)   = [post(1) ch.loglk1 ch.snr1 ch.xo];
+    
+    % Keep the rejected proposals also.
+    ch.smplr(row,:)  = [post(1) ch.loglk1 snr2 0 xn];
+    
+    % Answer = rejected
+    me = 'rej';    
+    
+  end
+  
+  % Covariance of the chain for the adaptive proposal, accumulated after
+  % the annealing and up to Tc(3)
+  if opts.adaptive && ch.samples > opts.Tc(1) && ch.samples <= opts.Tc(3)
+    ch.adapt = MCMC.adaptCovariance(ch.adapt, ch.xo);
+  end
+  
+  % Running statistics after the burn-in
+  if ch.samples > opts.burnin
+    ch.naccPost = ch.naccPost + answ;
+    ch.statN    = ch.statN + 1;
+    dx          = ch.xo - ch.statMean;
+    ch.statMean = ch.statMean + dx/ch.statN;
+    ch.statM2   = ch.statM2 + dx.*(ch.xo - ch.statMean);
+  end
+  
+  % Write the oldest samples to the chain file when the buffer is full
+  if row == size(ch.smpl, 1) && ~isempty(ch.file)
+    ch = flushChain(ch, opts.keep);
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Copies of the initial chain for the multi-chain mode. The chains other
+% than the first one start from a point drawn around x0, so that the R-hat
+% diagnostic is meaningful.
+%--------------------------------------------------------------------------
+function chains = startChains(chain, Nchains, temps, loglikelihood, opts)
+
+  chains = repmat(chain, 1, Nchains);
+  
+  for kk = 1:Nchains
+    
+    chains(kk).invT   = 1/temps(kk);
+    chains(kk).stream = kk;
+    
+    if kk > 1
+      for tt = 1:100
+        xk = opts.proposalsamp(chain.xo, opts.jumps(1)^2*chain.cvar);
+        if all(xk >= opts.bounds(1,:)) && all(xk <= opts.bounds(2,:))
+          break
+        end
+        xk = chain.xo;
+      end
+      
+      if ~isempty(opts.prior)
+        chains(kk).p1 = opts.prior(xk);
+      end
+      [chains(kk).loglk1, chains(kk).snr1, chains(kk).loglkexp1] = loglikelihood(xk);
+      
+      chains(kk).xo         = xk;
+      chains(kk).smpl(1,:)  = [chains(kk).loglk1*chains(kk).p1 chains(kk).loglk1 chains(kk).snr1 xk];
+      chains(kk).smplr(1,:) = [chains(kk).loglk1*chains(kk).p2 chains(kk).loglk1 chains(kk).snr1 1 xk];
+    end
+    
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Advance a chain up to the sample 'target'. The chain draws from its own
+% stream, so that the chains are independent and reproducible whether they
+% run on the workers of a parallel pool or in this session.
+%--------------------------------------------------------------------------
+function ch = runSegment(ch, loglikelihood, opts, target, seed, Nchains)
+
+  s = RandStream('mrg32k3a', 'NumStreams', Nchains, 'StreamIndices', ch.stream, 'Seed', seed);
+  if ~isempty(ch.rngState)
+    s.State = ch.rngState;
+  end
+  prev = RandStream.setGlobalStream(s);
+  
+  while (ch.samples < target)
+    ch = mhstep(ch, loglikelihood, opts);
+  end
+  
+  ch.rngState = s.State;
+  RandStream.setGlobalStream(prev);
+  
+end
+
+%--------------------------------------------------------------------------
+% Parallel tempering: neighbouring chains of the temperature ladder swap
+% their states with probability
+%   min(1, exp((1/T(k) - 1/T(k+1))*(logpost(k+1) - logpost(k))))
+%--------------------------------------------------------------------------
+function chains = swapStates(chains, loga)
+
+  fields = {'xo', 'p1', 'loglk1', 'snr1', 'loglkexp1', 'grad1'};
+  
+  for kk = 1:numel(chains)-1
+    a = chains(kk);
+    b = chains(kk+1);
+    if loga
+      logr = (a.invT - b.invT)*((b.loglk1 + b.p1) - (a.loglk1 + a.p1));
+    else
+      logr = (a.invT - b.invT)*log((b.loglk1*b.p1)/(a.loglk1*a.p1));
+    end
+    if log(rand(1)) < logr
+      for ff = 1:numel(fields)
+        chains(kk).(fields{ff})   = b.(fields{ff});
+        chains(kk+1).(fields{ff}) = a.(fields{ff});
+      end
+    end
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Gelman-Rubin potential scale reduction factor of each parameter, from the
+% running means and variances of the chains after the burn-in
+%--------------------------------------------------------------------------
+function R = gelmanRubin(chains)
+
+  M = numel(chains);
+  n = chains(1).statN;
+  R = NaN(size(chains(1).statMean));
+  
+  if M < 2 || n < 4
+    return
+  end
+  
+  W = mean(reshape([chains.statM2], [], M), 2).'/(n-1);
+  B = n*var(reshape([chains.statMean], [], M), 0, 2).';
+  V = (n-1)/n*W + B/n;
+  R = sqrt(V./W);
+  
+end
+
+%--------------------------------------------------------------------------
+% Number of burn-in samples, as discarded by MCMC.processChain
+%--------------------------------------------------------------------------
+function n = burnInLength(Tc)
+
+  if isempty(Tc)
+    n = 0;
+  else
+    n = Tc(end);
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Number of recent samples which must stay in memory: the window of the
+% progress report
+%--------------------------------------------------------------------------
+function n = historyLength(pl)
+
+  n = find(pl, 'Fprint') + 1;
+  
+end
+
+%--------------------------------------------------------------------------
+% Create the binary files of a chain and of its proposals. Each file starts
+% with the number of columns, followed by the samples one after the other.
+%--------------------------------------------------------------------------
+function ch = createChainFiles(ch, file)
+
+  [pth, nm, ext] = fileparts(file);
+  ch.file  = file;
+  ch.filer = fullfile(pth, [nm '_proposals' ext]);
+  
+  files = {ch.file, ch.filer};
+  ncols = [size(ch.smpl,2), size(ch.smplr,2)];
+  for ff = 1:2
+    fid = fopen(files{ff}, 'w');
+    if fid < 0
+      error('### Unable to open the chain file [%s].', files{ff});
+    end
+    fwrite(fid, ncols(ff), 'double');
+    fclose(fid);
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Append the buffered samples of a chain to its files, keeping the last
+% 'keep' samples in the buffer.
+%--------------------------------------------------------------------------
+function ch = flushChain(ch, keep)
+
+  n    = ch.samples - ch.offset;
+  nout = max(0, n - keep);
+  
+  files = {ch.file, ch.filer};
+  data  = {ch.smpl(1:nout,:), ch.smplr(1:nout,:)};
+  for ff = 1:2
+    fid = fopen(files{ff}, 'a');
+    if fid < 0
+      error('### Unable to open the chain file [%s].', files{ff});
+    end
+    fwrite(fid, data{ff}.', 'double');
+    fclose(fid);
+  end
+  
+  ch.smpl(1:n-nout,:)  = ch.smpl(nout+1:n,:);
+  ch.smplr(1:n-nout,:) = ch.smplr(nout+1:n,:);
+  ch.offset            = ch.offset + nout;
+  
+end
+
 %--------------------------------------------------------------------------
 % normLikelihood to the Ndata points
 %--------------------------------------------------------------------------
@@ -372,16 +1170,19 @@ end
 % Function to to report on screen or plot the traces
 %--------------------------------------------------------------------------
 function [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, samples, Fprint, oldsamples, oldacc, oldrej, nrej, parplot, plotvec, ...
-                                                         nacc, ratio, param, smpl, smplr, all_param_names, writeToTXT)
+                                                         nacc, ratio, param, smpl, smplr, all_param_names, writeToTXT, offset)
 
   if(mod(samples,Fprint) == 0 && (samples) ~= (oldsamples))
 
     updacc = nacc-oldacc;
     updrej = nrej-oldrej;
 
+    % rows of the buffered chain
+    rows = (floor(samples/Fprint)-1)*Fprint+1-offset:samples-offset;
+
     ratio(samples/Fprint,:) = updacc/(updacc+updrej);
-    xn = mean(smpl((floor(samples/Fprint)-1)*Fprint+1:samples,4:end));
-    sn = std(smpl((floor(samples/Fprint)-1)*Fprint+1:samples,4:end));
+    xn = mean(smpl(rows,4:end));
+    sn = std(smpl(rows,4:end));
     
     txt = {};
     
@@ -396,7 +1197,7 @@ function [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, samples, Fpri
       txt = [txt; {sprintf('     %s', getParameterString(param, xn, sn, pp))}];
     end
     txt = [txt; {' '}];
-    txt = [txt; {sprintf('  Posterior: %s', utils.helper.val2str(smplr(samples, 1)))}];
+    txt = [txt; {sprintf('  Posterior: %s', utils.helper.val2str(smplr(samples-offset, 1)))}];
     txt = [txt; {sprintf('    Samples: %s of %s', utils.helper.val2str(samples), utils.helper.val2str(Nsamples))}];
     txt = [txt; {sprintf('  acc. rate: %s %%', utils.helper.val2str(round(100*(updacc/(updacc+updrej)))))}];
     %txt = [txt; {' '}];
@@ -415,12 +1216,19 @@ function [ratio, oldacc, oldrej, oldsamples] = printinfo(Nsamples, samples, Fpri
     oldsamples = samples;
 
     if writeToTXT
-      save('acceptance.txt','ratio','-ASCII')
+      % append the new value only
+      if samples == Fprint
+        fid = fopen('acceptance.txt', 'w');
+      else
+        fid = fopen('acceptance.txt', 'a');
+      end
+      fprintf(fid, '  %.7e\n', ratio(samples/Fprint));
+      fclose(fid);
     end
 
     % Plot Traces
     if  parplot        
-      utils.helper.plotTraces(plotvec, numel(all_param_names), smpl(1:samples,:), all_param_names, xn, 'r', 'k');
+      utils.helper.plotTraces(plotvec, numel(all_param_names), smpl(1:samples-offset,:), all_param_names, xn, 'r', 'k');
       drawnow;
     end
   end
@@ -561,6 +1369,32 @@ function pl = buildplist()
                              'If this field is empty, a symmetric PDF is assumed. Check help for details.']}, paramValue.EMPTY_DOUBLE);
   pl.append(p);
   
+  % PROPOSAL BLOCK
+  p = param({'PROPOSAL BLOCK',['The number of proposals drawn and evaluated together at each step. When larger than one, ',...
+                               'the multiple-try Metropolis algorithm is used, which requires a symmetric proposal PDF.']}, paramValue.DOUBLE_VALUE(1));
+  pl.append(p);
+  
+  % VECTORIZED
+  p = param({'VECTORIZED',['Set to true if the ''PRIOR'' and the ''LOGLIKELIHOOD'' functions accept a block of proposals, ',...
+                           'one per row, and return one value per row. They are then called once per block of proposals ',...
+                           '(''PROPOSAL BLOCK'' > 1) instead of once per proposal.']}, paramValue.FALSE_TRUE);
+  pl.append(p);
+  
+  % SAMPLER
+  p = param({'SAMPLER',['The sampler. ''MH'' is the random-walk Metropolis-Hastings. ''HMC'' (Hamiltonian Monte Carlo) and ',...
+                        '''NUTS'' (No-U-Turn sampler) use the analytic gradient of the log-likelihood of ssm models, and the ',...
+                        'proposal covariance as inverse mass matrix.']}, {1, {'MH', 'HMC', 'NUTS'}, paramValue.SINGLE});
+  pl.append(p);
+  
+  % STEP SIZE
+  p = param({'STEP SIZE',['The leapfrog step size of the ''HMC'' and ''NUTS'' samplers, in units of the proposal covariance. ',...
+                          'It is jittered by +-10% at each step.']}, paramValue.DOUBLE_VALUE(0.1));
+  pl.append(p);
+  
+  % LEAPFROG STEPS
+  p = param({'LEAPFROG STEPS','The number of leapfrog steps of each trajectory of the ''HMC'' sampler.'}, paramValue.DOUBLE_VALUE(10));
+  pl.append(p);
+  
   % heat
   p = param({'HEAT','The heat index flattening likelihood surface during annealing.'}, paramValue.DOUBLE_VALUE(1));
   pl.append(p);
@@ -663,10 +1497,33 @@ function pl = buildplist()
   pl.append(p);
 
   % COV UPDATE
-  p = param({'COVARIANCE UPDATE', 'For the cases where the ''ADAPTIVE'' scheme is active, this key defines the number of samples after which the covariance matrix is updated up until TC(3). See plist key ''TC''.'}, paramValue.DOUBLE_VALUE(1e3));
+  p = param({'COVARIANCE UPDATE', 'For the cases where the ''ADAPTIVE'' scheme is active, this key defines the number of samples after which the proposal covariance is refreshed from the running covariance of the chain, up until TC(3). See plist key ''TC''.'}, paramValue.DOUBLE_VALUE(1e3));
   p.addAlternativeKey('COV UPDATE');
   pl.append(p);
   
+  % NCHAINS
+  p = param({'NCHAINS',['The number of chains. When larger than one, the chains are run concurrently, on the workers of the ',...
+                        'parallel pool if one is open, each with its own random stream. The chains are synchronised every ',...
+                        '''FPRINT'' samples, when the Gelman-Rubin R-hat diagnostic is updated.']}, paramValue.DOUBLE_VALUE(1));
+  pl.append(p);
+  
+  % TEMPERATURES
+  p = param({'TEMPERATURES',['The temperature of each chain, for parallel tempering. At every synchronisation, neighbouring ',...
+                             'chains try to swap their states. Only the chains at unit temperature are used for the estimates. ',...
+                             'Leave empty to run independent chains.']}, paramValue.EMPTY_DOUBLE);
+  pl.append(p);
+  
+  % CHAIN FILE
+  p = param({'CHAIN FILE',['The name of a binary file to write the chain to, in blocks, instead of keeping it in memory. ',...
+                           'The proposals are written to a second file with the suffix ''_proposals''. The statistics are ',...
+                           'computed by reading the files back block by block, and the pest does not hold the chain. ',...
+                           'Use MCMC.readChain to load the samples.']}, paramValue.EMPTY_STRING);
+  pl.append(p);
+  
+  % CHAIN BLOCK
+  p = param({'CHAIN BLOCK','The number of samples written to the chain file at once.'}, paramValue.DOUBLE_VALUE(1e4));
+  pl.append(p);
+  
   % support rebuild by allowing the rand_stream to be specified
   pl.append(plist.RAND_STREAM);
   
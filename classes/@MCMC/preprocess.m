@@ -11,6 +11,12 @@
 % OUTPUTS:        The processed inputs, outputs, noise spectrum and the
 %                 set of frequencies of the analysis.
 %
+% If the key 'PREPROCESS CACHE' is true, or 'PREPROCESS CACHE DIR' is set,
+% the results are cached (see MCMC.preprocessCache), keyed on the UUIDs of
+% the data and on the keys of the plist which affect the preprocessing.
+% Analysing the same data again, e.g. with another model or prior, then
+% skips the FFTs and the inverse cross-spectrum matrices.
+%
 function [fin, fout, Sn] = preprocess(algo)
   
   import utils.const.*
@@ -27,6 +33,24 @@ function [fin, fout, Sn] = preprocess(algo)
   f2      = algo.params.find('f2');
   outputs = algo.outputs;
   
+  % Look for the results of a previous run on the same data
+  cacheKey = '';
+  cacheDir = algo.params.find('PREPROCESS CACHE DIR');
+  if algo.params.find('PREPROCESS CACHE') || ~isempty(cacheDir)
+    cacheKey = preprocessKey(algo);
+  end
+  if ~isempty(cacheKey)
+    entry = MCMC.preprocessCache(cacheKey, cacheDir);
+    if ~isempty(entry)
+      utils.helper.msg(msg.PROC1, 'Using the cached frequency domain objects ... ', mfilename('class'), mfilename);
+      fin        = copy(entry.fin, 1);
+      fout       = copy(entry.fout, 1);
+      Sn         = copy(entry.Sn, 1);
+      algo.freqs = entry.freqs;
+      return
+    end
+  end
+  
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%   Perform Sanity Checks on inputs  %%%%%%%%%%%%%%%%%%%%%%%%
   
   if isempty(inputs)
@@ -82,8 +106,9 @@ function [fin, fout, Sn] = preprocess(algo)
   
   utils.helper.msg(msg.PROC1, 'Computing frequency domain objects ... ', mfilename('class'), mfilename);
   
-  % Resampling
+  % Resampling. Work on a copy, so the data (and its UUID) are unchanged.
   if ~isempty(fsout)
+    outputs = copy(outputs, 1);
     if input_flag
       inputs.resample(plist('fsout',fsout));
     end
@@ -208,6 +233,43 @@ function [fin, fout, Sn] = preprocess(algo)
   end % End loop over experiments
   
   algo.freqs = freqs;
+  
+  if ~isempty(cacheKey)
+    entry = struct('fin', copy(fin, 1), 'fout', copy(fout, 1), 'Sn', copy(Sn, 1));
+    entry.freqs = freqs;
+    MCMC.preprocessCache(cacheKey, cacheDir, entry);
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Key of the preprocessed data: the UUIDs of the inputs, outputs and noise
+% and the values of the keys which affect the preprocessing. Returns an
+% empty key (no caching) if an object has no UUID.
+%--------------------------------------------------------------------------
+function key = preprocessKey(algo)
+  
+  key   = '';
+  uuids = {};
+  objs  = {algo.inputs, algo.outputs, algo.noise};
+  for kk = 1:numel(objs)
+    if isa(objs{kk}, 'ltpda_uo')
+      uuids = [uuids {objs{kk}(:).UUID}]; %#ok<AGROW>
+    end
+  end
+  if isempty(uuids) || any(cellfun('isempty', uuids))
+    return
+  end
+  
+  keys = [{'FREQUENCIES', 'FSOUT', 'F1', 'F2', 'NOISE SCALE', 'WIN', 'ISDIAG', ...
+           'INTERPOLATION METHOD', 'NAVS', 'BIN DATA', 'OLAP', 'ORDER', ...
+           'FIT NOISE MODEL', 'DOPLOT', 'POLYNOMIAL ORDER'}, getKeys(plist.WELCH_PLIST)];
+  keys = unique(upper(keys));
+  keys = keys(cellfun(@(k) algo.params.isparam(k), keys));
+  
+  txt = [sprintf('%s;', uuids{:}) string(subset(algo.params, keys))];
+  key = utils.prog.hash(txt, 'MD5');
+  
 end
 
 % END
\ No newline at end of file
@@ -0,0 +1,91 @@
+% PREPROCESSCACHE: Store and retrieve the preprocessed data of MCMC runs
+%
+% Store and retrieve the preprocessed frequency-domain data of MCMC runs
+%
+% The entries are kept in memory for the MATLAB session and, if a
+% directory is given, also in MAT files in that directory, so that later
+% sessions can use them. The key is computed by MCMC.preprocess from the
+% UUIDs of the data and the keys of the plist which affect the
+% preprocessing.
+%
+% The 'stats' call returns the number of entries found in memory and in
+% the files, and the number of entries stored, since the cache was last
+% cleared.
+%
+% CALL: entry = MCMC.preprocessCache(key, cacheDir)         % [] if not cached
+%               MCMC.preprocessCache(key, cacheDir, entry)  % store
+%               MCMC.preprocessCache('clear')          % empty the memory cache
+%       stats = MCMC.preprocessCache('stats')          % hits and stores
+%
+function entry = preprocessCache(key, cacheDir, entry)
+  
+  persistent cache
+  persistent order
+  persistent stats
+  
+  % Number of entries kept in memory
+  Nmax = 10;
+  
+  if isempty(cache) || strcmpi(key, 'clear')
+    cache = containers.Map();
+    order = {};
+    stats = struct('memoryHits', 0, 'fileHits', 0, 'stores', 0);
+    if strcmpi(key, 'clear')
+      return
+    end
+  end
+  
+  if strcmpi(key, 'stats')
+    entry = stats;
+    return
+  end
+  
+  if nargin < 2
+    cacheDir = '';
+  end
+  fname = '';
+  if ~isempty(cacheDir)
+    fname = fullfile(cacheDir, ['mcmc_preprocess_' key '.mat']);
+  end
+  
+  if nargin < 3
+    
+    % Retrieve
+    entry = [];
+    if isKey(cache, key)
+      entry = cache(key);
+      stats.memoryHits = stats.memoryHits + 1;
+    elseif ~isempty(fname) && exist(fname, 'file') == 2
+      s     = load(fname, 'entry');
+      entry = s.entry;
+      cache(key) = entry; %#ok<NASGU>
+      order{end+1} = key;
+      stats.fileHits = stats.fileHits + 1;
+    end
+    
+  else
+    
+    % Store
+    if ~isKey(cache, key)
+      order{end+1} = key;
+    end
+    cache(key) = entry; %#ok<NASGU>
+    stats.stores = stats.stores + 1;
+    if ~isempty(fname)
+      if exist(cacheDir, 'dir') ~= 7
+        mkdir(cacheDir);
+      end
+      save(fname, 'entry');
+    end
+    
+  end
+  
+  % Drop the oldest entries
+  while numel(order) > Nmax
+    remove(cache, order{1});
+    order(1) = [];
+  end
+  
+end
+
+% END
@@ -7,6 +7,10 @@
 %
 %       INPUTS:  The MCMC chain and the Tc, the vector that defines the 
 %                i-th sample to be descarded and a debugging flag.
+%                The chain can also be given as the name (or a cell
+%                array of names) of chain files written by MCMC.mhsample.
+%                The mean and covariance are then accumulated block by
+%                block, and the diagnostics use a thinned chain.
 %
 %      OUTPUTS:  A pest objects with the statsistics of the MCMC chain.
 %                Most information is stored in the procinfo property of the
@@ -21,8 +25,6 @@ function [mn, cv, cr, PSRF, T, X, KStest] = processChain(smpl, Tc, dbg_info, plo
   
   import utils.const.*
   
-  nparam = size(smpl,2)-3;
-
   % Get rid of the burn-in samples
   if isempty(Tc)
     initial = 1;
@@ -32,11 +34,23 @@ function [mn, cv, cr, PSRF, T, X, KStest] = processChain(smpl, Tc, dbg_info, plo
     initial = Tc(end)+1;
   end
   
-  chain = smpl(initial:end,4:size(smpl,2));
-  
-  % Get mean and covariance
-  mn = mean(chain);
-  cv = cov(chain);
+  if ischar(smpl) || iscell(smpl)
+    
+    % Chains on disk
+    [mn, cv, chain] = fileStatistics(cellstr(smpl), initial);
+    nparam = size(chain,2);
+    
+  else
+    
+    nparam = size(smpl,2)-3;
+    
+    chain = smpl(initial:end,4:size(smpl,2));
+    
+    % Get mean and covariance
+    mn = mean(chain);
+    cv = cov(chain);
+    
+  end
 
   % Calculate correlation of the parameters
   cr = utils.math.cov2corr(cv);
@@ -124,4 +138,60 @@ function [mn, cv, cr, PSRF, T, X, KStest] = processChain(smpl, Tc, dbg_info, plo
   
 end
 
+%--------------------------------------------------------------------------
+% Mean and covariance of the samples after the burn-in, read from the chain
+% files block by block. The samples are shifted by the first one to keep
+% the sums accurate. A thinned copy of the chain, of at most 1e5 samples,
+% is returned for the diagnostics.
+%--------------------------------------------------------------------------
+function [mn, cv, thinned] = fileStatistics(files, initial)
+
+  blockSize = 1e5;
+  maxThin   = 1e5;
+  
+  % Total number of samples
+  Ns = zeros(1, numel(files));
+  for ff = 1:numel(files)
+    [~, Ns(ff)] = MCMC.readChain(files{ff}, 1);
+  end
+  Ntot = sum(max(0, Ns - initial + 1));
+  step = max(1, ceil(Ntot/maxThin));
+  
+  n       = 0;
+  S1      = [];
+  S2      = [];
+  thinned = [];
+  for ff = 1:numel(files)
+    for first = initial:blockSize:Ns(ff)
+      rows = first:min(first+blockSize-1, Ns(ff));
+      x    = MCMC.readChain(files{ff}, rows);
+      x    = x(:, 4:end);
+      if isempty(S1)
+        shift = x(1,:);
+        S1    = zeros(1, size(x,2));
+        S2    = zeros(size(x,2));
+      end
+      x  = bsxfun(@minus, x, shift);
+      n  = n + size(x,1);
+      S1 = S1 + sum(x, 1);
+      S2 = S2 + x.'*x;
+      % keep every step-th sample, counted from the start of the chain
+      keep    = mod(rows - initial, step) == 0;
+      thinned = [thinned; bsxfun(@plus, x(keep,:), shift)]; %#ok<AGROW>
+    end
+  end
+  
+  % no samples after the burn-in
+  if n == 0
+    mn = [];
+    cv = [];
+    return
+  end
+  
+  mn = shift + S1/n;
+  cv = (S2 - S1.'*S1/n)/(n-1);
+  cv = (cv + cv.')/2;
+  
+end
+
 % END
\ No newline at end of file
@@ -0,0 +1,52 @@
+% READCHAIN: Read the samples of a chain written to disk by MCMC.mhsample
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Description: Read the samples of a chain written to disk when the
+%              'CHAIN FILE' key of MCMC.mhsample is set. The file is
+%              memory-mapped, so that only the requested samples are
+%              loaded.
+%
+%        CALL: [smpl, N] = MCMC.readChain(file)
+%              [smpl, N] = MCMC.readChain(file, rows)
+%              [smpl, N] = MCMC.readChain(file, rows, cols)
+%
+%      INPUTS: file - the name of the chain file
+%              rows - the samples to read (default: all)
+%              cols - the columns to read (default: all)
+%
+%     OUTPUTS: smpl - the samples, one per row
+%              N    - the total number of samples in the file
+%
+% NK 2015
+%
+function [smpl, N] = readChain(file, rows, cols)
+
+  % The file starts with the number of columns
+  fid = fopen(file, 'r');
+  if fid < 0
+    error('### Unable to open the chain file [%s].', file);
+  end
+  ncols = fread(fid, 1, 'double');
+  fclose(fid);
+  
+  info = dir(file);
+  N    = floor((info.bytes/8 - 1)/ncols);
+  
+  if nargin < 2 || isempty(rows)
+    rows = 1:N;
+  end
+  if nargin < 3 || isempty(cols)
+    cols = 1:ncols;
+  end
+  
+  if N == 0
+    smpl = zeros(0, numel(cols));
+    return
+  end
+  
+  m    = memmapfile(file, 'Offset', 8, 'Format', {'double', [ncols N], 'x'});
+  smpl = m.Data.x(cols, rows).';
+  
+end
+
+% END
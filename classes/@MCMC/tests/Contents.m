@@ -1,9 +1,16 @@
 %%%%%%%%%%%%%%%%%%%%   path: classes\@MCMC\tests   %%%%%%%%%%%%%%%%%%%%
 %
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_adaptCovariance">classes\@MCMC\tests\test_MCMC_adaptCovariance</a>     - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_calculateCovariance">classes\@MCMC\tests\test_MCMC_calculateCovariance</a> - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_convergence">classes\@MCMC\tests\test_MCMC_convergence</a>         - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_default_plist">classes\@MCMC\tests\test_MCMC_default_plist</a>       - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_evaluateProposals">classes\@MCMC\tests\test_MCMC_evaluateProposals</a>   - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_getInfo">classes\@MCMC\tests\test_MCMC_getInfo</a>             - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_gradientSamplers">classes\@MCMC\tests\test_MCMC_gradientSamplers</a>    - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_input_types">classes\@MCMC\tests\test_MCMC_input_types</a>         - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_loglikelihoodGradient">classes\@MCMC\tests\test_MCMC_loglikelihoodGradient</a> - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_loglikelihoods">classes\@MCMC\tests\test_MCMC_loglikelihoods</a>      - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_multichain">classes\@MCMC\tests\test_MCMC_multichain</a>          - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_preprocessCache">classes\@MCMC\tests\test_MCMC_preprocessCache</a>     - (No help available)
+%   <a href="matlab:help classes\@MCMC\tests\test_MCMC_proposalBlock">classes\@MCMC\tests\test_MCMC_proposalBlock</a>       - (No help available)
 %   <a href="matlab:help classes\@MCMC\tests\test_MCMC_simplex">classes\@MCMC\tests\test_MCMC_simplex</a>             - (No help available)
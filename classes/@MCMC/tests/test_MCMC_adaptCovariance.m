@@ -0,0 +1,34 @@
+%
+% Tests the running statistics of the adaptive proposal: the mean and the
+% covariance updated sample by sample must equal the ones of the whole
+% set of samples.
+%
+function test_MCMC_adaptCovariance(~)
+  
+  result  = true;
+  message = 'Pass';
+  
+  Nsamples = 500;
+  X = bsxfun(@plus, randn(Nsamples, 3)*[1 0.5 0; 0 1 0.2; 0 0 2], [10 -3 0.1]);
+  
+  ad = MCMC.adaptCovariance([], size(X,2));
+  for kk = 1:Nsamples
+    ad = MCMC.adaptCovariance(ad, X(kk,:));
+  end
+  
+  cv = ad.R.'*ad.R/(ad.n - 1);
+  
+  if ad.n ~= Nsamples
+    result  = false;
+    message = 'The number of samples of the statistics is wrong.';
+  elseif any(abs(ad.mean - mean(X)) > 1e-12*max(abs(mean(X))))
+    result  = false;
+    message = 'The running mean differs from the mean of the samples.';
+  elseif any(any(abs(cv - cov(X)) > 1e-10*max(abs(diag(cov(X))))))
+    result  = false;
+    message = 'The running covariance differs from the covariance of the samples.';
+  end
+  
+  assert(result, message)
+  
+end
@@ -7,7 +7,7 @@ function test_MCMC_default_plist(~)
   pl     = MCMC.getDefaultPlist;
   
   % Total # of parameters
-  if numel(pl.params) ~= 72; result  = false; end
+  if numel(pl.params) ~= 83; result  = false; end
   
   % Check main plist inputs
   if ~pl.isparam('Nsamples'),    result = false; end
@@ -0,0 +1,59 @@
+%
+% Tests the evaluation of a block of proposals: the points out of the
+% bounds must be skipped, and the values inside must match the ones of
+% single evaluations, with and without vectorised functions.
+%
+function test_MCMC_evaluateProposals(~)
+  
+  result  = true;
+  message = 'Pass';
+  
+  loglk  = @(x) deal(-sum(x.^2), 2*x(1), [-x(1)^2 -x(2)^2]);
+  prior  = @(x) -abs(x(:,1));
+  bounds = [-1 -1; 1 1];
+  
+  X = [0.1 0.2; 2 0; -0.5 0.9; 0 -3];
+  
+  [L, snr, p, inside, Lexp] = MCMC.evaluateProposals(X, loglk, prior, bounds);
+  p0 = p;
+  
+  if ~isequal(inside, [true; false; true; false])
+    result  = false;
+    message = 'The bounds of the proposals are wrong.';
+  end
+  
+  for kk = find(inside).'
+    [l, s, le] = loglk(X(kk,:));
+    if L(kk) ~= l || snr(kk) ~= s || ~isequal(Lexp{kk}, le) || p(kk) ~= prior(X(kk,:))
+      result  = false;
+      message = 'The values of the block differ from single evaluations.';
+    end
+  end
+  
+  if any(L(~inside) ~= -inf)
+    result  = false;
+    message = 'The proposals out of bounds must have a -inf log-likelihood.';
+  end
+  
+  % A row-wise prior gives one value per column on a block, which must not
+  % be taken for the values of the proposals (2 inside, 2 parameters)
+  priorSum = @(x) sum(-x.^2);
+  [~, ~, p] = MCMC.evaluateProposals(X, loglk, priorSum, bounds);
+  for kk = find(inside).'
+    if p(kk) ~= priorSum(X(kk,:))
+      result  = false;
+      message = 'The prior of the block differs from single evaluations.';
+    end
+  end
+  
+  % Vectorised functions are called once on the block, with the same values
+  loglkv = @(x) deal(-sum(x.^2, 2), 2*x(:,1), [-x(:,1).^2 -x(:,2).^2]);
+  [Lv, snrv, pv, ~, Lexpv] = MCMC.evaluateProposals(X, loglkv, prior, bounds, true, true);
+  if ~isequal(Lv, L) || ~isequal(snrv(inside), snr(inside)) || ~isequal(pv, p0) || ~isequal(Lexpv, Lexp)
+    result  = false;
+    message = 'The vectorised evaluation differs from single evaluations.';
+  end
+  
+  assert(result, message)
+  
+end
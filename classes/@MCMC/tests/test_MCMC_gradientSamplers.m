@@ -0,0 +1,72 @@
+%
+% Tests that MCMC.process runs the HMC and NUTS samplers on the
+% built-in log-likelihood of ssm models: each short chain must have
+% the requested length, finite samples and accepted moves.
+%
+% Using a simple harmonic oscillator model
+%
+function test_MCMC_gradientSamplers(~)
+
+  result      = true;
+  message     = 'Pass';
+  samplers    = {'HMC', 'NUTS'};
+  Nsamples    = 40;
+
+  pl = plist(...
+    'Nsamples',  Nsamples,...
+    'FitParams', {'DAMP','K'},...
+    'range',     {[-3 3] [-3 3]},...
+    'f1',        1e-4,...
+    'f2',        0.5,...
+    'inNames',   {'COMMAND.force'},...
+    'outNames',  {'HARMONIC_OSC_1D.position'},...
+    'Navs',      5,...
+    'cov',       [1.74203263643076e-07 -2.02332484875624e-22 ; -2.02332484875624e-22 1.66273793345002e-08],...
+    'search',    false,...
+    'Tc',        [1 2],...
+    'heat',      2,...
+    'Fprint',    1500,...
+    'jumps',     [2e0 1e1 5e2 1e3],...
+    'x0',        [0.1 0.1],...
+    'simplex',   false,...
+    'leapfrog steps',    5,...
+    'debug',             false,...
+    'print diagnostics', false);
+
+  for kk = 1:numel(samplers)
+
+    m = MCMC(pl.pset('sampler', samplers{kk}));
+
+    m.setModel(ssm('harmonic_osc.mat'));
+    m.setInputs(ao('in.mat'));
+    m.setNoise(ao('noise.mat'));
+
+    try
+      p     = m.process(ao('out.mat'));
+      chain = p.chain;
+    catch err
+      result  = false;
+      message = sprintf('Failed to run algorithm.process with the %s sampler... Error: %s', samplers{kk}, err.message);
+      break
+    end
+
+    x = chain(:, end-1:end);
+    if ~isequal(size(chain, 1), Nsamples)
+      result  = false;
+      message = sprintf('The chain of the %s sampler has the wrong length.', samplers{kk});
+    elseif ~all(isfinite(x(:)))
+      result  = false;
+      message = sprintf('The chain of the %s sampler has non-finite samples.', samplers{kk});
+    elseif size(unique(x, 'rows'), 1) < 2
+      result  = false;
+      message = sprintf('The %s sampler did not accept any move.', samplers{kk});
+    end
+    if ~result
+      break
+    end
+
+  end
+
+  assert(result, message)
+
+end
@@ -0,0 +1,92 @@
+%
+% Tests the gradient of the log-likelihood of ssm models used by the HMC
+% and NUTS samplers against finite differences of the log-likelihood, and
+% the log-likelihood of a block of points against single evaluations.
+%
+function test_MCMC_loglikelihoodGradient(~)
+  
+  result  = true;
+  message = 'Pass';
+  
+  params = {'DAMP','K'};
+  values = [0.1, 0.1];
+  
+  mod = ssm(plist('built-in','HARMONIC_OSC_1D',...
+    'Version','Fitting',...
+    'Continuous',1,...
+    'SYMBOLIC PARAMS',params));
+  
+  mod.setParameters(plist('names',params,'values',values));
+  
+  in    = ao(plist('waveform','sine wave','fs',10,'nsecs',300,'f',0.2));
+  noise = ao(plist('waveform','noise','fs',10,'nsecs',in.nsecs,'sigma',0.1));
+  
+  sim = mod.keepParameters;
+  sim.modifyTimeStep(0.1);
+  
+  mout = sim.simulate(plist('AOS', [in noise], ...
+                            'AOS VARIABLE NAMES', {'COMMAND.force' 'NOISE.readout'}, ...
+                            'return outputs',  {'HARMONIC_OSC_1D.position'}));
+  
+  t0 = time('2012-01-17 17:04:11.529 UTC');
+  
+  in.setT0(t0);
+  noise.setT0(t0);
+  mout.objs(1).setT0(t0);
+  
+  out    = mout.getObjectAtIndex(1,1);
+  fin    = fft(in);
+  fout   = fft(out);
+  fnoise = psd(noise);
+  freqs  = fin.x;
+  
+  data = MCMC.ao2strucArrays(plist('in',fin, 'out', fout, 'S',fnoise,'Nexp',1));
+  spl  = plist('reorganize', false, 'f', freqs, ...
+               'inputs',{'COMMAND.force'},'outputs',{'HARMONIC_OSC_1D.position'});
+  
+  x  = [0.12 0.09];
+  lp = [0 1];
+  x(2) = log(x(2));
+  
+  try
+    [L, g] = loglikelihoodGradient(mod, x, data, params, lp, spl);
+    
+    for kk = 1:numel(x)
+      h      = 1e-5;
+      xh     = x;
+      xh(kk) = x(kk) + h;
+      Lu     = loglikelihoodGradient(mod, xh, data, params, lp, spl);
+      xh(kk) = x(kk) - h;
+      Ld     = loglikelihoodGradient(mod, xh, data, params, lp, spl);
+      gfd    = (Lu - Ld)/(2*h);
+      if abs(g(kk) - gfd) > 1e-3*max(abs(gfd), 1)
+        result  = false;
+        message = sprintf('The gradient of parameter %s differs from the finite differences: %g ~= %g', params{kk}, g(kk), gfd);
+      end
+    end
+    
+    if ~isfinite(L)
+      result  = false;
+      message = 'The log-likelihood is not finite.';
+    end
+    
+    % The log-likelihood of a block of points, as evaluated for a block of
+    % proposals, is the one of each point
+    X  = [x; x + [0.01 -0.02]];
+    Lb = loglikelihood_core(mod, X, data, params, lp, spl);
+    for kk = 1:size(X,1)
+      Lk = loglikelihood_core(mod, X(kk,:), data, params, lp, spl);
+      if numel(Lb) ~= size(X,1) || abs(Lb(kk) - Lk) > 1e-10*abs(Lk)
+        result  = false;
+        message = 'The log-likelihood of a block of points differs from the single evaluations.';
+      end
+    end
+    
+  catch err
+    result  = false;
+    message = sprintf('Failed to compute the gradient of the log-likelihood... Error: %s', err.message);
+  end
+  
+  assert(result, message)
+  
+end
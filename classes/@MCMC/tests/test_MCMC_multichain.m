@@ -0,0 +1,64 @@
+%
+% Tests the multi-chain mode of the sampler: the chains must
+% agree with each other (R-hat) and be returned in the pest.
+%
+% Using a simple harmonic oscillator model
+%
+function test_MCMC_multichain(~)
+  
+  result      = true;
+  message     = 'Pass';
+  Nchains     = 3;
+  Nsamples    = 1200;
+  
+  pl = plist(...
+    'Nsamples',  Nsamples,...
+    'Nchains',   Nchains,...
+    'FitParams', {'DAMP','K'},...
+    'range',     {[-3 3] [-3 3]},...
+    'f1',        1e-4,...
+    'f2',        0.5,...
+    'inNames',   {'COMMAND.force'},...
+    'outNames',  {'HARMONIC_OSC_1D.position'},...
+    'Navs',      5,...
+    'cov',       [1.74203263643076e-07 -2.02332484875624e-22 ; -2.02332484875624e-22 1.66273793345002e-08],...
+    'search',    true,...
+    'Tc',        [1 2],...
+    'heat',      2,...
+    'Fprint',    300,...
+    'jumps',     [2e0 1e1 5e2 1e3],...
+    'x0',        [0.1 0.1],...
+    'simplex',   false,...
+    'debug',             false,...
+    'print diagnostics', false);
+  
+  m = MCMC(pl);
+  
+  % Do a run
+  m.setModel(ssm('harmonic_osc.mat'));
+  m.setInputs(ao('in.mat'));
+  m.setNoise(ao('noise.mat'));
+  
+  try
+    p      = m.process(ao('out.mat'));
+    chains = find(p.procinfo,'chains');
+    Rhat   = find(p.procinfo,'Rhat');
+  catch err
+    result  = false;
+    message = sprintf(['Failed to run algorithm.process... ' ...
+               'Error: %s'], err.message);
+  end
+  
+  if result
+    if ~isequal(size(chains, 1), Nsamples) || ~isequal(size(chains, 3), Nchains)
+      result  = false;
+      message = 'The chains stored in the procinfo have the wrong size.';
+    elseif any(isnan(Rhat)) || any(Rhat > 1.2)
+      result  = false;
+      message = 'The chains have not converged to the same distribution.';
+    end
+  end
+  
+  assert(result, message)
+
+end
@@ -0,0 +1,100 @@
+%
+% Tests the cache of the preprocessed data: later runs on the same data
+% must use the cached frequency domain objects, from the files or from
+% memory as reported by MCMC.preprocessCache('stats'), and leave the data
+% given by the caller unchanged.
+%
+% Using a simple harmonic oscillator model
+%
+function test_MCMC_preprocessCache(~)
+  
+  result   = true;
+  message  = 'Pass';
+  cacheDir = tempname;
+  
+  pl = plist(...
+    'Nsamples',  200,...
+    'FitParams', {'DAMP','K'},...
+    'range',     {[-3 3] [-3 3]},...
+    'f1',        1e-4,...
+    'f2',        0.5,...
+    'inNames',   {'COMMAND.force'},...
+    'outNames',  {'HARMONIC_OSC_1D.position'},...
+    'Navs',      5,...
+    'cov',       [1.74203263643076e-07 -2.02332484875624e-22 ; -2.02332484875624e-22 1.66273793345002e-08],...
+    'search',    false,...
+    'Tc',        [1 2],...
+    'Fprint',    1500,...
+    'x0',        [0.1 0.1],...
+    'simplex',   false,...
+    'debug',             false,...
+    'print diagnostics', false,...
+    'preprocess cache dir', cacheDir);
+  
+  mdl   = ssm('harmonic_osc.mat');
+  in    = ao('in.mat');
+  noise = ao('noise.mat');
+  out   = ao('out.mat');
+  
+  objs  = [in noise out];
+  uuids = {objs.UUID};
+  ys    = {objs.y};
+  
+  MCMC.preprocessCache('clear');
+  
+  try
+    
+    % First run, fills the cache
+    runMCMC(pl, mdl, in, noise, out);
+    stats1 = MCMC.preprocessCache('stats');
+    files  = dir(fullfile(cacheDir, 'mcmc_preprocess_*.mat'));
+    
+    % Second run on the same data, from the files only
+    MCMC.preprocessCache('clear');
+    runMCMC(pl, mdl, in, noise, out);
+    stats2 = MCMC.preprocessCache('stats');
+    
+    % Third run on the same data, from memory
+    runMCMC(pl, mdl, in, noise, out);
+    stats3 = MCMC.preprocessCache('stats');
+    
+  catch err
+    result  = false;
+    message = sprintf(['Failed to run algorithm.process... ' ...
+               'Error: %s'], err.message);
+  end
+  
+  if result
+    if numel(files) ~= 1 || stats1.stores ~= 1 || stats1.memoryHits + stats1.fileHits ~= 0
+      result  = false;
+      message = 'The first run did not store the preprocessed data.';
+    elseif stats2.fileHits ~= 1 || stats2.stores ~= 0
+      result  = false;
+      message = 'The second run did not use the cached preprocessed data of the files.';
+    elseif stats3.memoryHits ~= 1 || stats3.stores ~= 0
+      result  = false;
+      message = 'The third run did not use the cached preprocessed data in memory.';
+    elseif ~isequal({objs.UUID}, uuids) || ~isequal({objs.y}, ys)
+      result  = false;
+      message = 'The preprocessing changed the data of the caller.';
+    end
+  end
+  
+  MCMC.preprocessCache('clear');
+  if exist(cacheDir, 'dir') == 7
+    rmdir(cacheDir, 's');
+  end
+  
+  assert(result, message)
+
+end
+
+function runMCMC(pl, mdl, in, noise, out)
+  
+  m = MCMC(pl);
+  m.setModel(mdl);
+  m.setInputs(in);
+  m.setNoise(noise);
+  m.process(out);
+  
+end
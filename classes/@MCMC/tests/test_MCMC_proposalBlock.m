@@ -0,0 +1,49 @@
+%
+% Tests a block of proposals with the likelihood itself (LOGA false) and
+% a bounded parameter: the candidates out of the bounds must be discarded
+% and the chain must keep moving inside the bounds.
+%
+function test_MCMC_proposalBlock(~)
+  
+  result  = true;
+  message = 'Pass';
+  
+  Nsamples = 500;
+  
+  pl = plist(...
+    'Nsamples',          Nsamples,...
+    'FitParams',         {'a','b'},...
+    'x0',                [0.5 0],...
+    'range',             {[0 3] [-3 3]},...
+    'cov',               0.5*eye(2),...
+    'loglikelihood',     @(x) exp(-sum(x.^2)/2),...
+    'loga',              false,...
+    'proposal block',    4,...
+    'search',            false,...
+    'Tc',                [1 2],...
+    'Fprint',            100,...
+    'print diagnostics', false);
+  
+  try
+    p     = MCMC.mhsample(pl);
+    chain = p.chain;
+  catch err
+    result  = false;
+    message = sprintf(['Failed to run mhsample... ' ...
+               'Error: %s'], err.message);
+  end
+  
+  if result
+    a = chain(:,4);
+    if any(~isfinite(a)) || any(a < 0) || any(a > 3)
+      result  = false;
+      message = 'The chain has left the bounds of the parameters.';
+    elseif numel(unique(a)) < 2
+      result  = false;
+      message = 'The chain has not accepted any proposal.';
+    end
+  end
+  
+  assert(result, message)
+
+end
@@ -9,7 +9,11 @@
 % Time-series can be delayed either by an integer numbers of samples, or a
 % time, depending on the method chosen. For delaying by an explicit time,
 % you can use the fft filtering method, or a fractional delay filtering
-% method.
+% method. The fractional delay filtering method also accepts a delay which
+% changes with time, given as a vector with a value per sample. In that
+% method, the samples delayed by a whole number of samples from outside the
+% time-series are zeros, and the filters of fractional delays take the mean
+% of the time-series outside it.
 %
 % <a href="matlab:utils.helper.displayMethodInfo('ao', 'delay')">Parameters Description</a>
 %
@@ -97,9 +101,12 @@ function varargout = delay(varargin)
   bs = copy(as, nargout);
   
   % try to make uniform parameters here
-  if ~isempty(N) && tau == 0
+  if ~isempty(N) && isequal(tau, 0)
     tau = N;
   end
+  if numel(tau) > 1 && ~strcmpi(mode, 'fdfilter')
+    error('### Time-varying delays are only supported in the ''fdfilter'' mode.');
+  end
   
   % Loop over AOs
   for jj=1:numel(bs)
@@ -107,7 +114,7 @@ function varargout = delay(varargin)
       warning('!!! Skipping object %s - it contains no tsdata.', ao_invars{jj});
     else
       
-      if tau ~= 0
+      if any(tau(:) ~= 0)
         
         switch lower(mode)
           case 'sample'
@@ -134,7 +141,15 @@ function varargout = delay(varargin)
             wind = lower(pl.find_core('window'));
             taps = lower(pl.find_core('taps'));
             D = double(tau*bs(jj).data.fs);
-            vals = utils.math.fdfilt_delay_core(bs(jj).y,D,taps,wind);
+            if isscalar(D)
+              vals = utils.math.fdfilt_delay_core(bs(jj).y,D,taps,wind);
+            else
+              % time-varying delay, a value per sample
+              if numel(D) ~= bs(jj).len
+                error('### The time-varying delay must have a value per sample.');
+              end
+              vals = utils.math.fdelay(bs(jj).y, D(:), utils.math.fdkernel(taps, wind));
+            end
             bs(jj).data.setY(vals);
             
           otherwise
@@ -195,7 +210,8 @@ function pl = buildplist()
   pl.append(p);
   
   % tau
-  p = param({'tau', 'The delay time (s) for use in the ''fftfilter'', ''timedomain'', and ''fdfilter'' delay modes.'}, paramValue.DOUBLE_VALUE(0));
+  p = param({'tau', ['The delay time (s) for use in the ''fftfilter'', ''timedomain'', and ''fdfilter'' delay modes. ' ...
+    'In the ''fdfilter'' mode, it can be a vector with the delay of each sample.']}, paramValue.DOUBLE_VALUE(0));
   pl.append(p);
   
   % N
@@ -103,6 +103,13 @@ function varargout = fftfilt(varargin)
   
   % get number of Bins for zero padding
   Npad = find_core(pl,'Npad');
+  % get the block size of the overlap-save filter
+  Nblock = find_core(pl,'block size');
+  
+  fc     = [];
+  gain   = [];
+  iunits = [];
+  ounits = [];
   
   switch lower(cset)
     case 'custom filter'
@@ -166,17 +173,17 @@ function varargout = fftfilt(varargin)
             error('### The filter smodel must have xvar = ''s'' or ''f''');
         end
         % call core method of the fftfilt
-        bs(ii).fftfilt_core(filt, Npad, inCondsMdl(ii));  
+        bs(ii).fftfilt_core(filt, Npad, inCondsMdl(ii), fc, gain, iunits, ounits, Nblock);
         
       case 'char'
         
         % call core method of the fftfilt
-        bs(ii).fftfilt_core(filt, Npad, [], fc, gain, iunits, ounits);
+        bs(ii).fftfilt_core(filt, Npad, [], fc, gain, iunits, ounits, Nblock);
         
       otherwise
         
         % call core method of the fftfilt
-        bs(ii).fftfilt_core(filt, Npad, inCondsMdl(ii));
+        bs(ii).fftfilt_core(filt, Npad, inCondsMdl(ii), fc, gain, iunits, ounits, Nblock);
         
     end  
     
@@ -276,6 +283,13 @@ function pl = buildplist(set)
   p = param({'Npad', 'Number of bins for zero padding.'}, paramValue.EMPTY_DOUBLE);
   pl.append(p);
   
+  % Block size
+  p = param({'block size', ['The number of samples of the FFT blocks of an overlap-save filter. ' ...
+    'If empty, the whole series is zero-padded and filtered with a single FFT. The impulse ' ...
+    'response of the filter must be shorter than half a block. Not used with AO filters and ' ...
+    'initial conditions, whose responses are given on the frequencies of the data.']}, paramValue.EMPTY_DOUBLE);
+  pl.append(p);
+  
   
   switch lower(set)
     case 'custom filter'
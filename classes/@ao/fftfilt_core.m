@@ -4,9 +4,20 @@
 % DESCRIPTION: Simple core method which computes the fft filter.
 %
 % CALL:        ao = fftfilt_core(ao, filt, Npad)
+%              ao = fftfilt_core(ao, filt, Npad, inConds, fc, gain, iunits, ounits, Nblock)
 %
-% INPUTS:      ao:   Single input analysis object
+% INPUTS:      ao:   Single input analysis object, or time-series of the
+%                    same length and sample rate which are filtered
+%                    together, as the columns of a matrix, with a single
+%                    evaluation of the response. No initial conditions are
+%                    used for several objects.
 %              Npad: Number of bins for zero padding
+%              Nblock: Block size of the overlap-save filter. If given, the
+%                    data are filtered in blocks of Nblock samples with the
+%                    response on the grid of one block, instead of with
+%                    the FFT of the whole zero-padded series. Not used
+%                    for AO filters and smodels with initial conditions,
+%                    whose responses are given on the grid of the data.
 %              filt: The filter to apply to the data
 %                      smodel - a model to filter with.
 %                      mfir   - an FIR filter
@@ -20,27 +31,97 @@
 
 function bs = fftfilt_core(varargin)
   
+  persistent cache
+  
   bs    =   varargin{1};
   filt  =   varargin{2};
   Npad  =   varargin{3};
   
   inCondsMdl = [];
+  fc     = [];
+  gain   = [];
+  iunits = [];
+  ounits = [];
+  Nblock = [];
   
   if nargin == 4
     inCondsMdl = varargin{4};
   elseif nargin > 4
+    inCondsMdl = varargin{4};
     fc = varargin{5};
     gain = varargin{6};
     iunits = varargin{7};
     ounits = varargin{8};
   end
+  if nargin > 8
+    Nblock = varargin{9};
+  end
+  
+  [m, n] = size(bs(1).data.y);
+  fs     = bs(1).data.fs;
+  
+  if ~isempty(Nblock) && ~isa(filt, 'ao') && ...
+      ~(isa(filt, 'collection') && any(cellfun(@(o) isa(o, 'ao'), filt.objs))) && ...
+      ~(isa(filt, 'smodel') && ~isempty(inCondsMdl) && ~isempty(inCondsMdl.expr.s))
+    %------------------------ Overlap-save on blocks -------------------------
+    % The response is only evaluated on the grid of one block, and kept
+    % for the next objects filtered with the same filter.
+    Nfft = 2*ceil(Nblock/2);
+    key  = {filterKey(filt, fc, gain, iunits, ounits), fs, Nfft};
+    if isempty(cache) || ~isequal(cache.key, key)
+      fb    = (0:Nfft/2).'*fs/Nfft;
+      fgrid = ao(fsdata(fb, zeros(size(fb)), fs));
+      [amdl, ufac] = filterResponse(filt, fgrid, fs, fc, gain, iunits, ounits);
+      cache.key    = key;
+      cache.kernel = utils.math.olskernel(amdl.data.y);
+      cache.ufac   = ufac;
+    end
+    kernel = cache.kernel;
+    
+    % the acausal taps delay the output
+    for kk = 1:numel(bs)
+      y = utils.math.olsfilt([bs(kk).data.y(:); zeros(kernel.Ka, 1)], kernel);
+      bs(kk).data.setY(reshape(y(kernel.Ka+1:end), m, n));
+      bs(kk).setYunits(simplify(bs(kk).data.yunits .* cache.ufac));
+      
+      % clear errors
+      bs(kk).clearErrors;
+    end
+    return
+  end
   
-  [m, n] = size(bs.data.y);
   % FFT time-series data
-  fs   = bs.data.fs;
   % zero padding data before fft
   if isempty(Npad)
-    Npad = length(bs.data.y) - 1;
+    Npad = length(bs(1).data.y) - 1;
+  end
+  
+  if numel(bs) > 1
+    %---------------------- Several objects together ------------------------
+    % The response on the frequencies of the one-sided FFT of the padded
+    % data, applied to the FFTs of all the columns
+    Nfft = m*n + Npad;
+    fb   = utils.math.getfftfreq(Nfft, fs, 'one').';
+    Nf   = numel(fb);
+    [amdl, ufac] = filterResponse(filt, ao(fsdata(fb, zeros(Nf, 1), fs)), fs, fc, gain, iunits, ounits);
+    
+    X = zeros(Nfft, numel(bs));
+    for kk = 1:numel(bs)
+      X(1:m*n, kk) = bs(kk).data.y(:);
+    end
+    X = fft(X);
+    X(1:Nf, :) = bsxfun(@times, X(1:Nf, :), reshape(amdl.data.y, Nf, 1));
+    X(Nf+1:end, :) = conj(X(Nfft+1-Nf:-1:2, :));
+    Y = ifft(X, 'symmetric');
+    
+    for kk = 1:numel(bs)
+      bs(kk).setYunits(simplify(bs(kk).data.yunits .* ufac));
+      bs(kk).data.setY(reshape(Y(1:m*n, kk), m, n));
+      
+      % clear errors
+      bs(kk).clearErrors;
+    end
+    return
   end
   if n == 1
     tdat = ao(tsdata([bs.data.y;zeros(Npad,1)], fs));
@@ -50,146 +131,10 @@ function bs = fftfilt_core(varargin)
   % get onesided fft
   ft = fft_core(tdat, 'one');
   
-  switch class(filt)
-    case 'smodel'
-      % Evaluate model at the given frequencies
-      
-      amdly = filt.setXvals(ft.data.x).double;
-      amdly = reshape(amdly, size(ft.data.y));
-      
-      amdl = ao(fsdata(ft.data.x, amdly, fs));
-      
-      % set units
-      bs.setYunits(simplify(bs.data.yunits .* filt.yunits));
-      
-    case {'miir', 'mfir', 'pzmodel', 'parfrac', 'rational'}
-      
-      % Check if the frequency of the filter is the same as the frequency
-      % of the AO.
-      if isa (filt, 'ltpda_filter') && fs ~= filt.fs
-        error('### Please use a filter with the same frequency as the AO [%dHz]', fs);
-      end
-      
-      % get filter response on given frequencies
-      amdl = resp(filt, plist('f', ft.data.x));
-      
-      % set units
-      bs.data.setYunits(simplify(bs.data.yunits .* filt.ounits ./ filt.iunits));
-      
-    case 'filterbank'
-      % get filter response on given frequencies
-      amdly = utils.math.mtxiirresp(filt.filters,ft.data.x,fs,filt.type);
-      amdl = ao(fsdata(ft.data.x, amdly, fs));
-      % handle units
-      switch lower(filt.type)
-        case 'parallel'
-          % set units of the output object
-          bs.setYunits(simplify(bs.data.yunits .* filt.filters(1).ounits ./ filt.filters(1).iunits));
-        case 'series'
-          % get units from the series
-          sunits = filt.filters(1).ounits ./ filt.filters(1).iunits;
-          for jj = 2:numel(filt.filters)
-            sunits = sunits.*filt.filters(jj).ounits ./ filt.filters(jj).iunits;
-          end
-          % set units of the output object
-          bs.setYunits(simplify(bs.data.yunits .* sunits));
-      end
-      
-    case 'ao'
-      
-      % check if filter and data have the same shape
-      if size(ft.data.y)~=size(filt.data.y)
-        % reshape
-        amdl = copy(filt,1);
-        amdl.setX(ft.data.x);
-        amdl.setY(reshape(filt.data.y,size(ft.data.x)));
-        amdl.setName(filt.name);
-      else
-        amdl = copy(filt,1);
-        amdl.setName(filt.name);
-      end
-      
-      % set units
-      bs.setYunits(simplify(bs.data.yunits .* amdl.data.yunits));
-      
-    case 'char'
-      
-      amdl = copy(ft,1);
-      amdl.setX(ft.data.x);
-      
-      msk = getMask(ft.data.x,filt,fc,gain);
-      
-      amdl.setY(reshape(msk,size(ft.data.x)));
-      amdl.setName(filt);
-      
-      % set units
-      bs.setYunits(simplify(bs.data.yunits .* unit(ounits) ./ unit(iunits)));
-      
-      
-    case 'collection'
-      
-      % run over collection elements
-      amdl = ao(fsdata(ft.data.x, ones(size(ft.data.x)), fs));
-      for ii=1:numel(filt.objs)
-        switch class(filt.objs{ii})
-          case 'smodel'
-            % Evaluate model at the given frequencies
-            amdly = filt.objs{ii}.setXvals(ft.data.x).double;
-            amdly = reshape(amdly, size(ft.data.y));
-            amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
-            % set units
-            bs.setYunits(simplify(bs.data.yunits .* filt.objs{ii}.yunits));
-
-          case {'miir'}
-            % get filter response on given frequencies
-            amdly = utils.math.mtxiirresp(filt.objs{ii},ft.data.x,fs,[]);
-            amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
-            % set units
-            bs.setYunits(simplify(bs.data.yunits .* filt.objs{ii}.ounits ./ filt.objs{ii}.iunits));
-            
-          case 'ao'
-            % check if filter and data have the same shape
-            if size(ft.data.y)~=size(filt.objs{ii}.data.y)
-              % reshape
-              amdl_temp = copy(filt.objs{ii},1);
-              amdl_temp.setX(ft.data.x);
-              amdl_temp.setY(reshape(filt.objs{ii}.data.y,size(ft.data.x)));
-              amdl_temp.setName(filt.objs{ii}.name);
-            else
-              amdl_temp = copy(filt.objs{ii},1);
-              amdl_temp.setName(filt.objs{ii}.name);
-            end
-            % set units
-            bs.setYunits(simplify(bs.data.yunits .* amdl_temp.data.yunits));
-            
-          case 'filterbank'
-            % get filter response on given frequencies
-            amdly = utils.math.mtxiirresp(filt.objs{ii}.filters,ft.data.x,fs,filt.objs{ii}.type);
-            amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
-            % handle units
-            switch lower(filt.objs{ii}.type)
-              case 'parallel'
-                % set units of the output object
-                bs.setYunits(simplify(bs.data.yunits .* filt.objs{ii}.filters(1).ounits ./ filt.objs{ii}.filters(1).iunits));
-              case 'series'
-                % get units from the series
-                sunits = filt.objs{ii}.filters(1).ounits ./ filt.objs{ii}.filters(1).iunits;
-                for jj = 2:numel(filt.objs{ii}.filters)
-                  sunits = sunits.*filt.objs{ii}.filters(jj).ounits ./ filt.objs{ii}.filters(jj).iunits;
-                end
-                % set units of the output object
-                bs.setYunits(simplify(bs.data.yunits .* sunits));
-            end
-        end
-        % update response
-        amdl = amdl .* amdl_temp;
-      end
-      
-    otherwise
-      
-      error('### Unknown filter mode.');
-      
-  end
+  [amdl, ufac] = filterResponse(filt, ft, fs, fc, gain, iunits, ounits);
+  
+  % set units
+  bs.setYunits(simplify(bs.data.yunits .* ufac));
   
   % Add initial conditions
   if isa(filt, 'smodel') && ~isempty(inCondsMdl) && ~isempty(inCondsMdl.expr.s)
@@ -221,6 +166,169 @@ end
   % Loacal functions
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
   
+  %--------------------------------------------------------------------------
+  % Response of the filter on the frequencies of the fsdata AO ft, and the
+  % factor which multiplies the units of the data
+  %--------------------------------------------------------------------------
+  function [amdl, ufac] = filterResponse(filt, ft, fs, fc, gain, iunits, ounits)
+    
+    switch class(filt)
+      case 'smodel'
+        % Evaluate model at the given frequencies
+      
+        amdly = filt.setXvals(ft.data.x).double;
+        amdly = reshape(amdly, size(ft.data.y));
+      
+        amdl = ao(fsdata(ft.data.x, amdly, fs));
+      
+        % set units
+        ufac = filt.yunits;
+      
+      case {'miir', 'mfir', 'pzmodel', 'parfrac', 'rational'}
+      
+        % Check if the frequency of the filter is the same as the frequency
+        % of the AO.
+        if isa (filt, 'ltpda_filter') && fs ~= filt.fs
+          error('### Please use a filter with the same frequency as the AO [%dHz]', fs);
+        end
+      
+        % get filter response on given frequencies
+        amdl = resp(filt, plist('f', ft.data.x));
+      
+        % set units
+        ufac = filt.ounits ./ filt.iunits;
+      
+      case 'filterbank'
+        % get filter response on given frequencies
+        amdly = utils.math.mtxiirresp(filt.filters,ft.data.x,fs,filt.type);
+        amdl = ao(fsdata(ft.data.x, amdly, fs));
+        % handle units
+        switch lower(filt.type)
+          case 'parallel'
+            % set units of the output object
+            ufac = filt.filters(1).ounits ./ filt.filters(1).iunits;
+          case 'series'
+            % get units from the series
+            sunits = filt.filters(1).ounits ./ filt.filters(1).iunits;
+            for jj = 2:numel(filt.filters)
+              sunits = sunits.*filt.filters(jj).ounits ./ filt.filters(jj).iunits;
+            end
+            % set units of the output object
+            ufac = sunits;
+        end
+      
+      case 'ao'
+      
+        % check if filter and data have the same shape
+        if size(ft.data.y)~=size(filt.data.y)
+          % reshape
+          amdl = copy(filt,1);
+          amdl.setX(ft.data.x);
+          amdl.setY(reshape(filt.data.y,size(ft.data.x)));
+          amdl.setName(filt.name);
+        else
+          amdl = copy(filt,1);
+          amdl.setName(filt.name);
+        end
+      
+        % set units
+        ufac = amdl.data.yunits;
+      
+      case 'char'
+      
+        amdl = copy(ft,1);
+        amdl.setX(ft.data.x);
+      
+        msk = getMask(ft.data.x,filt,fc,gain);
+      
+        amdl.setY(reshape(msk,size(ft.data.x)));
+        amdl.setName(filt);
+      
+        % set units
+        ufac = unit(ounits) ./ unit(iunits);
+      
+      
+      case 'collection'
+      
+        % run over collection elements
+        amdl = ao(fsdata(ft.data.x, ones(size(ft.data.x)), fs));
+        ufac = unit();
+        for ii=1:numel(filt.objs)
+          switch class(filt.objs{ii})
+            case 'smodel'
+              % Evaluate model at the given frequencies
+              amdly = filt.objs{ii}.setXvals(ft.data.x).double;
+              amdly = reshape(amdly, size(ft.data.y));
+              amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
+              % set units
+              ufac = ufac .* filt.objs{ii}.yunits;
+
+            case {'miir'}
+              % get filter response on given frequencies
+              amdly = utils.math.mtxiirresp(filt.objs{ii},ft.data.x,fs,[]);
+              amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
+              % set units
+              ufac = ufac .* filt.objs{ii}.ounits ./ filt.objs{ii}.iunits;
+            
+            case 'ao'
+              % check if filter and data have the same shape
+              if size(ft.data.y)~=size(filt.objs{ii}.data.y)
+                % reshape
+                amdl_temp = copy(filt.objs{ii},1);
+                amdl_temp.setX(ft.data.x);
+                amdl_temp.setY(reshape(filt.objs{ii}.data.y,size(ft.data.x)));
+                amdl_temp.setName(filt.objs{ii}.name);
+              else
+                amdl_temp = copy(filt.objs{ii},1);
+                amdl_temp.setName(filt.objs{ii}.name);
+              end
+              % set units
+              ufac = ufac .* amdl_temp.data.yunits;
+            
+            case 'filterbank'
+              % get filter response on given frequencies
+              amdly = utils.math.mtxiirresp(filt.objs{ii}.filters,ft.data.x,fs,filt.objs{ii}.type);
+              amdl_temp = ao(fsdata(ft.data.x, amdly, fs));
+              % handle units
+              switch lower(filt.objs{ii}.type)
+                case 'parallel'
+                  % set units of the output object
+                  ufac = ufac .* filt.objs{ii}.filters(1).ounits ./ filt.objs{ii}.filters(1).iunits;
+                case 'series'
+                  % get units from the series
+                  sunits = filt.objs{ii}.filters(1).ounits ./ filt.objs{ii}.filters(1).iunits;
+                  for jj = 2:numel(filt.objs{ii}.filters)
+                    sunits = sunits.*filt.objs{ii}.filters(jj).ounits ./ filt.objs{ii}.filters(jj).iunits;
+                  end
+                  % set units of the output object
+                  ufac = ufac .* sunits;
+              end
+          end
+          % update response
+          amdl = amdl .* amdl_temp;
+        end
+      
+      otherwise
+      
+        error('### Unknown filter mode.');
+      
+    end
+    
+  end
+  
+  %--------------------------------------------------------------------------
+  % Identifies the filter of the cached block response
+  %--------------------------------------------------------------------------
+  function key = filterKey(filt, fc, gain, iunits, ounits)
+    
+    if ischar(filt)
+      key = {filt, fc, gain, char(iunits), char(ounits)};
+    else
+      key = {class(filt), {filt(:).UUID}};
+    end
+    
+  end
+  
   function msk = getMask(x,filt,fc,gain)
     
     msk = zeros(size(x));
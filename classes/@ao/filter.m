@@ -112,6 +112,8 @@ function varargout = filter(varargin)
   init = utils.prog.yes2true(find_core(pl, 'initialize'));
   % decide to remove group delay or not
   gdoff = utils.prog.yes2true(find_core(pl, 'gdoff'));
+  % number of chunks to filter with a single IIR filter
+  chunks = find_core(pl, 'chunks');
   
   % check inputs
   if ~isa(fobjs, 'miir') && ~isa(fobjs, 'mfir')
@@ -154,19 +156,20 @@ function varargout = filter(varargin)
 
       else %if isa(fobjs_copy, 'miir')
         utils.helper.msg(msg.PROC1, 'filtering with IIR filter');
-        % initialise data vector
         bank = find_core(pl, 'bank');
-        switch lower(bank)
-          case 'parallel'
-            y = zeros(size(bs(jj).data.getY));
-          case 'serial'
-            y = ones(size(bs(jj).data.getY));
-          otherwise
-            error('### Unknown filter bank option. Choose ''serial'' or ''parallel''.');
+        if ~any(strcmpi(bank, {'parallel', 'serial'}))
+          error('### Unknown filter bank option. Choose ''serial'' or ''parallel''.');
         end
-        % Loop over filters
+        % Loop over filters to check them and set their initial states. The
+        % data are then filtered by all of them in a single pass.
         iu = fobjs_copy(1).iunits;
-        ou = fobjs_copy(1).ounits;        
+        ou = fobjs_copy(1).ounits;
+        % first sample at the input of the current filter
+        u  = bs(jj).data.y(1);
+        % a single filter which starts from rest can run on its
+        % second-order sections
+        fresh = numel(fobjs_copy) == 1 && ...
+          (isempty(fobjs_copy.histout) || ~any(fobjs_copy.histout));
         for ff = 1:numel(fobjs_copy)
 
           % check sample rate
@@ -194,39 +197,50 @@ function varargout = filter(varargin)
                 % setting new histout
                 fobjs_copy(ff).setHistout(zi*bs(jj).data.y(1));
               end
-              % filter data
-              [yf, Zf] = filter(fobjs_copy(ff).a, fobjs_copy(ff).b, bs(jj).data.y, fobjs_copy(ff).histout);
-              if ~isequal(size(yf),size(y))
-                yf = yf.';
-              end
-              y = y + yf;
               
             case 'serial'
-              if ff == 1
-                y = bs(jj).data.y;
-              end
               % Initialise the state to avoid transients if necessary
               if ~any(fobjs_copy(ff).histout) || isempty(fobjs_copy(ff).histout)
                 zi = utils.math.iirinit(fobjs_copy(ff).a,fobjs_copy(ff).b);
                 % setting new histout
-                fobjs_copy(ff).setHistout(zi*y(1));
+                fobjs_copy(ff).setHistout(zi*u);
               end
-              % filter data
-              [yf, Zf] = filter(fobjs_copy(ff).a, fobjs_copy(ff).b, y, fobjs_copy(ff).histout);
-              if ~isequal(size(yf),size(y))
-                y = yf.';
-              else
-                y = yf;
+              % first output sample, which is the first input of the next filter
+              h = fobjs_copy(ff).histout;
+              u = fobjs_copy(ff).a(1)/fobjs_copy(ff).b(1)*u;
+              if ~isempty(h)
+                u = u + h(1);
               end
               % set units of the output data as we go
               bs(jj).data.setYunits(bs(jj).data.yunits.*fobjs_copy(ff).ounits./fobjs_copy(ff).iunits);
-            otherwise
-              error('### Unknown filter bank option. Choose ''serial'' or ''parallel''.');
           end
-          % set filter output history
-          fobjs_copy(ff).setHistout(Zf);
         end % End loop over filters
         
+        % filter data
+        if numel(fobjs_copy) == 1 && chunks ~= 1
+          % split the series in chunks which are filtered in parallel
+          [y, Zf] = utils.math.iirchunk(bs(jj).data.y, fobjs_copy.a, fobjs_copy.b, fobjs_copy.histout, chunks);
+          fobjs_copy.setHistout(Zf);
+        elseif fresh && fobjs_copy.validSos && numel(bs(jj).data.y) >= fobjs_copy.ntaps-1
+          x   = bs(jj).data.y;
+          sos = fobjs_copy.sos;
+          if strcmpi(bank, 'serial') || init
+            Zi = utils.math.sosinit(sos)*x(1);
+          else
+            Zi = zeros(2, size(sos, 1));
+          end
+          y = utils.math.sosfilt(x, sos, Zi);
+          % set filter output history in the direct form of a and b
+          fobjs_copy.setHistout(directFormState(fobjs_copy.a, fobjs_copy.b, x, y));
+        else
+          [y, Zf, nz] = utils.math.iirbank(bs(jj).data.y, fobjs_copy, bank);
+          
+          % set filter output history
+          for ff = 1:numel(fobjs_copy)
+            fobjs_copy(ff).setHistout(Zf(1:nz(ff), ff));
+          end
+        end
+        
         % set output data
         bs(jj).data.setY(y);
         % clear errors
@@ -300,6 +314,30 @@ function varargout = filter(varargin)
   varargout = utils.helper.setoutputs(nargout, bs);
 end
 
+%--------------------------------------------------------------------------
+% Final state of the transposed direct form of a and b after filtering x
+% to y, as returned by FILTER. It only depends on the last samples:
+%
+%   z(i) = sum_{k=i}^{n} a(k+1)*x(N-k+i) - b(k+1)*y(N-k+i)
+%
+% with the coefficients normalised by b(1).
+%--------------------------------------------------------------------------
+function z = directFormState(a, b, x, y)
+  n = max(numel(a), numel(b)) - 1;
+  A = zeros(n+1, 1);
+  B = zeros(n+1, 1);
+  A(1:numel(a)) = a./b(1);
+  B(1:numel(b)) = b./b(1);
+  x = x(:);
+  y = y(:);
+  N = numel(x);
+  z = zeros(n, 1);
+  for ii = 1:n
+    k = (ii:n).';
+    z(ii) = A(k+1).'*x(N-k+ii) - B(k+1).'*y(N-k+ii);
+  end
+end
+
 %--------------------------------------------------------------------------
 % Get Info Object
 %--------------------------------------------------------------------------
@@ -346,6 +384,12 @@ function pl = buildplist()
   p = param({'initialize', 'Initialize the filter to avoid startup transients.'}, paramValue.FALSE_TRUE);
   pl.append(p);
   
+  % Chunks
+  p = param({'chunks', ['The number of chunks a single IIR filter splits a time-series into, ' ...
+    'to filter them in parallel. 1 filters the series in a single pass, 0 uses one chunk per thread.']}, ...
+    paramValue.DOUBLE_VALUE(1));
+  pl.append(p);
+  
 end
 
 % PARAMETERS:  filter - the filter object to use to filter the data
@@ -353,3 +397,5 @@ end
 %                       is intended to be 'serial' or 'parallel' [default]
 %              initialize - true or false if you want the filter being
 %                           automatically initialized or not.
+%              chunks - number of chunks to filter in parallel with a
+%                       single IIR filter [default: 1]
@@ -103,7 +103,9 @@ function varargout = filtfilt(varargin)
         y = bs(jj).data.y;
         y_cl = class(y);
         if strcmpi(y_cl, 'double')
-          if isa(fp, 'miir')
+          if isa(fp, 'miir') && fp.validSos
+            bs(jj).data.setY(utils.math.sosfiltfilt(y, fp.sos));
+          elseif isa(fp, 'miir')
             bs(jj).data.setY(filtfilt(fp.a, fp.b, y));
           elseif isa(fp, 'mfir');
             bs(jj).data.setY(filtfilt(fp.a, 1, y));
@@ -9,6 +9,13 @@
 %
 % PARAMETER:   pl: plist containing 'pzmodel', 'Nsecs', 'fs'
 %
+% NOTE:        The white noise is drawn from a counter-based generator keyed
+%              on a seed taken from the random stream (see ao/ngprop), with
+%              or without the mex file ltpda_ngprop. For a given state of
+%              the random stream, the realizations differ from the ones of
+%              earlier versions, which drew the noise from the random
+%              stream itself.
+%
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 function a = fromPzmodel(a, pli)
   
@@ -7,16 +7,32 @@
 %            - Tprop: matrix to calculate propagation vector
 %            - E:     matrix to calculate propagation vector
 %  ... NGINIT
-%            - y:     initial state vector
+%            - y:     initial state vector, or one column per independent
+%                     stream of noise
 %            - num:   numerator coefficients
 %  ... USER
 %            - ns:    number of samples given as input from the user
+%            - seed:  (optional) seed of the white noise. The noise of
+%                     each sample and stream is drawn from a counter-based
+%                     generator keyed on this seed, by the mex file
+%                     ltpda_ngprop or by utils.math.philoxrandn. When
+%                     empty, a seed is drawn from the global MATLAB random
+%                     stream.
+%            - n0:    (optional) index of the first sample, to continue a
+%                     series generated with the same seed [default: 0]
 %  Outputs:
-%            - x:     vector of timesamples
+%            - x:     vector of timesamples, one column per stream
 %            - y:     last calculated state vector (could be used as input
 %                     for next LTPDA_NOISEGEN call)
 
-function [x y] = ngprop(Tprop, E, num, y, ns)
+function [x y] = ngprop(Tprop, E, num, y, ns, seed, n0)
+
+  if nargin < 6
+    seed = [];
+  end
+  if nargin < 7 || isempty(n0)
+    n0 = 0;
+  end
 
   lengT = length(Tprop);
   lengb = lengT+1;
@@ -24,12 +40,29 @@ function [x y] = ngprop(Tprop, E, num, y, ns)
   num=num';
   num = [num zeros(1,(lengb-length(num)-1))];
 
+  if isempty(seed)
+    seed = randi([0 2^32-1]);
+  end
+
+  if exist('ltpda_ngprop', 'file') == 3
+    [x, y] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0);
+    return
+  end
 
-  x = zeros(ns,1);
-  R = randn(lengT, ns);
-  for i=1:ns
-    y = E * y + Tprop * R(:,i);
-    x(i) = num*y;
+  % MATLAB version: the noise is drawn in blocks of samples, for all the
+  % streams at once, from the same counter-based generator as the mex file
+  blockSize = 2^14;
+  Nst = size(y, 2);
+  x = zeros(ns, Nst);
+  for b0 = 0:blockSize:ns-1
+    nb = min(blockSize, ns-b0);
+    % column (i-1)*Nst+s: the noise of the sample n0+b0+i-1 of the stream s
+    smp = n0 + b0 + kron(0:nb-1, ones(1, Nst));
+    R   = utils.math.philoxrandn(seed, smp, repmat(0:Nst-1, 1, nb), lengT);
+    for i=1:nb
+      y = E * y + Tprop * R(:, (i-1)*Nst+1:i*Nst);
+      x(b0+i, :) = num*y;
+    end
   end
 
 end
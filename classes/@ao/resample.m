@@ -15,6 +15,8 @@
 %
 % If no filter is specified for the resampling, then the default MATLAB
 % filter is used. This is returned in the procinfo as an mfir object.
+% The data are filtered by the polyphase resampler utils.math.polyresample,
+% with the same output as MATLAB's resample.
 %
 % Note: for input data types other than double, nearest neighbour
 % interpolation is performed, and any specified filter is ignored.
@@ -110,15 +112,18 @@ function varargout = resample(varargin)
         bs(jj).data.setY(cast(newY, dclass));
         bs(jj).setProcinfo();
       else
+        % polyphase filter, which only computes the kept samples
         if isempty(filt)
-          [newy, b] = resample(bs(jj).data.getY, P, Q);
-          bs(jj).data.setY(newy);
-          f = mfir(b, bs(jj).fs);
-          bs(jj).setProcinfo(plist('filter', f));
+          kernel = utils.math.resamplekernel(P, Q);
         else
           [G,~] = rat(fsout/bs(jj).fs, 1e-12);
-          b = G*filt.a;
-          bs(jj).data.setY(resample(bs(jj).data.getY, P, Q, b));
+          kernel = utils.math.resamplekernel(P, Q, G*filt.a);
+        end
+        bs(jj).data.setY(utils.math.polyresample(bs(jj).data.getY, kernel));
+        if isempty(filt)
+          f = mfir(kernel.b, bs(jj).fs);
+          bs(jj).setProcinfo(plist('filter', f));
+        else
           bs(jj).setProcinfo(plist('filter', filt));
         end
       end
@@ -3,6 +3,11 @@
 %
 % DESCRIPTION: FFTFILT fft filter for matrix objects
 %
+%              The inputs of a row of the input matrix which are time-series
+%              of the same length are filtered together, with a single
+%              evaluation of the response of the filter (see ao/fftfilt_core).
+%              The history is only recorded for the output matrix.
+%
 % CALL:        output = fftfilt(input,filter)
 %
 % <a href="matlab:utils.helper.displayMethodInfo('matrix', 'fftfilt')">Parameters Description</a>
@@ -46,25 +51,20 @@ function varargout = fftfilt(varargin)
   
   % get number of Bins for zero padding
   Npad = find_core(pl,'Npad');
+  % get the block size of the overlap-save filter
+  Nblock = find_core(pl,'block size');
   % do row by colum product
+  tobjs = cell(rw1, cl2);
   for kk = 1:rw1
-    for jj = 1:cl2
-      % fix the first element of the sum
-      try % try to do filter
-        tobj = fftfilt_core(copy(is.objs(1,jj),1), copy(filt.objs(kk,1),1), Npad);
-      catch ME %  if the input ao is empty, ao/filter output an error and tobj is set to []
-        tobj = [];
-      end
-      for zz = 2:cl1
-        try % try to do filter
-          if isempty(tobj)
-            tobj = fftfilt_core(copy(is.objs(zz,jj),1), copy(filt.objs(kk,zz),1), Npad);
-          else
-            tobj = tobj + fftfilt_core(copy(is.objs(zz,jj),1), copy(filt.objs(kk,zz),1), Npad);
-          end
-        catch ME %  if the input ao is empty, ao/filter output an error
-        end
+    for zz = 1:cl1
+      % filter the row zz of the inputs
+      terms = filterRow(is.objs(zz,:), filt.objs(kk,zz), Npad, Nblock);
+      for jj = 1:cl2
+        tobjs{kk,jj} = addTerm(tobjs{kk,jj}, terms{jj});
       end
+    end
+    for jj = 1:cl2
+      tobj = tobjs{kk,jj};
       % simplify y units
       tobj_yu = tobj.yunits;
       tobj_yu.simplify;
@@ -79,6 +79,8 @@ function varargout = fftfilt(varargin)
     end
   end
   
+  os.addHistory(getInfo('None'), pl, in_names(1:2), [is.hist filt.hist]);
+  
   if nargout == 1
     varargout{1} = os;
   else
@@ -87,6 +89,66 @@ function varargout = fftfilt(varargin)
   
 end
 
+%--------------------------------------------------------------------------
+% Filter a row of inputs with one filter. Time-series of the same length
+% are filtered together; otherwise, or if this fails, each input is
+% filtered on its own. The terms which can not be filtered, such as empty
+% AOs, are left empty.
+%--------------------------------------------------------------------------
+function terms = filterRow(as, filt, Npad, Nblock)
+  
+  terms = cell(1, numel(as));
+  together = numel(as) > 1 && all(arrayfun(@(a) isa(a.data, 'tsdata'), as));
+  if together
+    N = numel(as(1).data.y);
+    together = N > 0 && all(arrayfun(@(a) numel(a.data.y) == N && a.data.fs == as(1).data.fs, as));
+  end
+  
+  if together
+    try % try to filter the row together
+      bs = fftfilt_core(copy(as,1), copy(filt,1), Npad, [], [], [], [], [], Nblock);
+      for jj = 1:numel(bs)
+        terms{jj} = bs(jj);
+      end
+    catch ME %  if the row can not be filtered together, each input is filtered on its own
+      together = false;
+    end
+  end
+  
+  if ~together
+    for jj = 1:numel(as)
+      try % try to do filter
+        terms{jj} = fftfilt_core(copy(as(jj),1), copy(filt,1), Npad, [], [], [], [], [], Nblock);
+      catch ME %  if the input ao is empty, ao/filter output an error and the term is set to []
+      end
+    end
+  end
+  
+end
+
+%--------------------------------------------------------------------------
+% Add a filtered term to a sum. Terms with the same units and length are
+% added in place, without the history of the plus operator.
+%--------------------------------------------------------------------------
+function tobj = addTerm(tobj, term)
+  
+  if isempty(term)
+    return
+  end
+  if isempty(tobj)
+    tobj = term;
+  elseif isequal(size(tobj.data.y), size(term.data.y)) && isequal(simplify(tobj.yunits), simplify(term.yunits))
+    tobj.data.setY(tobj.data.y + term.data.y);
+    tobj.name = sprintf('(%s + %s)', tobj.name, term.name);
+  else
+    try % try to add the terms
+      tobj = tobj + term;
+    catch ME %  if the terms can not be added, the term is dropped
+    end
+  end
+  
+end
+
 %--------------------------------------------------------------------------
 % Get Info Object
 %--------------------------------------------------------------------------
@@ -122,4 +184,9 @@ function pl = buildplist()
   p = param({'Npad', 'Number of bins for zero padding.'}, paramValue.EMPTY_DOUBLE);
   pl.append(p);
   
+  % Block size
+  p = param({'block size', ['The number of samples of the FFT blocks of an overlap-save filter. ' ...
+    'If empty, the whole series is zero-padded and filtered with a single FFT.']}, paramValue.EMPTY_DOUBLE);
+  pl.append(p);
+  
 end
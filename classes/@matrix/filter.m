@@ -3,6 +3,12 @@
 %
 % DESCRIPTION: FILTER implements N-dim filter operator for matrix objects.
 %
+%              When the inputs are time-series of the same length and sample
+%              rate and the filters are single miir/mfir objects, each row of
+%              the filter matrix is applied to all the input channels in a
+%              single multichannel pass (see utils.math.mchiir). The history
+%              is then only recorded for the output matrix.
+%
 % CALL:        output = filter(input,filt);
 %
 % <a href="matlab:utils.helper.displayMethodInfo('matrix', 'filter')">Parameters Description</a>
@@ -47,6 +53,14 @@ function varargout = filter(varargin)
     end
   end
   
+  % filter all the channels together
+  if strcmp(ids, 'ND') && isChannelFilter(mat1.objs, mat2.objs)
+    mat = filterChannels(mat1.objs, mat2.objs);
+    mat(:).addHistory(getInfo('None'), [], {inputname(1), inputname(2)}, [mat1(:).hist mat2(:).hist]);
+    varargout{1} = mat;
+    return
+  end
+  
   switch ids
     case '1D'
       % init output
@@ -105,6 +119,197 @@ end
 %                               Local Functions                               %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% FUNCTION:    isChannelFilter
+%
+% DESCRIPTION: True if the product can be done in one multichannel pass per
+%              row of filters: the inputs are non-empty time-series of the
+%              same length, sample rate and start, the filters are single
+%              miir/mfir objects at that sample rate, the FIR filters of a
+%              row have the same group delay, and the terms of each sum have
+%              the same units.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function res = isChannelFilter(filts, as)
+  
+  res = false;
+  
+  % inputs
+  if ~isa(as, 'ao') || ~all(arrayfun(@(a) isa(a.data, 'tsdata'), as(:)))
+    return
+  end
+  N  = numel(as(1).data.y);
+  fs = as(1).data.fs;
+  t0 = as(1).data.t0;
+  for ii = 1:numel(as)
+    if numel(as(ii).data.y) ~= N || N == 0 || ~isreal(as(ii).data.y) || ...
+        as(ii).data.fs ~= fs || ~isequal(as(ii).data.t0, t0) || ...
+        as(ii).data.toffset ~= as(1).data.toffset || ~isempty(as(ii).data.x)
+      return
+    end
+  end
+  
+  % filters
+  for ii = 1:numel(filts)
+    if ~(isa(filts(ii), 'miir') || isa(filts(ii), 'mfir')) || ...
+        ~utils.helper.eq2eps(filts(ii).fs, fs) || ...
+        numel(filts(ii).histout) >= max(numel(filts(ii).a), numel(denominator(filts(ii))))
+      return
+    end
+  end
+  [rw1, cl1] = size(filts);
+  for kk = 1:rw1
+    if numel(unique(arrayfun(@groupDelay, filts(kk,:)))) > 1
+      return
+    end
+    if groupDelay(filts(kk,1)) >= N
+      return
+    end
+    for jj = 1:size(as, 2)
+      yu = termUnits(as(1,jj), filts(kk,1));
+      for zz = 2:cl1
+        if ~isequal(termUnits(as(zz,jj), filts(kk,zz)), yu)
+          return
+        end
+      end
+    end
+  end
+  
+  res = true;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% FUNCTION:    filterChannels
+%
+% DESCRIPTION: The product of the filter matrix with the matrix of inputs.
+%              For each row of filters, the input as(zz,jj) is filtered by
+%              filts(kk,zz): all the channels go through their filters in a
+%              single pass, and the outputs are summed over zz. The output
+%              objects keep the history of their first input.
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function mat = filterChannels(filts, as)
+  
+  import utils.const.*
+  
+  [rw1, cl1] = size(filts);
+  cl2 = size(as, 2);
+  N   = numel(as(1).data.y);
+  
+  % the input channels, one per column
+  X = zeros(N, numel(as));
+  for ii = 1:numel(as)
+    X(:, ii) = as(ii).data.y(:);
+  end
+  
+  bs = ao.initObjectWithSize(rw1, cl2);
+  for kk = 1:rw1
+    utils.helper.msg(msg.PROC1, 'filtering %d channels with row %d of the filters', numel(as), kk);
+    
+    % coefficients and states of the filter of each channel
+    M = 1;
+    for zz = 1:cl1
+      M = max([M numel(filts(kk,zz).a) numel(denominator(filts(kk,zz)))]);
+    end
+    a  = cell(1, numel(as));
+    b  = cell(1, numel(as));
+    Zi = zeros(M-1, numel(as));
+    for jj = 1:cl2
+      for zz = 1:cl1
+        ii = sub2ind(size(as), zz, jj);
+        a{ii} = filts(kk,zz).a;
+        b{ii} = denominator(filts(kk,zz));
+        h = filts(kk,zz).histout;
+        Zi(1:numel(h), ii) = h(:);
+      end
+    end
+    
+    [Y, Zf] = utils.math.mchiir(X, a, b, Zi);
+    
+    % the group delay of FIR filters is removed
+    gd = groupDelay(filts(kk,1));
+    
+    for jj= 1:cl2
+      idx = sub2ind(size(as), 1:cl1, jj*ones(1, cl1));
+      y   = sum(Y(1+gd:end, idx), 2);
+      if size(as(1,jj).data.y, 1) == 1
+        y = y.';
+      end
+      
+      tobj = copy(as(1,jj), 1);
+      tobj.data.setY(y);
+      if gd > 0
+        tobj.data.fixNsecs;
+      end
+      tobj.clearErrors;
+      
+      % units of the sum
+      tobj_yu = termUnits(as(1,jj), filts(kk,1));
+      tobj_yu.simplify;
+      tobj.data.setYunits(tobj_yu);
+      if ~isempty(tobj.xunits)
+        tobj_xu = tobj.xunits;
+        tobj_xu.simplify;
+        tobj.data.setXunits(tobj_xu);
+      end
+      
+      % name of the sum, and the filter with its final state for a single term
+      names = cell(1, cl1);
+      for zz = 1:cl1
+        names{zz} = sprintf('%s(%s)', filts(kk,zz).name, as(zz,jj).name);
+      end
+      if cl1 == 1
+        tobj.name = names{1};
+        fobj = copy(filts(kk,1), 1);
+        ns   = max(numel(fobj.a), numel(denominator(fobj))) - 1;
+        fobj.setHistout(Zf(1:ns, idx));
+        tobj.procinfo = plist('filter', fobj);
+      else
+        tobj.name = ['(' utils.prog.strjoin(names, ' + ') ')'];
+        tobj.procinfo = [];
+      end
+      
+      bs(kk,jj) = tobj;
+    end
+  end
+  
+  mat = matrix(bs, plist('shape', [rw1, cl2]));
+end
+
+%--------------------------------------------------------------------------
+% The denominator coefficients of a filter
+%--------------------------------------------------------------------------
+function b = denominator(filt)
+  if isa(filt, 'mfir')
+    b = 1;
+  else
+    b = filt.b;
+  end
+end
+
+%--------------------------------------------------------------------------
+% The number of samples removed by ao/filter for the group delay
+%--------------------------------------------------------------------------
+function gd = groupDelay(filt)
+  if isa(filt, 'mfir')
+    gd = floor(filt.gd);
+  else
+    gd = 0;
+  end
+end
+
+%--------------------------------------------------------------------------
+% The units of an input filtered by a filter
+%--------------------------------------------------------------------------
+function yu = termUnits(a, filt)
+  yu = a.data.yunits.*filt.ounits./filt.iunits;
+  yu.simplify;
+end
+
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 % FUNCTION:    getInfo
@@ -6,6 +6,15 @@
 %
 % DESCRIPTION:
 %
+%     Each column of the filter matrix is driven by an independent white
+%     noise source, and each filter is a bank of one-pole recursions. The
+%     sources are drawn from a counter-based generator keyed on a seed
+%     from the MATLAB random stream, so that the output is the same with
+%     or without the mex file ltpda_mchnoise. When the mex file is
+%     available, the recursions of all the channels are run together and
+%     the channels are shared between threads, with the same output for
+%     any number of threads. The noise can be written to a binary file
+%     instead of the memory, see the 'filename' parameter.
 %
 % CALL:        out = mchNoisegen(mod, pl)
 %
@@ -112,13 +121,20 @@ function varargout = mchNoisegen(varargin)
   % init output
   out(nn,1) = ao;
   
+  % every column zz of the filter matrix is driven by its own white noise
+  % source zz: collect the poles a, the gains g and the initial states y0
+  % of the one-pole recursions y = a.*y + g.*w(zz), with the output channel
+  % of each pole
+  a    = [];
+  g    = [];
+  y0   = [];
+  chan = [];
+  src  = [];
+  
   % switch between input filter type
   switch sys
     case 'z' % discrete input filters
       
-      % init output data
-      o = zeros(nn,Ntot);
-      
       for zz=1:nn % moving along system dimension
         
         % extract residues and poles from input objects
@@ -140,88 +156,15 @@ function varargout = mchNoisegen(varargin)
         % rescaling residues to get the correct result for univariate psd
         res = res.*sqrt(fs/2);
         
-        
-        %         Nrs = numel(res);
-        %         % get covariance matrix
-        %         R = zeros(Nrs);
-        %         for aa=1:Nrs
-        %           for bb=1:Nrs
-        %             R(aa,bb) = (res(aa)*conj(res(bb)))/(1-pls(aa)*conj(pls(bb)));
-        %           end
-        %         end
-        %
-        %         % avoiding problems caused by roundoff errors
-        %         HH = triu(R,0); % get upper triangular part of R
-        %         HH1 = triu(R,1); % get upper triangular part of R above principal diagonal
-        %         HH2 = HH1'; % do transpose conjugate
-        %         R = HH + HH2; % reconstruct R in order to be really hermitian
-        %
-        %         % get singular value decomposition of R
-        %         [U,S,V] = svd(R,0);
-        %
-        %         % conversion matrix
-        %         A = V*sqrt(S);
-        %
-        %         % generate unitary variance gaussian random noise
-        %         %ns = randn(Nrs,Ntot);
-        %         ns = randn(Nrs,1);
-        %
-        %         % get correlated starting data points
-        %         cns = A*ns;
-        %
-        %         % need to correct for roundoff errors
-        %         % cleaning up results for numerical approximations
-        %         idx = imag(pls(:,1))==0;
-        %         cns(idx) = real(cns(idx));
-        %
-        %         % cleaning up results for numerical roundoff errors
-        %         % states associated to complex conjugate poles must be complex
-        %         % conjugate
-        %         idxi = imag(pls(:,1))~=0;
-        %         icns = cns(idxi);
-        %         for jj = 1:2:numel(icns)
-        %           icns(jj+1,1) = conj(icns(jj,1));
-        %         end
-        %         cns(idxi) = icns;
-        
         cns = getinitz(res,pls,filtsz,fromnsg2D);
         
-        y = zeros(sum(filtsz),2);
-        rnoise = zeros(sum(filtsz),1);
-        rns = randn(1,Ntot);
-        %rns = utils.math.blwhitenoise(Ntot,fs,1/Nsecs,fs/2);
-        %rns = rns.'; % willing to work with raw
-        
-        y(:,1) = cns;
-        
-        % start recurrence
-        for xx = 2:Ntot+1
-          rnoise(:,1) = rns(xx-1);
-          y(:,2) = pls.*y(:,1) + res.*rnoise;
-          idxr = 0;
-          for kk=1:nn
-            o(kk,xx-1) = o(kk,xx-1) + sum(y(idxr+1:idxr+filtsz(kk),2));
-            idxr = idxr+filtsz(kk);
-          end
-          y(:,1) = y(:,2);
-        end
+        [a, g, y0, chan, src] = addSource(a, g, y0, chan, src, ...
+          pls, res, cns, filtsz, zz);
         
       end
       
-      clear rns
-      
-      % build output ao
-      for dd=1:nn
-        out(dd,1) = ao(tsdata(o(dd,:),fs));
-        out(dd,1).setYunits(unit(yunit));
-      end
-      
-      outm = matrix(out);
-      
     case 's' % continuous input filters
       
-      o = zeros(nn,Ntot);
-      
       T = 1/fs; % sampling period
       
       for zz=1:nn % moving along system dimension
@@ -284,77 +227,68 @@ function varargout = mchNoisegen(varargin)
         Ax = Vx*sqrt(Sx);
         
         % generate unitary variance gaussian random noise
-        %ns = randn(Nrs,Ntot);
         ns = randn(Nrs,1);
         
-        % get correlated starting data points
-        cns = Ax*ns;
-        
-        % need to correct for roundoff errors
-        % cleaning up results for numerical approximations
-        idx = imag(pls(:,1))==0;
-        cns(idx) = real(cns(idx));
+        % get correlated starting data points and the gains of the
+        % innovation, which is driven by a single source
+        cns = cleanStates(Ax*ns, pls);
+        gin = cleanStates(Ai*ones(Nrs,1), pls);
         
-        % cleaning up results for numerical roundoff errors
-        % states associated to complex conjugate poles must be complex
-        % conjugate
-        idxi = imag(pls(:,1))~=0;
-        icns = cns(idxi);
-        for jj = 1:2:numel(icns)
-          icns(jj+1,1) = conj(icns(jj,1));
-        end
-        cns(idxi) = icns;
-        
-        y = zeros(sum(filtsz),2);
-        rnoise = zeros(sum(filtsz),1);
-        rns = randn(1,Ntot);
-        %rns = utils.math.blwhitenoise(Ntot,fs,1/Nsecs,fs/2);
-        %rns = rns.'; % willing to work with raw
-        
-        y(:,1) = cns;
-        
-        % start recurrence
-        for xx = 2:Ntot+1
-          %           innov = Ai*randn(sum(filtsz),1);
-          rnoise(:,1) = rns(xx-1);
-          innov = Ai*rnoise;
-          % need to correct for roundoff errors
-          % cleaning up results for numerical approximations
-          innov(idx) = real(innov(idx));
-          
-          % cleaning up results for numerical roundoff errors
-          % states associated to complex conjugate poles must be complex
-          % conjugate
-          iinnov = innov(idxi);
-          for jj = 1:2:numel(iinnov)
-            iinnov(jj+1,1) = conj(iinnov(jj,1));
-          end
-          innov(idxi) = iinnov;
-          
-          y(:,2) = diag(exp(pls.*T))*y(:,1) + innov;
-          
-          idxr = 0;
-          for kk=1:nn
-            o(kk,xx-1) = o(kk,xx-1) + sum(y(idxr+1:idxr+filtsz(kk),2));
-            idxr = idxr+filtsz(kk);
-          end
-          y(:,1) = y(:,2);
-        end
+        [a, g, y0, chan, src] = addSource(a, g, y0, chan, src, ...
+          exp(pls.*T), gin, cns, filtsz, zz);
         
       end
       
-      %       clear rns
-      
-      % build output ao
-      for dd=1:nn
-        out(dd,1) = ao(tsdata(o(dd,:),fs));
-        out(dd,1).setYunits(unit(yunit));
+  end
+  
+  % the file of the output
+  filename = find_core(pl, 'filename');
+  
+  % the sources are drawn from the counter-based generator of the mex
+  % file, keyed on a seed from the MATLAB random stream: the output does
+  % not depend on the number of threads, nor on the mex file
+  seed = randi([0 2^32-1]);
+  if exist('ltpda_mchnoise', 'file') == 3
+    o = ltpda_mchnoise(a, g, y0, chan, src, Ntot, seed, filename);
+  else
+    o = zeros(nn,Ntot);
+    for zz=1:nn
+      % the sample n of the source zz is the deviate mod(n,2) of the
+      % sample floor(n/2) of the stream zz-1
+      w = utils.math.philoxrandn(seed, 0:ceil(Ntot/2)-1, zz-1, 2);
+      w = w(1:Ntot);
+      for kk=find(src == zz).'
+        y = filter(g(kk), [1 -a(kk)], w, a(kk)*y0(kk));
+        o(chan(kk),:) = o(chan(kk),:) + real(y);
       end
-      
-      outm = matrix(out);
-      
+    end
+    if ~isempty(filename)
+      fid = fopen(filename, 'w');
+      if fid == -1
+        error('### Unable to open the file %s', filename);
+      end
+      fwrite(fid, o, 'double');
+      fclose(fid);
+      o = [];
+    end
   end
   
+  % build output ao
+  for dd=1:nn
+    if isempty(filename)
+      out(dd,1) = ao(tsdata(o(dd,:),fs));
+    else
+      % the samples of the channels are in the file, one after the other
+      ts = tsdata();
+      ts.setFs(fs);
+      out(dd,1) = ao(ts);
+      out(dd,1).setProcinfo(plist('filename', filename, 'channel', dd, 'nchannels', nn));
+    end
+    out(dd,1).setYunits(unit(yunit));
+  end
+  
+  outm = matrix(out);
+  
   outm.addHistory(getInfo('None'), pl, [mtxs_invars(:)], [inhists(:)]);
   
   % set output
@@ -408,6 +342,13 @@ function pl = buildplist()
   p = param({'yunits','Unit on Y axis.'},  paramValue.STRING_VALUE(''));
   pl.append(p);
   
+  % Filename
+  p = param({'filename', ['The name of a binary file for the noise. The samples ' ...
+    'of all the channels are written one after the other, so that they can be ' ...
+    'read with fread(fid, [Nchannels Inf], ''double''). The output AOs are then ' ...
+    'empty, with the file name in their procinfo.']}, paramValue.EMPTY_STRING);
+  pl.append(p);
+  
   % RAND_STREAM
   pl.append(copy(plist.RAND_STREAM, 1));
   
@@ -565,3 +506,44 @@ function cns = getinitz(res,pls,filtsz,fromnsg2D)
   end
   
 end
+
+%--------------------------------------------------------------------------
+% Local function
+% Append the poles of the noise source zz, with the output channel of
+% each pole
+%--------------------------------------------------------------------------
+function [a, g, y0, chan, src] = addSource(a, g, y0, chan, src, pls, res, cns, filtsz, zz)
+  
+  nch = zeros(0, 1);
+  for kk=1:numel(filtsz)
+    nch = [nch; repmat(kk, filtsz(kk), 1)];
+  end
+  
+  a    = [a; pls(:)];
+  g    = [g; res(:)];
+  y0   = [y0; cns(:)];
+  chan = [chan; nch];
+  src  = [src; repmat(zz, numel(pls), 1)];
+  
+end
+
+%--------------------------------------------------------------------------
+% Local function
+% Clean up the roundoff errors of the states of the poles
+%--------------------------------------------------------------------------
+function cns = cleanStates(cns, pls)
+  
+  % cleaning up results for numerical approximations
+  idx = imag(pls(:,1))==0;
+  cns(idx) = real(cns(idx));
+  
+  % states associated to complex conjugate poles must be complex
+  % conjugate
+  idxi = imag(pls(:,1))~=0;
+  icns = cns(idxi);
+  for jj = 1:2:numel(icns)
+    icns(jj+1,1) = conj(icns(jj,1));
+  end
+  cns(idxi) = icns;
+  
+end
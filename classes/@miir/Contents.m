@@ -25,4 +25,6 @@
 %   <a href="matlab:help classes\@miir\redesign">classes\@miir\redesign</a>                 -  redesign the input filter to work for the given sample rate.
 %   <a href="matlab:help classes\@miir\setB">classes\@miir\setB</a>                     -  Set the property 'b'
 %   <a href="matlab:help classes\@miir\setHistin">classes\@miir\setHistin</a>                -  Set the property 'histin'
+%   <a href="matlab:help classes\@miir\setSos">classes\@miir\setSos</a>                   -  Set the property 'sos'
 %   <a href="matlab:help classes\@miir\update_struct">classes\@miir\update_struct</a>            -  update the input structure to the current ltpda version
+%   <a href="matlab:help classes\@miir\validSos">classes\@miir\validSos</a>                 -  returns true if the second-order sections of the filter give its coefficients.
@@ -27,6 +27,11 @@ function collectedHist = attachToDom(objs, dom, parent, collectedHist)
       utils.xml.attachNumberToDom(obj.histin, dom, histinNode);
       miirNode.appendChild(histinNode);
       
+      % Add sos
+      sosNode = dom.createElement('sos');
+      utils.xml.attachNumberToDom(obj.sos, dom, sosNode);
+      miirNode.appendChild(sosNode);
+      
       % Add to parent node
       parent.appendChild(miirNode);
       
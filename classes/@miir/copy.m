@@ -32,6 +32,7 @@ if deepcopy
     for kk=1:numel(old)
         obj(kk).b       = old(kk).b;
         obj(kk).histin  = old(kk).histin;
+        obj(kk).sos     = old(kk).sos;
     end
 else
     obj = old;
@@ -30,6 +30,12 @@ function obj = fromDom(obj, node, inhists)
       obj.histin = utils.xml.getNumber(childNode);
     end
     
+    % Get sos
+    childNode = utils.xml.getChildByName(node, 'sos');
+    if ~isempty(childNode)
+      obj.sos = utils.xml.getNumber(childNode);
+    end
+    
   end
   
 end
@@ -40,6 +40,11 @@ function f = fromParfrac(f, pli)
     f(jj).b  = pfstruct(jj).den;
     f(jj).fs = fs;
     
+    % The terms of up to second order are sections on their own
+    if max(numel(f(jj).a), numel(f(jj).b)) <= 3
+      f(jj).sos = [padSection(f(jj).a) padSection(f(jj).b)];
+    end
+    
     if isempty(pl.find_core('name'))
       pl.pset('name', sprintf('iir(%s_%d)', pf.name, jj));
     end
@@ -67,3 +72,10 @@ function f = fromParfrac(f, pli)
   end
   
 end % End fromParfrac
+
+%--------------------------------------------------------------------------
+% Pad the coefficients of a first or second-order term to three
+%--------------------------------------------------------------------------
+function c = padSection(c)
+  c = [c(:).' zeros(1, 3-numel(c))];
+end
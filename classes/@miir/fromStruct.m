@@ -45,6 +45,11 @@ function objs = fromStruct(objs, obj_struct)
       objs(kk).histin = up_struct.histin;
     end
     
+    % Set 'sos'
+    if isfield(up_struct, 'sos')
+      objs(kk).sos = up_struct.sos;
+    end
+    
   end
   
 end
@@ -51,6 +51,9 @@ function pl = generateConstructorPlist(varargin)
   % Add histin
   appendProperty(pl, obj, 'histin');
   
+  % Add sos
+  appendProperty(pl, obj, 'sos');
+  
   % Add infile
   appendProperty(pl, obj, 'infile');
   
@@ -60,6 +60,7 @@ classdef miir < ltpda_filter
   properties (SetAccess = protected)
     b       = []; % set of denominator coefficients
     histin  = []; % input history values to filter
+    sos     = []; % second-order sections [a0 a1 a2 b0 b1 b2], one per row
   end
   
   %---------- Protected read-only Properties ----------
@@ -80,6 +81,14 @@ classdef miir < ltpda_filter
       end
       obj.histin = val;
     end
+    function set.sos(obj, val)
+      if ~isempty(val)
+        if ~isnumeric(val) || ~isreal(val) || size(val, 2) ~= 6
+          error('### The value for the property ''sos'' must be a real matrix with 6 columns');
+        end
+      end
+      obj.sos = val;
+    end
     function set.b(obj, val)
       if ~isempty(val)
         if ~isnumeric(val)
@@ -303,6 +312,7 @@ classdef miir < ltpda_filter
   methods (Access = public)
     varargout = setHistin(varargin)
     varargout = setB(varargin)
+    varargout = setSos(varargin)
     varargout = redesign(varargin)
   end
   
@@ -311,6 +321,7 @@ classdef miir < ltpda_filter
   methods (Access = public, Hidden = true)
     varargout = attachToDom(varargin)
     varargout = fromDom(varargin)
+    varargout = validSos(varargin)
   end
   
   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
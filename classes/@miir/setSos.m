@@ -0,0 +1,95 @@
+% SETSOS Set the property 'sos'
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION: SETSOS Set the property 'sos'
+%
+% CALL:        obj = obj.setSos(sos);
+%              obj = setSos(obj, sos);
+%
+% INPUTS:      obj - is a miir object
+%              sos - the second-order sections of the filter, one
+%                    [a0 a1 a2 b0 b1 b2] per row, with the numerator in
+%                    the first three columns as for the property 'a'.
+%                    The sections are only used to filter while their
+%                    product gives the coefficients 'a' and 'b'.
+%
+% <a href="matlab:utils.helper.displayMethodInfo('miir', 'setSos')">Parameters Description</a>
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function varargout = setSos(varargin)
+  
+  %%% Check if this is a call for parameters
+  if utils.helper.isinfocall(varargin{:})
+    varargout{1} = getInfo(varargin{3});
+    return
+  end
+  
+  % Check if this is a call from a class method
+  callerIsMethod = utils.helper.callerIsMethod;
+  
+  obj = varargin{1};
+  val = varargin{2};
+  
+  %%% If val is a plist-object then get the value out of the plist
+  if isa(val, 'plist')
+    val = find_core(val, 'sos');
+  end
+  
+  %%% decide whether we modify the miir-object, or create a new one.
+  obj = copy(obj, nargout);
+  
+  %%% set 'sos'
+  obj.sos = val;
+  
+  if ~callerIsMethod
+    obj.addHistory(getInfo('None'), plist('sos', val), '', obj.hist);
+  end
+  
+  varargout{1} = obj;
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                               Local Functions                               %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% FUNCTION:    getInfo
+%
+% DESCRIPTION: Get Info Object
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function ii = getInfo(varargin)
+  if nargin == 1 && strcmpi(varargin{1}, 'None')
+    sets = {};
+    pl   = [];
+  else
+    sets = {'Default'};
+    pl   = getDefaultPlist;
+  end
+  % Build info object
+  ii = minfo(mfilename, mfilename('class'), 'ltpda', utils.const.categories.helper, '', sets, pl);
+end
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% FUNCTION:    getDefaultPlist
+%
+% DESCRIPTION: Get Default Plist
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function plout = getDefaultPlist()
+  persistent pl;
+  if exist('pl', 'var')==0 || isempty(pl)
+    pl = buildplist();
+  end
+  plout = pl;
+end
+
+function pl = buildplist()
+  pl = plist({'sos', 'A matrix of second-order sections [a0 a1 a2 b0 b1 b2], one per row.'}, paramValue.EMPTY_DOUBLE);
+end
+
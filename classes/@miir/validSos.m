@@ -0,0 +1,51 @@
+% VALIDSOS returns true if the second-order sections of the filter give its coefficients.
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION: VALIDSOS returns true if the filter has second-order
+%              sections and the cascade of the sections gives the
+%              coefficients 'a' and 'b' of the filter. This is not the
+%              case anymore after e.g. setB or a redesign, and the
+%              sections must not be used then.
+%
+% CALL:        tf = validSos(filt)
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function tf = validSos(varargin)
+  
+  filt = varargin{1};
+  tf   = false;
+  
+  if isempty(filt.sos) || isempty(filt.a) || isempty(filt.b) || filt.b(1) == 0
+    return
+  end
+  
+  % Cascade the sections
+  num = 1;
+  den = 1;
+  for kk = 1:size(filt.sos, 1)
+    num = conv(num, filt.sos(kk, 1:3));
+    den = conv(den, filt.sos(kk, 4:6));
+  end
+  if den(1) == 0
+    return
+  end
+  num = num./den(1);
+  den = den./den(1);
+  
+  a = filt.a./filt.b(1);
+  b = filt.b./filt.b(1);
+  
+  tf = sameCoefficients(num, a) && sameCoefficients(den, b);
+  
+end
+
+%--------------------------------------------------------------------------
+% Compare two coefficient vectors, up to trailing zeros
+%--------------------------------------------------------------------------
+function tf = sameCoefficients(c1, c2)
+  n  = max(numel(c1), numel(c2));
+  c1 = [c1(:); zeros(n-numel(c1), 1)];
+  c2 = [c2(:); zeros(n-numel(c2), 1)];
+  tf = norm(c1 - c2) <= 1e-10*max(norm(c2), 1);
+end
@@ -5,6 +5,10 @@
 %              transform.
 %
 % CALL:        [a,b] = pzm2ab(pzm, fs)
+%              [a,b,sos] = pzm2ab(pzm, fs)
+%
+%              sos holds the sections which are cascaded to give a and b,
+%              one [a0 a1 a2 b0 b1 b2] per row (see miir/setSos).
 %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
@@ -37,6 +41,7 @@ function varargout = pzm2ab(varargin)
 
   ao = [];
   bo = [];
+  sos = [];
 
   utils.helper.msg(utils.const.msg.OPROC1, 'converting %s', pzm.name)
 
@@ -68,6 +73,7 @@ function varargout = pzm2ab(varargin)
         ao = ai;
         bo = bi;
       end
+      sos = [sos; sosRow(ai, bi)];
 
       % increment zero counter
       czi = czi + 1;
@@ -85,6 +91,7 @@ function varargout = pzm2ab(varargin)
         ao = ai;
         bo = bi;
       end
+      sos = [sos; sosRow(ai, bi)];
     end
   else
     % do remaining czeros
@@ -97,6 +104,7 @@ function varargout = pzm2ab(varargin)
         ao = ai;
         bo = bi;
       end
+      sos = [sos; sosRow(ai, bi)];
     end
   end
 
@@ -112,6 +120,7 @@ function varargout = pzm2ab(varargin)
         ao = ai;
         bo = bi;
       end
+      sos = [sos; sosRow(ai, bi)];
     end
   end
 
@@ -126,13 +135,22 @@ function varargout = pzm2ab(varargin)
         ao = ai;
         bo = bi;
       end
+      sos = [sos; sosRow(ai, bi)];
     end
   end
 
   ao = ao.*gain;
 
+  % The gain goes to the numerator of the first section
+  if isempty(sos)
+    sos = [gain 0 0 1 0 0];
+  else
+    sos(1,1:3) = sos(1,1:3).*gain;
+  end
+
   varargout{1} = ao;
   varargout{2} = bo;
+  varargout{3} = sos;
 end
 
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -178,6 +196,24 @@ function [a,b] = cpolezero(pf, pq, zf, zq, fs)
 end
 
 
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% FUNCTION:    sosRow
+%
+% DESCRIPTION: Pad the coefficients of a first or second-order section to
+%              one row of a second-order section matrix.
+%
+% CALL:        s = sosRow(a,b)
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function s = sosRow(a,b)
+  s = zeros(1,6);
+  s(1:numel(a)) = a;
+  s(4:3+numel(b)) = b;
+end
+
+
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 % FUNCTION:    iirdcgain
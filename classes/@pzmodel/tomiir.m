@@ -56,7 +56,7 @@ function varargout = tomiir(varargin)
   for kk = 1:numel(pzms)
     
     % get a and b coefficients
-    [a,b] = pzm2ab(pzms(kk), fs);
+    [a,b,sos] = pzm2ab(pzms(kk), fs);
     
     % throws a warning if the model has a delay
     if(pzms(kk).delay~=0)
@@ -64,6 +64,7 @@ function varargout = tomiir(varargin)
     end
     % make MIIR filter
     f(kk) = miir(a,b,fs);
+    f(kk).setSos(sos);
     
     if ~callerIsMethod
       % create new history for the case that the method isn't called from
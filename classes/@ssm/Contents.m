@@ -2,6 +2,7 @@
 %
 %   <a href="matlab:help classes\@ssm\addParameters">classes\@ssm\addParameters</a>                 -  Adds the parameters to the model.
 %   <a href="matlab:help classes\@ssm\append">classes\@ssm\append</a>                        - appends embedded subsytems, with exogenous inputs
+%   <a href="matlab:help classes\@ssm\applyParameterEvaluator">classes\@ssm\applyParameterEvaluator</a>       -  sets numeric matrices from a parameter evaluator
 %   <a href="matlab:help classes\@ssm\assemble">classes\@ssm\assemble</a>                      - assembles embedded subsytems, with exogenous inputs
 %   <a href="matlab:help classes\@ssm\attachToDom">classes\@ssm\attachToDom</a>                   - % Create empty ssm node with the attribute 'shape'
 %   <a href="matlab:help classes\@ssm\blockMatAdd">classes\@ssm\blockMatAdd</a>                   - adds corresponding matrices of same sizes or empty inside cell array
@@ -13,6 +14,7 @@
 %   <a href="matlab:help classes\@ssm\blockMatRecut">classes\@ssm\blockMatRecut</a>                 - cuts a matrix into blocks stored inside cell array
 %   <a href="matlab:help classes\@ssm\bode">classes\@ssm\bode</a>                          -  makes a bode plot from the given inputs to outputs.
 %   <a href="matlab:help classes\@ssm\bodecst">classes\@ssm\bodecst</a>                       -  makes a bodecst plot from the given inputs to outputs.
+%   <a href="matlab:help classes\@ssm\buildParameterEvaluator">classes\@ssm\buildParameterEvaluator</a>       -  builds function handles for the symbolic matrices
 %   <a href="matlab:help classes\@ssm\buildParamPlist">classes\@ssm\buildParamPlist</a>               -  builds paramerter plists for the ssm params field.
 %   <a href="matlab:help classes\@ssm\c2d">classes\@ssm\c2d</a>                           -  performs actions on ao objects.
 %   <a href="matlab:help classes\@ssm\char">classes\@ssm\char</a>                          -  convert a ssm object into a string.
@@ -46,6 +48,7 @@
 %   <a href="matlab:help classes\@ssm\loadobj">classes\@ssm\loadobj</a>                       -  is called by the load function for user objects.
 %   <a href="matlab:help classes\@ssm\loglikelihood">classes\@ssm\loglikelihood</a>                 - LOGLIKELIHOOD: Compute log-likelihood for SSM objects
 %   <a href="matlab:help classes\@ssm\loglikelihood_core">classes\@ssm\loglikelihood_core</a>            - LOGLIKELIHOOD: Compute log-likelihood for SSM objects
+%   <a href="matlab:help classes\@ssm\loglikelihoodGradient">classes\@ssm\loglikelihoodGradient</a>         - LOGLIKELIHOODGRADIENT: Compute the log-likelihood of SSM objects and its gradient
 %   <a href="matlab:help classes\@ssm\modelHelper_checkParameters">classes\@ssm\modelHelper_checkParameters</a>   -  compare the user requested parameter names to
 %   <a href="matlab:help classes\@ssm\modelHelper_declareParameters">classes\@ssm\modelHelper_declareParameters</a> -  builds parameters plists for the ssm params field.
 %   <a href="matlab:help classes\@ssm\modelHelper_processInputPlist">classes\@ssm\modelHelper_processInputPlist</a> -  processes the input parameters plists for
@@ -57,6 +60,7 @@
 %   <a href="matlab:help classes\@ssm\removeEmptyBlocks">classes\@ssm\removeEmptyBlocks</a>             -  enables to do model simplification
 %   <a href="matlab:help classes\@ssm\reorganize">classes\@ssm\reorganize</a>                    - REOGANIZE rearranges a ssm object for fast input to BODE, SIMULATE, PSD.
 %   <a href="matlab:help classes\@ssm\reshuffle">classes\@ssm\reshuffle</a>                     -  rearragnes a ssm object using the given inputs and outputs.
+%   <a href="matlab:help classes\@ssm\responseDerivatives">classes\@ssm\responseDerivatives</a>           - computes the parameter derivatives of the frequency response.
 %   <a href="matlab:help classes\@ssm\reshuffleSym">classes\@ssm\reshuffleSym</a>                  -  rearragnes a ssm object using the given inputs and outputs.
 %   <a href="matlab:help classes\@ssm\resp">classes\@ssm\resp</a>                          -  gives the timewise impulse response of a statespace model.
 %   <a href="matlab:help classes\@ssm\respcst">classes\@ssm\respcst</a>                       -  gives the timewise impulse response of a statespace model.
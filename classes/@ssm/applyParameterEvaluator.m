@@ -0,0 +1,37 @@
+% APPLYPARAMETEREVALUATOR sets numeric matrices for a parameter vector.
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION: APPLYPARAMETEREVALUATOR evaluates the matrices described by
+%              an evaluator built with buildParameterEvaluator and sets them
+%              on the given model. Only the blocks which depend on a
+%              parameter that changed since the last call are re-evaluated.
+%
+% CALL:        ev = applyParameterEvaluator(sys, ev, xn)
+%
+% INPUTS:      sys - the ssm object to set the numeric matrices on
+%              ev  - the evaluator structure
+%              xn  - the parameter values, in the order of ev.params
+%
+% OUTPUTS:     ev  - the updated evaluator, to be passed to the next call
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function ev = applyParameterEvaluator(sys, ev, xn)
+  
+  xn      = reshape(xn, 1, []);
+  changed = (xn ~= ev.x);
+  
+  for kk = 1:numel(ev.blocks)
+    b = ev.blocks(kk);
+    if any(changed & b.deps)
+      ev.mats.(b.field){b.index} = b.fcn(xn);
+    end
+  end
+  ev.x = xn;
+  
+  sys.setA(ev.mats.amats);
+  sys.setB(ev.mats.bmats);
+  sys.setC(ev.mats.cmats);
+  sys.setD(ev.mats.dmats);
+  
+end
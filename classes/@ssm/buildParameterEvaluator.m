@@ -0,0 +1,127 @@
+% BUILDPARAMETEREVALUATOR builds a numeric evaluator of the system matrices.
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION: BUILDPARAMETEREVALUATOR translates the symbolic blocks of the
+%              A, B, C and D matrices into anonymous functions of a parameter
+%              vector, once per model. The parameters which are not in the
+%              given list are replaced by their current values. Use
+%              applyParameterEvaluator to set numeric matrices on a model
+%              for a given parameter vector without symbolic substitution.
+%
+% CALL:        ev = buildParameterEvaluator(sys, params)
+%
+% INPUTS:      sys    - an ssm object with symbolic (or string) matrices
+%              params - cell array with the names of the parameters to vary
+%
+% OUTPUTS:     ev     - the evaluator structure, with fields:
+%                       params  - the parameter names
+%                       blocks  - struct array with the matrix field name,
+%                                 the block index, the anonymous function
+%                                 and the parameters it depends on
+%                       mats    - the current numeric matrices
+%                       x       - the last parameter vector (NaN if none)
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function ev = buildParameterEvaluator(sys, params)
+  
+  if ischar(params)
+    params = {params};
+  end
+  
+  % the parameter names are matched regardless of case, as in
+  % doSubsParameters, and the matrices use the names of the system
+  sysNames = sys.params.getKeys;
+  symNames = params;
+  for jj = 1:numel(params)
+    idx = find(strcmpi(params{jj}, sysNames), 1);
+    if isempty(idx)
+      warning(['### parameter named ' params{jj} ' was not found in system ' sys.name])
+    else
+      symNames{jj} = sysNames{idx};
+    end
+  end
+  
+  % values of the parameters which are kept fixed
+  fixedNames  = {};
+  fixedValues = {};
+  for jj = 1:numel(sysNames)
+    if ~any(strcmpi(params, sysNames{jj}))
+      val = sys.params.params(jj).getVal;
+      if isa(val, 'plist')
+        val = find(val, 'value');
+      end
+      fixedNames{end+1}  = sysNames{jj}; %#ok<AGROW>
+      fixedValues{end+1} = sprintf('(%.17g)', val); %#ok<AGROW>
+    end
+  end
+  
+  fields = {'amats', 'bmats', 'cmats', 'dmats'};
+  blocks = struct('field', {}, 'index', {}, 'fcn', {}, 'deps', {});
+  mats   = struct();
+  
+  for ff = 1:numel(fields)
+    m = sys.(fields{ff});
+    for kk = 1:numel(m)
+      if isempty(m{kk}) || isnumeric(m{kk})
+        continue
+      end
+      expr = mat2expr(m{kk});
+      
+      % fixed parameters become constants
+      for jj = 1:numel(fixedNames)
+        expr = regexprep(expr, ['\<' fixedNames{jj} '\>'], fixedValues{jj});
+      end
+      
+      % varied parameters become elements of the parameter vector
+      deps = false(1, numel(params));
+      for jj = 1:numel(params)
+        pat = ['\<' symNames{jj} '\>'];
+        if ~isempty(regexp(expr, pat, 'once'))
+          deps(jj) = true;
+          expr = regexprep(expr, pat, sprintf('pvec__(%d)', jj));
+        end
+      end
+      
+      fcn = str2func(['@(pvec__) ' expr]);
+      if any(deps)
+        blocks(end+1) = struct('field', fields{ff}, 'index', kk, 'fcn', fcn, 'deps', deps); %#ok<AGROW>
+      else
+        % constant block, evaluate once
+        m{kk} = fcn([]);
+      end
+    end
+    mats.(fields{ff}) = m;
+  end
+  
+  ev.params = params;
+  ev.blocks = blocks;
+  ev.mats   = mats;
+  ev.x      = nan(1, numel(params));
+  
+end
+
+%--------------------------------------------------------------------------
+% Turn a symbolic or string matrix into a MATLAB expression with
+% element-wise operators (as in doSubsParameters).
+%--------------------------------------------------------------------------
+function r = mat2expr(s)
+  
+  if ~ischar(s)
+    s = char(s);
+  end
+  
+  % Maple to MATLAB string conversion
+  r = s;
+  r(strfind(r,' ')) = [];
+  r = strrep(r,'matrix([[','['); r = strrep(r,'array([[','[');
+  r = strrep(r,'vector([','['); r = strrep(r,'],[',';');
+  r = strrep(r,']])',']'); r = strrep(r,'])',']');
+  
+  % '^', '*' or '/'
+  r = strrep(r, '^', '.^');
+  r = strrep(r, '*', '.*');
+  r = strrep(r, '/', './');
+  r(strfind(r,'..')) = [];
+  
+end
@@ -23,13 +23,9 @@ function best = diffStepFish(mdl,data,params,ngrid,ranges,freqs)
   % Copying model
   meval = copy(mdl,1);
   
-  % Defining # of inputs and outputs
-  Nout = numel([meval.outputs(:).ports]);
-  Nin  = size(data.input,2);
-  
   % Init
-  outputs = cell(1,Nout);
-  step = ones(ngrid,numel(params));
+  step  = ones(ngrid,numel(params));
+  cache = [];
   
   for ii = 1:ngrid
     step(ii,:) = ranges(1,:);
@@ -56,46 +52,24 @@ function best = diffStepFish(mdl,data,params,ngrid,ranges,freqs)
     Rmat = [];
     
     for jj = 1:ngrid
-      for ii = 1:length(params)
-        
-        tic
-        % differentiate numerically
-        dH = meval.parameterDiff(plist('names', params(ii),'values',step(jj,ii)));
-        % create plist with correct outNames (since parameterDiff change them)
-        for ll = 1:Nout
-          % create plist with correct outNames (since parameterDiff change them)
-          outputs{ll} = strrep(outNames{ll},'.', sprintf('_DIFF_%s.',params{ii})); % 2x2 case
-        end
-        
-        spl = plist(...
-          'outputs',    outputs, ...
-          'inputs',     inNames, ...
-          'reorganize', true,    ...
-          'f',          freqs);
-        
-        % do bode
-        dd  = bode(dH, spl);
-        
-        % get numbers
-        dd = dd.objs.y;
-        
-        % rearrange the transfer functions
-        d(:,:,:,ii) = reshape(dd,numel(dd(:,1)),Nout,Nin);
-        
+      tic
+      % differentiate numerically. The base response of the model does
+      % not depend on the steps, so it is computed once for the whole grid.
+      [d, cache] = meval.responseDerivatives(params, step(jj,:), inNames, outNames, freqs, cache);
+      
+      % get the templates
+      h = cell(1,length(params));
+      g = cell(1,length(params));
+      for i = 1:length(params)
+        h{i} = utils.math.mult(d(:,:,:,i), data.input);
+        % Multiplying at once produces error.
+        g{i} = utils.math.mult(data.noise, h{i});
       end
       
       % compute Fisher Matrix
       for i =1:length(params)
         for j =1:length(params)
-          
-          % Get the template
-          h = utils.math.mult(d(:,:,:,i), data.input);
-          
-          % Multiplying at once produces error.
-          g = utils.math.mult(data.noise, utils.math.mult(d(:,:,:,j), data.input));
-          
-          FisMat(i,j) = sum(real(utils.math.ctmult(h , g)));
-          
+          FisMat(i,j) = sum(real(utils.math.ctmult(h{i} , g{j})));
         end
       end
       
@@ -25,6 +25,9 @@ function varargout = doBode(a, b, c, d, w, Ts)
         f_disc = f*Ts;
         % Compute z = e^jw (with w discrete)
         z = exp(1i*2*pi*f_disc);
+    else
+        % Laplace variable s = jw
+        z = 2*pi*1i*f;
     end
 
     %% getting matrices properly ordered
@@ -49,32 +52,15 @@ function varargout = doBode(a, b, c, d, w, Ts)
     reduce_a = a;
     reduce_c = c;
 
-    %% loop on inputs
-    if (Ts == 0)
-        for ii=1:Ni
-            reduce_b = b(:,ii);
-            reduce_d = d(:,ii);
-            [num,den] = ss2tf(reduce_a,reduce_b,reduce_c,reduce_d);
-            denr = polyval(den, 2*pi*1i*f);
-            for jj = 1:No
-                numr = polyval(num(jj,:), 2*pi*1i*f);
-                G(jj,ii,:) = numr./denr;
-            end
-        end
-    else
-        [T,H]=hess(reduce_a);
-        % Step 1:
-        P = reduce_c*T;
-        reduce_b = b(:,1:Ni);
-        reduce_d = d(1:No,1:Ni);
-        Q = T'*reduce_b;
-        I = eye(size(reduce_a));
-
-        %% time discrete
-        for ff = 1:length(f)
-            G(1:No,1:Ni,ff) = (P/(z(ff)*I - H))*(Q) + reduce_d;
-        end
-    end
+    %% all inputs at once, for time continuous and time discrete systems
+    [T,H]=hess(reduce_a);
+    % Step 1:
+    P = reduce_c*T;
+    reduce_b = b(:,1:Ni);
+    reduce_d = d(1:No,1:Ni);
+    Q = T'*reduce_b;
+
+    G = hessResponse(H, P, Q, reduce_d, z);
 
     %% execute warnings
     [msg, msgid] = lastwarn;
@@ -87,4 +73,26 @@ function varargout = doBode(a, b, c, d, w, Ts)
     varargout = {G};
 end
 
+%--------------------------------------------------------------------------
+% Response P*(z*I - H)^-1*Q + D of the Hessenberg form for all values of z,
+% with z = exp(jw*Ts) for discrete systems and z = jw for continuous ones.
+% The compiled solver runs the frequency loop in C, in parallel; the MATLAB
+% loop is kept as a fallback when the mex file is not available.
+%--------------------------------------------------------------------------
+function G = hessResponse(H, P, Q, D, z)
+
+    if exist('ltpda_ssmbode', 'file') == 3 && ...
+            isreal(H) && isreal(P) && isreal(Q) && isreal(D)
+        G = ltpda_ssmbode(H, full(P), full(Q), full(D), z);
+    else
+        No = size(P,1);
+        Ni = size(Q,2);
+        G  = zeros(No,Ni,numel(z));
+        I  = eye(size(H));
+        for ff = 1:numel(z)
+            G(1:No,1:Ni,ff) = (P/(z(ff)*I - H))*(Q) + D;
+        end
+    end
+end
+
 
@@ -3,10 +3,23 @@
 %
 % DESCRIPTION: DOSIMULATE simulates a discrete ssm with given inputs.
 %
-% CALL:  [x, y, lastX] = doSimulate(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep)
+% CALL:  [x, y, lastX] = doSimulate(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, forceComplete)
+%        [x, y, lastX] = doSimulate(..., forceComplete, Ndecim, avgDecim)
+%        [x, y, lastX] = doSimulate(..., forceComplete, Ndecim, avgDecim, seed)
 %
 % INPUTS:
 %
+%        Ndecim   - (optional) only one out of Ndecim samples is stored in
+%                   x and y. A trailing partial block is not stored.
+%        avgDecim - (optional) if true, the stored sample is the mean over
+%                   each block of Ndecim samples instead of its first sample.
+%        seed     - (optional) seed of the white noise inputs. The noise
+%                   is drawn on the fly from a counter-based generator
+%                   keyed on this seed, by the mex file or by
+%                   utils.math.philoxrandn, so that both give the same
+%                   noise. When empty, a seed is drawn from the global
+%                   MATLAB random stream.
+%
 % OUTPUTS:
 %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -17,56 +30,117 @@
 % allow use of other LTPDA functions to generate white noise
 
 
-function [x, y, lastX] = doSimulate(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, forceComplete)
-  
-  % We do a simple simulate if all these are satisfied:
-  % 1) Bnoise is empty or all zeros
-  % 2) Cstates is empty
-  % 3) Dnoise is empty or all zeros
-  % 4) Bcst is empty or all zeros
-  % 5) Dcst is empty or all zeros
-  % 6) doTerminate is false
-  
-  if  (isempty(Bnoise) || all(all(Bnoise==0))) && ...
-      isempty(Cstates) && ...
-      (isempty(Dnoise) || all(all(Dnoise==0))) && ...
-      (isempty(Bcst) || all(all(Bcst==0))) && ...
+function [x, y, lastX] = doSimulate(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, forceComplete, Ndecim, avgDecim, seed)
+  
+  persistent mexOK
+  
+  if nargin < 18 || isempty(Ndecim)
+    Ndecim = 1;
+  end
+  if nargin < 19 || isempty(avgDecim)
+    avgDecim = false;
+  end
+  if nargin < 20
+    seed = [];
+  end
+  if Ndecim < 1 || Ndecim ~= round(Ndecim)
+    error('### The decimation factor must be a positive integer');
+  end
+  
+  hasNoise = ~(isempty(Bnoise) || all(all(Bnoise==0))) || ...
+    ~(isempty(Dnoise) || all(all(Dnoise==0)));
+  
+  % We do a fast simulate if all these are satisfied:
+  % 1) Bcst is empty or all zeros
+  % 2) Dcst is empty or all zeros
+  % 3) doTerminate is false
+  % Noise inputs are drawn inside the mex file.
+  
+  if  (isempty(Bcst) || all(all(Bcst==0))) && ...
       (isempty(Dcst) || all(all(Dcst==0))) && ...
       ~doTerminate && ...
       ~forceComplete
     % do a fast simulation
     Nstates = numel(SSini);
     
-    if Nstates >= 100
-      % except if Matlab is faster
-      [x,y,lastX] = doSimulateSimple(SSini, Nsamples, A, Baos, Coutputs, Daos, aos_vect, displayTime);
-    else
+    % the mex file must have the decimation and noise inputs, check its
+    % version once and remember it, as we may be called in loops
+    if isempty(mexOK)
+      mexOK = checkMex();
+    end
+    
+    if ~hasNoise && (Nstates >= 100 || ~mexOK)
+      % except if Matlab is faster, or the mex file is out of date
+      [x,y,lastX] = doSimulateSimple(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, aos_vect, displayTime, Ndecim, avgDecim);
+    elseif ~hasNoise
       try
         % call to the mex file
-        x = [];
-        [y,lastX] = ltpda_ssmsim(SSini, A.', Coutputs.', Cstates.', Baos.', Daos.', aos_vect);
+        [y,lastX,x] = ltpda_ssmsim(SSini, A.', Coutputs.', Cstates.', Baos.', Daos.', aos_vect, Ndecim, double(avgDecim));
       catch
-        % backup if the mex-file is broken
+        % backup if the mex-file is broken, only warn once
         warning('Failed to run mex file ltpda_ssmsim');
-        [x,y,lastX] = doSimulateSimple(SSini, Nsamples, A, Baos, Coutputs, Daos, aos_vect, displayTime);
+        mexOK = false;
+        [x,y,lastX] = doSimulateSimple(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, aos_vect, displayTime, Ndecim, avgDecim);
+      end
+    else
+      if isempty(seed)
+        seed = randi([0 2^32-1]);
+      end
+      if mexOK
+        try
+          % call to the mex file, the noise is generated on the fly
+          [y,lastX,x] = ltpda_ssmsim(SSini, A.', Coutputs.', Cstates.', Baos.', Daos.', aos_vect, Ndecim, double(avgDecim), ...
+            full(Bnoise).', full(Dnoise).', seed);
+        catch
+          % backup if the mex-file is broken, only warn once
+          warning('Failed to run mex file ltpda_ssmsim');
+          mexOK = false;
+        end
+      end
+      if ~mexOK
+        [x,y,lastX] = doSimulateComplete(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, Ndecim, avgDecim, seed);
       end
     end
   else
     % the standard old script, more complete (DC and noise inputs)
-    [x,y,lastX] = doSimulateComplete(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep);
+    [x,y,lastX] = doSimulateComplete(SSini, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, Ndecim, avgDecim, seed);
   end
   
 end
 
 
-function [x,y,lastX] = doSimulateSimple(lastX, Nsamples, A, Baos, Coutputs, Daos, aos_vect, displayTime)
+%--------------------------------------------------------------------------
+% Check that the mex file ltpda_ssmsim is there and has the 9- and
+% 12-argument forms, which came with its version 1.3
+%--------------------------------------------------------------------------
+function ok = checkMex()
+  
+  ok = false;
+  if exist('ltpda_ssmsim', 'file') == 3
+    try
+      ok = str2double(ltpda_ssmsim('version')) >= 1.3;
+    end
+  end
+  if ~ok
+    warning('### The mex file ltpda_ssmsim is missing or out of date, simulating in MATLAB');
+  end
+  
+end
+
+function [x,y,lastX] = doSimulateSimple(lastX, Nsamples, A, Baos, Coutputs, Cstates, Daos, aos_vect, displayTime, Ndecim, avgDecim)
   
   if displayTime
     disp('Running simulate simple...');
   end
   % initializing fields
-  x = [];
-  y = zeros(size(Coutputs,1), Nsamples);
+  Nrecord = floor(Nsamples/Ndecim);
+  x = zeros(size(Cstates,1), Nrecord);
+  y = zeros(size(Coutputs,1), Nrecord);
+  if avgDecim
+    scale = 1/Ndecim;
+  else
+    scale = 1;
+  end
   
   % state equations are
   % x(k+1) = A*x(k) + B*u(k)
@@ -85,15 +159,19 @@ function [x,y,lastX] = doSimulateSimple(lastX, Nsamples, A, Baos, Coutputs, Daos
   
   % simulation loop
   for k = 1:Nsamples
-    % computing and storing outputs
-    y(:,k) = Coutputs*lastX + Daos*aos_vect(:,k);
+    % computing and storing outputs for the samples we keep
+    kd = ceil(k/Ndecim);
+    if kd <= Nrecord && (avgDecim || mod(k-1, Ndecim) == 0)
+      y(:,kd) = y(:,kd) + scale*(Coutputs*lastX + Daos*aos_vect(:,k));
+      x(:,kd) = x(:,kd) + scale*(Cstates*lastX);
+    end
     % computing and storing states
     lastX  = A*lastX + Baos*aos_vect(:,k);
   end
   
 end
 
-function [x,y,lastX] = doSimulateComplete(lastX, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep)
+function [x,y,lastX] = doSimulateComplete(lastX, Nsamples, A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst, aos_vect, doTerminate, terminationCond, displayTime, timestep, Ndecim, avgDecim, seed)
   
   if displayTime 
     disp('Running simulate complete...');
@@ -111,9 +189,18 @@ function [x,y,lastX] = doSimulateComplete(lastX, Nsamples, A, Baos, Coutputs, Cs
   if numel(Dcst)>0; if(sum(sum(Dcst==0))/numel(Dcst))>0.5; Dcst = sparse(Dcst); end, end
   
   %% initializing fields
-  x = zeros(size(Cstates,1), Nsamples);
-  y = zeros(size(Coutputs,1), Nsamples);
+  Nrecord = floor(Nsamples/Ndecim);
+  x = zeros(size(Cstates,1), Nrecord);
+  y = zeros(size(Coutputs,1), Nrecord);
+  if avgDecim
+    scale = 1/Ndecim;
+  else
+    scale = 1;
+  end
   Nnoise = size(Bnoise,2);
+  if isempty(seed)
+    seed = randi([0 2^32-1]);
+  end
   BLOCK_SIZE = min( [ floor(1e6/(size(Baos,2) + size(Baos,1) + size(Bnoise,2) + 1)) , Nsamples]);
  
   BLOCK_N   = 10;
@@ -146,7 +233,8 @@ function [x,y,lastX] = doSimulateComplete(lastX, Nsamples, A, Baos, Coutputs, Cs
   for kk = 1:Nsamples
     %% writing white noise and displaying time
     if mod(kk-1, BLOCK_SIZE) == 0
-       noise_array = randn(Nnoise, BLOCK_SIZE);
+       % the noise of the sample kk is the one of the mex file
+       noise_array = utils.math.philoxrandn(seed, kk-1:kk+BLOCK_SIZE-2, 0, Nnoise);
       if displayTime
         display( ['         simulation time : ',num2str(kk*timestep) ]);
         time2 = time;
@@ -161,24 +249,33 @@ function [x,y,lastX] = doSimulateComplete(lastX, Nsamples, A, Baos, Coutputs, Cs
       if knoise == 0, knoise = BLOCK_SIZE; end
       noise = noise_array(:, knoise);
     else
-      noise = randn(Nnoise, 1);
+      noise = utils.math.philoxrandn(seed, kk-1, 0, Nnoise);
     end
     
     %% computing and storing outputs
-     y(:,kk) = Coutputs*lastX +  Dcst + Dnoise*noise + Daos*aos_vect(:,kk);
+    kd = ceil(kk/Ndecim);
+    if kd <= Nrecord && (avgDecim || mod(kk-1, Ndecim) == 0)
+      y(:,kd) = y(:,kd) + scale*(Coutputs*lastX +  Dcst + Dnoise*noise + Daos*aos_vect(:,kk));
+      x(:,kd) = x(:,kd) + scale*(Cstates*lastX);
+    end
 %     noise_array = randn(Nnoise, 1);
 %     y(:,k) = Coutputs*lastX +  Dcst + Dnoise*noise_array + Daos*aos_vect(:,k);
     
     %% computing and storing states
-    x(:,kk) = Cstates*lastX;
    lastX  = A*lastX +  Bcst + Bnoise*noise + Baos*aos_vect(:,kk);
 %     lastX  = A*lastX +  Bcst + Bnoise*noise_array + Baos*aos_vect(:,k);
     
     %% checking possible termination condition
     if doTerminate
       if eval(terminationCond)
-        x = x(:,1:kk);
-        y = y(:,1:kk);
+        % a partially averaged block is dropped
+        if avgDecim
+          Nkept = min(floor(kk/Ndecim), Nrecord);
+        else
+          Nkept = min(kd, Nrecord);
+        end
+        x = x(:,1:Nkept);
+        y = y(:,1:Nkept);
         break;
       end
     end
@@ -18,7 +18,6 @@ function [FMall, dstep] = fisher(mdl,data,params,values,lp,freqs,dstep,ngrid,ran
   
   import utils.const.*
   
-  Nin  = size(data(1).input,2);
   con  = ones(1,numel(params));
   Nexp = numel(data);
   
@@ -35,10 +34,6 @@ function [FMall, dstep] = fisher(mdl,data,params,values,lp,freqs,dstep,ngrid,ran
   % Setting parameter values
   meval.doSetParameters(params, values);
   
-  % Defining # of inputs and outputs
-  Nout    = numel([meval.outputs(:).ports]);
-  outputs = cell(1,Nout);
-  
   % Checking if freqs is a cell array
   if isnumeric(freqs)
     freqs = {freqs};
@@ -84,51 +79,30 @@ function [FMall, dstep] = fisher(mdl,data,params,values,lp,freqs,dstep,ngrid,ran
     
     utils.helper.msg(msg.PROC1, sprintf('Analysis of experiment #%d',kk), mfilename('class'), mfilename);
     
-    % Differentiate and eval
+    utils.helper.msg(msg.PROC1, ...
+      sprintf('computing numerical differentiation with respect to %d parameters', numel(params)), mfilename('class'), mfilename);
+    
+    % Differentiate numerically, all parameters at once
+    d = meval.responseDerivatives(params, dstep, inNames, outNames, freqs{kk});
     for ii = 1:length(params)
-      
-      utils.helper.msg(msg.PROC1, ...
-        sprintf('computing numerical differentiation with respect %s, Step:%4.2d ',params{ii},dstep(ii)), mfilename('class'), mfilename);
-      
-      % Differentiate numerically
-      dH = meval.parameterDiff(plist('names', params(ii),'values',dstep(ii)));
-      
-      for jj = 1:Nout
-        % Create plist with correct outNames (since parameterDiff change them)
-        outputs{jj} = strrep(outNames{jj},'.', sprintf('_DIFF_%s.',params{ii}));
-      end
-      
-      spl = plist(...
-        'outputs',    outputs, ...
-        'inputs',     inNames, ...
-        'reorganize', true,    ...
-        'f',          freqs{kk});
-      
-      % Bode
-      dd  = bode(dH, spl);
-      
-      % Get numbers
-      dd = con(ii)*dd.objs.y;
-      
-      % Re-arrange the transfer functions
-      d(:,:,:,ii) = reshape(dd,numel(dd(:,1)),Nout,Nin);
-      
+      d(:,:,:,ii) = con(ii)*d(:,:,:,ii);
     end
     
     FisMat = zeros(length(params));
     
+    % Get the templates, once per parameter
+    h = cell(1,length(params));
+    g = cell(1,length(params));
+    for ii = 1:length(params)
+      h{ii} = utils.math.mult(d(:,:,:,ii), data(kk).input);
+      % Multiplying at once produces error.
+      g{ii} = utils.math.mult(data(kk).noise, h{ii});
+    end
+    
     % Compute Fisher Matrix (only upper triangle, it must be symmetric)
     for ii =1:length(params)
       for jj =ii:length(params)
-        
-        % Get the template
-        h = utils.math.mult(d(:,:,:,ii), data(kk).input);
-        
-        % Multiplying at once produces error.
-        g = utils.math.mult(data(kk).noise, utils.math.mult(d(:,:,:,jj), data(kk).input));
-        
-        FisMat(ii,jj) = sum(real(utils.math.ctmult(h , g)));
-        
+        FisMat(ii,jj) = sum(real(utils.math.ctmult(h{ii}, g{jj})));
       end
     end
     
@@ -160,12 +160,7 @@ function varargout = kalman(varargin)
   Rn = DnoiseK*noise_in*transpose(DnoiseK);
   Rn = Rn + 1e-10*norm(Rn)*eye(size(Rn));
   %   Nn = Bnoise*noise_in*transpose(Dnoise);
-  P = eye(size(A))*1e20;
-  for i=1:10000
-    P = A*P*A'+Qn;
-    K = P*CoutputsK'*(CoutputsK*P*CoutputsK'+Rn)^-1;
-    P = (eye(size(A)) - K*CoutputsK)*P;
-  end
+  [K, P] = steadyStateGain(A, CoutputsK, Qn, Rn, find(pl, 'Riccati tolerance'));
   Z = Coutputs*P*Coutputs' + Rn;
   
   %% constant vector
@@ -264,6 +259,60 @@ function varargout = kalman(varargin)
   end
 end
 
+%--------------------------------------------------------------------------
+% Steady-state Kalman gain K and filtered state covariance P, from the
+% stabilising solution of the discrete algebraic Riccati equation
+%   X = A*X*A' - A*X*C'*(C*X*C' + Rn)^-1*C*X*A' + Qn
+% The last solution is kept, so that repeated calls with the same model and
+% noise skip the solve.
+%--------------------------------------------------------------------------
+function [K, P] = steadyStateGain(A, C, Qn, Rn, tol)
+
+  persistent cache
+
+  if ~isempty(cache) && cache.tol == tol && isequal(cache.A, A) && ...
+      isequal(cache.C, C) && isequal(cache.Qn, Qn) && isequal(cache.Rn, Rn)
+    K = cache.K;
+    P = cache.P;
+    return
+  end
+
+  maxit = 100;
+  if exist('ltpda_dare', 'file') == 3
+    X = ltpda_dare(full(A), full(C), full(Qn), full(Rn), tol, maxit);
+  else
+    % structured doubling algorithm, see ltpda_dare
+    I  = eye(size(A));
+    Ak = A';
+    Gk = C'*(Rn\C);
+    Gk = (Gk + Gk')/2;
+    X  = Qn;
+    converged = false;
+    for ii=1:maxit
+      W  = I + Gk*X;
+      Y1 = W\Ak;
+      dX = Ak'*(X*Y1);
+      dX = (dX + dX')/2;
+      X  = X + dX;
+      Gk = Gk + Ak*(W\Gk)*Ak';
+      Gk = (Gk + Gk')/2;
+      Ak = Ak*Y1;
+      if norm(dX, 1) <= tol*norm(X, 1)
+        converged = true;
+        break
+      end
+    end
+    if ~converged
+      warning('### the Riccati solution did not converge within the maximum number of iterations');
+    end
+  end
+
+  K = X*C'/(C*X*C' + Rn);
+  P = (eye(size(A)) - K*C)*X;
+
+  cache = struct('A', A, 'C', C, 'Qn', Qn, 'Rn', Rn, 'tol', tol, 'K', K, 'P', P);
+end
+
 %--------------------------------------------------------------------------
 % Get Info Object
 %--------------------------------------------------------------------------
@@ -320,6 +369,9 @@ function pl = getDefaultPlist()
   p = param({'force complete', 'Force the use of the complete simulation code.'}, paramValue.FALSE_TRUE);
   pl.append(p);
   
+  p = param({'Riccati tolerance', 'The relative tolerance on the convergence of the steady-state Riccati solution.'}, paramValue.DOUBLE_VALUE(1e-12));
+  pl.append(p);
+  
   
 end
 
@@ -0,0 +1,127 @@
+% LOGLIKELIHOODGRADIENT: Compute the log-likelihood of SSM objects and its gradient
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Compute the log-likelihood of loglikelihood_core and its gradient with
+% respect to the parameters, for the gradient-based samplers of MCMC.
+%
+% With the residual r = out - H*in and the inverse cross-spectrum S, the
+% log-likelihood is logL = -0.5*sum_f r'*S*r, so that
+%
+%   dlogL/dp = sum_f real((dH/dp*in)'*S*r).
+%
+% H and dH/dp are both taken from responseDerivatives: the base response
+% is computed once per call and shared by all parameters and experiments
+% with the same frequencies. As in loglikelihood_core, the symbolic
+% matrices are translated once per model and parameter list.
+%
+% [LLH GRAD SNR LLHexp] = loglikelihoodGradient(model, xn, data, params, lp, spl);
+%
+% INPUTS:   model     - The symbolic SSM system.
+%           xn        - The parameter values (vector).
+%           data      - The data (in, out, noise) in a structure array.
+%           params    - Cell array with the parameter names.
+%           lp        - A vector of zeros and ones, denoting the position
+%                       of a log-parameter.
+%           spl       - The bode plists of the experiments.
+%
+% OUTPUTS:  LLH    - The LLH value for all experiments.
+%           GRAD   - The gradient of LLH with respect to xn (row vector).
+%                    The log-parameters are differentiated in log-space.
+%           SNR    - The SNR value for all experiments.
+%           LLHexp - The LLH value for each experiment.
+%
+
+function varargout = loglikelihoodGradient(varargin)
+
+  persistent processedModel
+  persistent sourceModel
+  persistent evaluator
+
+  system = varargin{1};
+  xn     = varargin{2};
+  data   = varargin{3};
+  params = varargin{4};
+  lp     = varargin{5};
+  spl    = varargin{6};
+
+  Np   = numel(params);
+  Nexp = numel(data);
+  con  = ones(1, Np);
+
+  % Checking for parameters in log-space
+  ind     = find(lp == 1);
+  xn(ind) = exp(xn(ind));
+  con(ind) = xn(ind);
+
+  if isempty(processedModel) || ~strcmp(sourceModel, system.UUID) || ...
+      isempty(evaluator) || ~isequal(evaluator.params, params)
+    processedModel = copy(system, 1);
+    sourceModel = system.UUID;
+    evaluator = system.buildParameterEvaluator(params);
+  end
+  processedModel.doSetParameters(params, xn);
+
+  % Differentiation step of the system matrices
+  dstep = sqrt(eps)*max(abs(xn), 1);
+
+  logL    = 0;
+  grad    = zeros(1, Np);
+  snr     = 0;
+  logLexp = zeros(1, Nexp);
+
+  cache = [];
+  f0    = [];
+  for k = 1:Nexp
+
+    f        = spl(k).find('f');
+    inNames  = spl(k).find('inputs');
+    outNames = spl(k).find('outputs');
+
+    % The base response can be reused between experiments with the same
+    % frequencies
+    if ~isequal(f, f0)
+      cache = struct('evaluator', evaluator);
+    end
+    [d, cache] = processedModel.responseDerivatives(params, dstep, inNames, outNames, f, cache);
+    evaluator = cache.evaluator;
+    f0 = f;
+
+    Nf   = numel(cache.z);
+    Nout = size(cache.C, 1);
+    Nin  = size(cache.B, 2);
+
+    % The transfer functions, arranged as in loglikelihood_core
+    hmat = zeros(Nf, Nout, Nin);
+    for ff = 1:Nf
+      hmat(ff,:,:) = cache.C*cache.X(:,:,ff) + cache.D;
+    end
+
+    in  = data(k).input;
+    out = data(k).output;
+    S   = data(k).noise;
+
+    [logLexp(k), snrexp] = utils.math.loglikelihood(in, out, S, hmat);
+    logL = logL - 0.5.*logLexp(k);
+    snr  = snr + snrexp;
+
+    % S*r at each frequency
+    Sr = utils.math.mult(S, out - utils.math.mult(hmat, in));
+
+    for ii = 1:Np
+      dh       = utils.math.mult(d(:,:,:,ii), in);
+      grad(ii) = grad(ii) + sum(real(utils.math.ctmult(dh, Sr)));
+    end
+
+  end
+
+  % Chain rule for the log-parameters
+  grad = grad.*con;
+
+  varargout{1} = logL;
+  varargout{2} = grad;
+  varargout{3} = snr;
+  varargout{4} = -0.5.*logLexp;
+
+end
+
+% END
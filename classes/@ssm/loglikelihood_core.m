@@ -10,7 +10,9 @@
 %
 % INPUTS:   model     - The symbolic SSM system.
 %           data      - The data (in, out, noise) in a structure array.
-%           xn        - The parameter values (vector).
+%           xn        - The parameter values (vector), or a block of
+%                       parameter values with one point per row. The
+%                       outputs then have one row per point.
 %           params    - Cell array with the parameter names.
 %           freqs     - The frequencies of the analysis.
 %           lp        - A vector of zeros and ones, denoting the position.
@@ -28,6 +30,7 @@ function varargout = loglikelihood_core(varargin)
   
   persistent processedModel
   persistent sourceModel
+  persistent evaluator
   
   system = varargin{1};
   xn     = varargin{2};
@@ -40,50 +43,51 @@ function varargout = loglikelihood_core(varargin)
   Nout = numel(data(1).output(1,:));
   Nin  = numel(data(1).input(1,:));
   Nexp = numel(data);
-  logL = 0;
-  snr  = 0;
+  K    = size(xn,1);
+  logL = zeros(K,1);
+  snr  = zeros(K,1);
   
   % Checking for parameters in log-space
   ind = find(lp == 1);
-  xn(ind) = exp(xn(ind));
-  logLexp = zeros(1,Nexp);
-  snrexp  = zeros(1,Nexp);
-  Lf      = cell(1, Nexp);
+  xn(:,ind) = exp(xn(:,ind));
+  logLexp = zeros(K,Nexp);
+  snrexp  = zeros(K,Nexp);
+  Lf      = cell(K, Nexp);
   
-  if isempty(processedModel) || ~strcmp(sourceModel, system.UUID)
+  if isempty(processedModel) || ~strcmp(sourceModel, system.UUID) || ...
+      isempty(evaluator) || ~isequal(evaluator.params, params)
     disp('copying system...');
     processedModel = copy(system, 1);
     sourceModel = system.UUID;
+    % Translate the symbolic matrices once; each step then only evaluates
+    % the blocks which depend on the parameters that changed.
+    evaluator = system.buildParameterEvaluator(params);
   end
   
-  for k = 1:Nexp
+  for kk = 1:K
     
-    processedModel.setA(system.amats);
-    processedModel.setB(system.bmats);
-    processedModel.setC(system.cmats);
-    processedModel.setD(system.dmats);
+    % Make numeric. The parameters are the same for all experiments.
+    evaluator = processedModel.applyParameterEvaluator(evaluator, xn(kk,:));
     
-    % Set parameter values
-    processedModel.doSetParameters(params, xn);
-    
-    % Make numeric
-    processedModel.doSubsParameters(params, true);
-    
-    % Do bode
-    h  = bode(processedModel, spl(k));
-    
-    % Get numbers
-    h  = h.objs.y;
-    
-    % Re-arrange the transfer functions according to Nin, Nout...
-    hmat      = reshape(h,numel(h(:,1)),Nout,Nin);
-    
-    % Calculate the log-likelihood
-    [logLexp(k), snrexp(k), Lf{k}] = utils.math.loglikelihood(data(k).input, data(k).output, data(k).noise, hmat);
-    
-    logL = logL -0.5.*logLexp(k);
-    
-    snr  = snr + snrexp(k);
+    for k = 1:Nexp
+      
+      % Do bode
+      h  = bode(processedModel, spl(k));
+      
+      % Get numbers
+      h  = h.objs.y;
+      
+      % Re-arrange the transfer functions according to Nin, Nout...
+      hmat      = reshape(h,numel(h(:,1)),Nout,Nin);
+      
+      % Calculate the log-likelihood
+      [logLexp(kk,k), snrexp(kk,k), Lf{kk,k}] = utils.math.loglikelihood(data(k).input, data(k).output, data(k).noise, hmat);
+      
+      logL(kk) = logL(kk) -0.5.*logLexp(kk,k);
+      
+      snr(kk)  = snr(kk) + snrexp(kk,k);
+      
+    end
     
   end
   
@@ -0,0 +1,187 @@
+% RESPONSEDERIVATIVES computes the parameter derivatives of the frequency response.
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% DESCRIPTION: RESPONSEDERIVATIVES computes the derivatives of the transfer
+%              functions from the given inputs to the given outputs with
+%              respect to each of the given parameters, for all parameters
+%              at once.
+%
+%              The system matrices are differentiated by forward
+%              differences, as in parameterDiff. For H = C*(zI-A)^-1*B + D,
+%
+%                dH/dp = dC*X + Y*dA*X + Y*dB + dD,
+%
+%              with X = (zI-A)^-1*B and Y = C*(zI-A)^-1. X and Y form the
+%              base response: they are computed once per frequency on the
+%              Hessenberg form of A and shared by all parameters, instead of
+%              one bode of a system of twice the size per parameter. The
+%              products of all the parameters are evaluated together.
+%
+%              The base response does not depend on the steps, so it is
+%              returned in a cache which can be passed to later calls with
+%              other steps (e.g. in diffStepFish). A cache holding only the
+%              'evaluator' field of buildParameterEvaluator computes the
+%              base response without translating the symbolic matrices.
+%
+% CALL:        [d, cache] = responseDerivatives(sys, params, dstep, inNames, outNames, freqs)
+%              [d, cache] = responseDerivatives(sys, params, dstep, inNames, outNames, freqs, cache)
+%
+% INPUTS:      sys      - the ssm object, with the nominal parameter values
+%              params   - cell array with the names of the parameters
+%              dstep    - the differentiation step of each parameter
+%              inNames  - cell array with the input port names
+%              outNames - cell array with the output port names
+%              freqs    - the frequencies
+%              cache    - the cache of a previous call on the same model,
+%                         parameters, ports and frequencies, or a
+%                         structure with the evaluator of the model
+%
+% OUTPUTS:     d        - Nfreqs x Nout x Nin x Nparams array with the
+%                         derivatives of the transfer functions
+%              cache    - the base response
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [d, cache] = responseDerivatives(sys, params, dstep, inNames, outNames, freqs, cache)
+
+  if ischar(params)
+    params = {params};
+  end
+  Np = numel(params);
+  if numel(dstep) ~= Np
+    error(['### The number of parameter names is ' num2str(Np) ' and the number of steps is ' num2str(numel(dstep))]);
+  end
+
+  if nargin < 7
+    cache = [];
+  end
+  if isempty(cache) || ~isfield(cache, 'X')
+    cache = baseResponse(sys, params, inNames, outNames, freqs, cache);
+  end
+
+  n    = size(cache.A, 1);
+  Nin  = size(cache.B, 2);
+  Nout = size(cache.C, 1);
+  Nf   = numel(cache.z);
+
+  % Derivatives of the system matrices. The perturbed models are
+  % independent of each other, so they can be evaluated in parallel.
+  dA = zeros(n, n, Np);
+  dB = zeros(n, Nin, Np);
+  dC = zeros(Nout, n, Np);
+  dD = zeros(Nout, Nin, Np);
+
+  ev = cache.evaluator;
+  x0 = cache.x0;
+  parfor ii = 1:Np
+    x     = x0;
+    x(ii) = x(ii) + dstep(ii);
+    [A, B, C, D] = numericMatrices(cache.model, ev, x, inNames, outNames);
+    dA(:,:,ii) = (A - cache.A)/dstep(ii);
+    dB(:,:,ii) = (B - cache.B)/dstep(ii);
+    dC(:,:,ii) = (C - cache.C)/dstep(ii);
+    dD(:,:,ii) = (D - cache.D)/dstep(ii);
+  end
+
+  % Stack the parameters, so that each product below is a single matrix
+  % multiplication for all of them
+  dAv = reshape(permute(dA, [1 3 2]), n*Np, n);
+  dCv = reshape(permute(dC, [1 3 2]), Nout*Np, n);
+  dBh = reshape(dB, n, Nin*Np);
+
+  d = zeros(Nf, Nout, Nin, Np);
+  for ff = 1:Nf
+    X = cache.X(:,:,ff);
+    Y = cache.Y(:,:,ff);
+
+    % dA*X + dB, for all parameters: n x (Nin*Np)
+    W = reshape(permute(reshape(dAv*X, n, Np, Nin), [1 3 2]), n, Nin*Np) + dBh;
+
+    % dC*X, for all parameters: Nout x Nin x Np
+    V = permute(reshape(dCv*X, Nout, Np, Nin), [1 3 2]);
+
+    d(ff,:,:,:) = reshape(Y*W, Nout, Nin, Np) + V + dD;
+  end
+
+end
+
+%--------------------------------------------------------------------------
+% The nominal matrices and the base response X = (zI-A)^-1*B and
+% Y = C*(zI-A)^-1 at all frequencies, computed on the Hessenberg form
+% A = T*H*T' as in doBode
+%--------------------------------------------------------------------------
+function cache = baseResponse(sys, params, inNames, outNames, freqs, cache)
+
+  model = copy(sys, 1);
+  if isempty(cache)
+    ev = model.buildParameterEvaluator(params);
+  else
+    ev = cache.evaluator;
+  end
+  x0    = zeros(1, numel(params));
+  for ii = 1:numel(params)
+    x0(ii) = double(sys.params.find(params{ii}));
+  end
+
+  % Keep the evaluator at the nominal values, so that a perturbed model
+  % only re-evaluates the blocks which depend on the perturbed parameter
+  [A, B, C, D, ev] = numericMatrices(model, ev, x0, inNames, outNames);
+
+  if sys.timestep ~= 0
+    z = exp(1i*2*pi*freqs(:)*sys.timestep);
+  else
+    z = 2*pi*1i*freqs(:);
+  end
+
+  n    = size(A, 1);
+  Nin  = size(B, 2);
+  Nout = size(C, 1);
+  Nf   = numel(z);
+
+  [T, H] = hess(A);
+  P = C*T;
+  Q = T'*B;
+  I = eye(n);
+
+  s = warning;
+  warning('off', 'MATLAB:nearlySingularMatrix');
+
+  X = zeros(n, Nin, Nf);
+  Y = zeros(Nout, n, Nf);
+  for ff = 1:Nf
+    M = z(ff)*I - H;
+    X(:,:,ff) = T*(M\Q);
+    Y(:,:,ff) = (P/M)*T';
+  end
+
+  warning(s);
+
+  cache.model     = model;
+  cache.evaluator = ev;
+  cache.x0        = x0;
+  cache.A         = A;
+  cache.B         = B;
+  cache.C         = C;
+  cache.D         = D;
+  cache.z         = z;
+  cache.X         = X;
+  cache.Y         = Y;
+
+end
+
+%--------------------------------------------------------------------------
+% Numeric A, B, C, D from the given inputs to the given outputs for the
+% parameter vector x
+%--------------------------------------------------------------------------
+function [A, B, C, D, ev] = numericMatrices(model, ev, x, inNames, outNames)
+
+  m  = copy(model, 1);
+  ev = m.applyParameterEvaluator(ev, x);
+  m.reshuffle(inNames, {}, {}, 'ALL', outNames, 'NONE');
+
+  A = full(m.amats{1,1});
+  B = full(m.bmats{1,1});
+  C = full(m.cmats{2,1});
+  D = full(m.dmats{2,1});
+
+end
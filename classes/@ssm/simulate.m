@@ -22,10 +22,21 @@
 %     out1 = simulate(mdl, pl) % simulate
 %     out2 = simulate(mdl, pl) % simulate the same noise again
 %
+% Alternatively, set the 'seed' key. The noise inputs are then drawn inside
+% the simulation loop from a counter-based generator keyed on this seed, so
+% the same seed always gives the same noise without building the full
+% noise matrix in memory.
+%
 %
 % The procinfo of the matrix object contains the last state of the
 % simulation under the key 'LASTX'.
 %
+% When only a decimated product of the simulation is needed, set the
+% 'decimation factor' key. The outputs are then sampled at fs/factor and
+% each output sample is either the first sample of its block or the block
+% average (see 'decimation mode'). The decimation is done inside the
+% simulation loop, so the full-rate outputs are never stored.
+%
 %
 % <a href="matlab:utils.helper.displayMethodInfo('ssm', 'simulate')">Parameters Description</a>
 %
@@ -203,14 +214,38 @@ function varargout = simulate(varargin)
     end
   end
   
+  % output decimation
+  Ndecim   = find(pl, 'decimation factor');
+  avgDecim = strcmpi(find(pl, 'decimation mode'), 'mean');
+  if Ndecim < 1 || Ndecim ~= round(Ndecim)
+    error('### The decimation factor must be a positive integer');
+  end
+  
   % simulation loop
   [x, y, lastX] = ssm.doSimulate(...
     SSini, Nsamples, ...
     A, Baos, Coutputs, Cstates, Daos, Bnoise, Dnoise, Bcst, Dcst,...
-    aos_vect, doTerminate, terminationCond, displayTime, timestep, pl.find('force complete'));
+    aos_vect, doTerminate, terminationCond, displayTime, timestep, pl.find('force complete'), ...
+    Ndecim, avgDecim, find(pl, 'seed'));
+  
+  % decimate the time base in the same way
+  if Ndecim > 1
+    Nrecord = size(y, 2);
+    if ~isempty(time_vect)
+      time_vect = reshape(time_vect(1:Nrecord*Ndecim), Ndecim, Nrecord);
+      if avgDecim
+        time_vect = mean(time_vect, 1);
+      else
+        time_vect = time_vect(1, :);
+      end
+    elseif avgDecim
+      % the block average is centred in the block
+      toffset = toffset + (Ndecim-1)*timestep/2;
+    end
+  end
   
   % saving in aos
-  fs      = 1/timestep;
+  fs      = 1/(Ndecim*timestep);
   isysStr = sys.name;
   
   ao_out = ao.initObjectWithSize(1, NstatesOut + NoutputsOut);
@@ -328,5 +363,17 @@ function pl = getDefaultPlist()
   p = param({'force complete', 'Force the use of the complete simulation code.'}, paramValue.FALSE_TRUE);
   pl.append(p);
   
+  p = param({'decimation factor', 'Store only one output sample every N simulated samples.'}, paramValue.DOUBLE_VALUE(1));
+  pl.append(p);
+  
+  p = param({'decimation mode', ['How the stored sample is obtained when decimating:<ul>', ...
+    '<li>''pick'' - the first sample of each block</li>', ...
+    '<li>''mean'' - the average over each block</li></ul>']}, {1, {'pick', 'mean'}, paramValue.SINGLE});
+  pl.append(p);
+  
+  p = param({'seed', ['The seed of the white noise inputs. If empty, a seed is drawn ', ...
+    'from the MATLAB random number generator.']}, paramValue.EMPTY_DOUBLE);
+  pl.append(p);
+
 end
 
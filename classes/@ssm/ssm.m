@@ -692,6 +692,10 @@ classdef ssm < ltpda_uoh
     end
     varargout = fisher(varargin)
     varargout = diffStepFish(varargin)
+    % parameter derivatives of the frequency response
+    [d, cache] = responseDerivatives(sys, params, dstep, inNames, outNames, freqs, cache)
+    % log-likelihood and its gradient for the gradient-based samplers
+    varargout = loglikelihoodGradient(varargin)
     
     % completion and error check
     varargout = validate(varargin)
@@ -703,6 +707,9 @@ classdef ssm < ltpda_uoh
     varargout = doSetParameters(varargin)
     % process parameter substitution
     varargout = doSubsParameters(varargin)
+    % numeric evaluation of the matrices for a parameter vector
+    ev = buildParameterEvaluator(sys, params)
+    ev = applyParameterEvaluator(sys, ev, xn)
     % re-arrangement of ssm
     sys = reshuffle(sys, inputs1, inputs2, inputs3,  states, outputs, outputStates)
   end
@@ -0,0 +1,4 @@
+%%%%%%%%%%%%%%%%%%%%   path: classes\tests\ao\@test_ao_delay   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help classes\tests\ao\@test_ao_delay\test_ao_delay">classes\tests\ao\@test_ao_delay\test_ao_delay</a>       -  runs tests for the ao method delay.
+%   <a href="matlab:help classes\tests\ao\@test_ao_delay\test_fdfilter_delay">classes\tests\ao\@test_ao_delay\test_fdfilter_delay</a> -  tests the fractional delay filters against the direct filter.
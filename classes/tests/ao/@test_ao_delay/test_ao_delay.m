@@ -0,0 +1,17 @@
+% TEST_ao_delay runs tests for the ao method delay.
+%
+
+classdef test_ao_delay < ltpda_uoh_method_tests
+  
+  methods
+    function utp = test_ao_delay()
+      utp = utp@ltpda_uoh_method_tests();
+      utp.className     = 'ao';
+      utp.methodName    = 'delay';
+      utp.module        = 'ltpda';
+      utp.testData      = ao(plist('waveform', 'noise', 'fs', 8, 'nsecs', 500));
+      utp.configPlist   = plist('mode', 'fdfilter', 'tau', 0.4);
+    end
+  end
+  
+end
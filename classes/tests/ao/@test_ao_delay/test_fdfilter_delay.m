@@ -0,0 +1,67 @@
+% TEST_FDFILTER_DELAY tests the fractional delay filters against the direct filter.
+function res = test_fdfilter_delay(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data, at a rate which gives exact delays in samples
+  a  = ao(plist('waveform', 'noise', 'fs', 8, 'nsecs', 2000));
+  fs = a.fs;
+  x  = a.y(:);
+  N  = numel(x);
+  
+  % Constant delays, given once or for each sample
+  D = [3.7 -2.25 5 -3];
+  for kk = 1:numel(D)
+    yr = fdref(x, D(kk));
+    b  = delay(a, plist('mode', 'fdfilter', 'tau', D(kk)/fs));
+    c  = delay(a, plist('mode', 'fdfilter', 'tau', D(kk)/fs*ones(N, 1)));
+    assert(max(abs(b.y(:) - yr)) <= 1e-10*max(abs(yr)), ...
+      'The delay of %g samples should give the output of the direct filter', D(kk));
+    assert(max(abs(c.y(:) - yr)) <= 1e-10*max(abs(yr)), ...
+      'The delay of %g samples for each sample should give the output of the direct filter', D(kk));
+  end
+  
+  % A delay which changes with time, and is a whole number of samples at
+  % both ends: each sample is the sample of its constant delay
+  D = 3 + 0.8*sin(2*pi*(0:N-1).'/1000);
+  D(1:10)       = 3;
+  D(end-9:end)  = -2;
+  b  = delay(a, plist('mode', 'fdfilter', 'tau', D/fs));
+  for n = [1:12 500 1234 N-11:N]
+    yr = fdref(x, D(n));
+    assert(abs(b.y(n) - yr(n)) <= 1e-10*max(abs(yr)), ...
+      'Sample %d of the time-varying delay should be the sample of its constant delay', n);
+  end
+  
+  % Return result message
+  res = 'Performed tests of the fractional delay filters';
+end
+
+% The fractional delay filter of fdfilt_delay_core with the default
+% 51-tap blackman3 window, applied by FILTER
+function yd = fdref(y, D)
+  
+  if mod(D, 1) == 0
+    yd = zeros(size(y));
+    if D > 0
+      yd(1+D:end) = y(1:end-D);
+    else
+      yd(1:end+D) = y(1-D:end);
+    end
+    return
+  end
+  
+  N = 51;
+  k = (-(N-1)/2):1:((N-1)/2);
+  w = (0.42+0.5*cos((2*pi*k)/(N-1))+0.08*cos((4*pi*k)/(N-1))).^3;
+  Dint = round(D);
+  h  = sinc(D-Dint-k).*w;
+  h  = h/sum(h);
+  m  = mean(y);
+  yd = filter(h, 1, [zeros(N, 1); y-m; zeros(N, 1)]) + m;
+  i0 = N+(N-1)/2-Dint;
+  yd = yd(i0+1:i0+numel(y));
+  
+end
+% END
@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: classes\tests\ao\@test_ao_fftfilt   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help classes\tests\ao\@test_ao_fftfilt\test_ao_fftfilt">classes\tests\ao\@test_ao_fftfilt\test_ao_fftfilt</a>   -  runs tests for the ao method fftfilt.
+%   <a href="matlab:help classes\tests\ao\@test_ao_fftfilt\test_block_filter">classes\tests\ao\@test_ao_fftfilt\test_block_filter</a> -  tests the overlap-save filter against the whole series.
+%   <a href="matlab:help classes\tests\ao\@test_ao_fftfilt\test_olsfilt">classes\tests\ao\@test_ao_fftfilt\test_olsfilt</a>      -  tests the overlap-save kernel and the filtering in chunks.
@@ -0,0 +1,17 @@
+% TEST_ao_fftfilt runs tests for the ao method fftfilt.
+%
+
+classdef test_ao_fftfilt < ltpda_uoh_method_tests
+  
+  methods
+    function utp = test_ao_fftfilt()
+      utp = utp@ltpda_uoh_method_tests();
+      utp.className     = 'ao';
+      utp.methodName    = 'fftfilt';
+      utp.module        = 'ltpda';
+      utp.testData      = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 500));
+      utp.configPlist   = plist('type', 'lowpass', 'fc', 1, 'block size', 256);
+    end
+  end
+  
+end
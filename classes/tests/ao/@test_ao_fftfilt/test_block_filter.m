@@ -0,0 +1,37 @@
+% TEST_BLOCK_FILTER tests the overlap-save filter against the whole series.
+function res = test_block_filter(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a  = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  fs = a.fs;
+  pl = plist('block size', 1024);
+  
+  % Filters with a fast decaying impulse response
+  fmiir = miir(plist('type', 'lowpass', 'order', 2, 'fc', 0.5, 'fs', fs));
+  fpzm  = pzmodel(1, {0.1, 0.1}, {});
+  filts = {fmiir, fpzm};
+  
+  for kk = 1:numel(filts)
+    b = fftfilt(a, filts{kk});
+    c = fftfilt(a, filts{kk}, pl);
+    assert(isequal(size(b.y), size(c.y)), 'The block filter should keep the size of the data');
+    assert(max(abs(b.y - c.y)) <= 1e-6*max(abs(b.y)), ...
+      'The block filter with a %s should give the output of the whole series', class(filts{kk}));
+    assert(isequal(b.yunits, c.yunits), 'The block filter should set the units of the whole series');
+  end
+  
+  % A standard filter whose mask passes all the frequencies only applies
+  % its gain on both paths
+  spl = plist('type', 'lowpass', 'fc', fs, 'gain', 2);
+  b   = fftfilt(a, spl);
+  c   = fftfilt(a, combine(spl, pl));
+  assert(max(abs(b.y - c.y)) <= 1e-12*max(abs(b.y)), 'The block filter with a standard filter should give the output of the whole series');
+  assert(max(abs(c.y - 2*a.y)) <= 1e-12*max(abs(c.y)), 'The block filter with a standard filter should apply its gain');
+  
+  % Return result message
+  res = 'Performed tests of the block filter';
+end
+% END
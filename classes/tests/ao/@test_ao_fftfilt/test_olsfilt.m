@@ -0,0 +1,48 @@
+% TEST_OLSFILT tests the overlap-save kernel and the filtering in chunks.
+function res = test_olsfilt(varargin)
+  
+  
+  utp = varargin{1};
+  
+  Nfft = 64;
+  x    = randn(1000, 1);
+  
+  % A causal impulse response
+  h = zeros(Nfft, 1);
+  h(1:3) = [0.5 0.3 0.2];
+  H = fft(h);
+  
+  kernel = utils.math.olskernel(H(1:Nfft/2+1));
+  assert(kernel.Kc == 3 && kernel.Ka == 0, 'The kernel should keep the three causal taps');
+  
+  y  = utils.math.olsfilt(x, kernel);
+  yr = filter(h(1:3), 1, x);
+  assert(max(abs(y - yr)) <= 1e-12*max(abs(yr)), 'The block filter should equal the convolution');
+  
+  % With one acausal tap, the output is delayed by one sample
+  h(end) = 0.4;
+  H = fft(h);
+  
+  kernel = utils.math.olskernel(H(1:Nfft/2+1));
+  assert(kernel.Kc == 3 && kernel.Ka == 1, 'The kernel should keep the causal and acausal taps');
+  
+  y  = utils.math.olsfilt([x; 0], kernel);
+  yr = filter([0.4; h(1:3)], 1, [x; 0]);
+  assert(max(abs(y - yr)) <= 1e-12*max(abs(yr)), 'The block filter should equal the delayed convolution');
+  
+  % Chunks of any size give the output of a single call
+  [y1, zf1] = utils.math.olsfilt(x, kernel);
+  edges = [0 1 37 500 501 1000];
+  yc = zeros(size(x));
+  zf = [];
+  for kk = 1:numel(edges)-1
+    idx = edges(kk)+1:edges(kk+1);
+    [yc(idx), zf] = utils.math.olsfilt(x(idx), kernel, zf);
+  end
+  assert(max(abs(yc - y1)) <= 1e-12*max(abs(y1)), 'The block filter in chunks should give the output of a single call');
+  assert(max(abs(zf - zf1)) == 0, 'The block filter in chunks should give the final state of a single call');
+  
+  % Return result message
+  res = 'Performed tests of the overlap-save filter';
+end
+% END
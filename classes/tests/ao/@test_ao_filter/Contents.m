@@ -0,0 +1,6 @@
+%%%%%%%%%%%%%%%%%%%%   path: classes\tests\ao\@test_ao_filter   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help classes\tests\ao\@test_ao_filter\test_ao_filter">classes\tests\ao\@test_ao_filter\test_ao_filter</a>     -  runs tests for the ao method filter.
+%   <a href="matlab:help classes\tests\ao\@test_ao_filter\test_filter_bank">classes\tests\ao\@test_ao_filter\test_filter_bank</a>   -  tests the single-pass filter bank against a FILTER loop.
+%   <a href="matlab:help classes\tests\ao\@test_ao_filter\test_filter_chunks">classes\tests\ao\@test_ao_filter\test_filter_chunks</a> -  tests the filter in parallel chunks against FILTER.
+%   <a href="matlab:help classes\tests\ao\@test_ao_filter\test_matrix_filter">classes\tests\ao\@test_ao_filter\test_matrix_filter</a> -  tests the multichannel matrix filter against ao/filter.
@@ -0,0 +1,78 @@
+% TEST_FILTER_BANK tests the single-pass filter bank against a FILTER loop.
+function res = test_filter_bank(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a  = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  fs = a.fs;
+  x  = a.y;
+  
+  f1 = miir(plist('type', 'lowpass', 'order', 4, 'fc', 0.1, 'fs', fs));
+  f2 = miir(plist('type', 'highpass', 'order', 2, 'fc', 1, 'fs', fs));
+  f3 = miir(plist('type', 'bandpass', 'order', 3, 'fc', [0.5 2], 'fs', fs));
+  filts = [f1 f2 f3];
+  
+  banks = {'parallel', 'serial'};
+  for kk = 1:numel(banks)
+    for init = [false true]
+      pl = plist('filter', filts, 'bank', banks{kk}, 'initialize', init);
+      b  = filter(a, pl);
+      
+      % The filters one after the other, as before the single pass
+      [yr, Zr] = filterLoop(x, filts, banks{kk}, init);
+      
+      assert(max(abs(b.y - yr)) <= 1e-10*max(abs(yr)), ...
+        'The %s bank should give the output of the filters one after the other', banks{kk});
+      fout = find(b.procinfo, 'filter');
+      for ff = 1:numel(filts)
+        assert(max(abs(fout(ff).histout(:) - Zr{ff})) <= 1e-10*max(abs(yr)), ...
+          'The %s bank should set the final state of each filter', banks{kk});
+      end
+    end
+  end
+  
+  % A filter with a history goes on from it: two halves give the whole series
+  f  = miir(plist('type', 'bandpass', 'order', 3, 'fc', [0.5 2], 'fs', fs));
+  b  = filter(a, f);
+  a1 = split(a, plist('samples', [1 1000]));
+  a2 = split(a, plist('samples', [1001 numel(x)]));
+  b1 = filter(a1, f);
+  b2 = filter(a2, find(b1.procinfo, 'filter'));
+  y  = [b1.y(:); b2.y(:)];
+  assert(max(abs(b.y(:) - y)) <= 1e-10*max(abs(b.y)), 'A filter with a history should go on from its final state');
+  h  = find(b.procinfo, 'filter');
+  h2 = find(b2.procinfo, 'filter');
+  assert(max(abs(h.histout(:) - h2.histout(:))) <= 1e-10*max(abs(b.y)), ...
+    'A filter with a history should have the final state of the whole series');
+  
+  % Return result message
+  res = 'Performed tests of the filter banks';
+end
+
+% The filters of a bank applied with FILTER, with their initial states
+function [y, Zf] = filterLoop(x, filts, bank, init)
+  
+  Zf = cell(1, numel(filts));
+  switch bank
+    case 'parallel'
+      y = zeros(size(x));
+      for ff = 1:numel(filts)
+        zi = zeros(max(numel(filts(ff).a), numel(filts(ff).b))-1, 1);
+        if init
+          zi = utils.math.iirinit(filts(ff).a, filts(ff).b)*x(1);
+        end
+        [yf, Zf{ff}] = filter(filts(ff).a, filts(ff).b, x, zi);
+        y = y + yf;
+      end
+    case 'serial'
+      y = x;
+      for ff = 1:numel(filts)
+        zi = utils.math.iirinit(filts(ff).a, filts(ff).b)*y(1);
+        [y, Zf{ff}] = filter(filts(ff).a, filts(ff).b, y, zi);
+      end
+  end
+  
+end
+% END
@@ -0,0 +1,44 @@
+% TEST_FILTER_CHUNKS tests the filter in parallel chunks against FILTER.
+function res = test_filter_chunks(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a  = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 5000));
+  fs = a.fs;
+  x  = a.y(:);
+  
+  f  = miir(plist('type', 'bandpass', 'order', 3, 'fc', [0.5 2], 'fs', fs));
+  zi = 0.1*(1:max(numel(f.a), numel(f.b))-1).';
+  fh = copy(f, 1);
+  fh.setHistout(zi);
+  filts = {f, fh};
+  
+  for kk = 1:numel(filts)
+    h = filts{kk}.histout;
+    if isempty(h)
+      h = zeros(size(zi));
+    end
+    [yr, Zr] = filter(f.a, f.b, x, h);
+    for chunks = [0 4 7]
+      b = filter(a, plist('filter', filts{kk}, 'chunks', chunks));
+      assert(max(abs(b.y(:) - yr)) <= 1e-10*max(abs(yr)), ...
+        'The filter in %d chunks should give the output of FILTER', chunks);
+      fout = find(b.procinfo, 'filter');
+      assert(max(abs(fout.histout(:) - Zr)) <= 1e-10*max(abs(yr)), ...
+        'The filter in %d chunks should set the final state of FILTER', chunks);
+    end
+  end
+  
+  % The chunks of utils.math.iirchunk
+  [y, Zf] = utils.math.iirchunk([x x], f.a, f.b, [zi -zi], 5);
+  [yr1, Zr1] = filter(f.a, f.b, x, zi);
+  [yr2, Zr2] = filter(f.a, f.b, x, -zi);
+  assert(max(max(abs(y - [yr1 yr2]))) <= 1e-10*max(abs(yr1)), 'The chunks of each channel should give the output of FILTER');
+  assert(max(max(abs(Zf - [Zr1 Zr2]))) <= 1e-10*max(abs(yr1)), 'The chunks of each channel should give the final state of FILTER');
+  
+  % Return result message
+  res = 'Performed tests of the filter in chunks';
+end
+% END
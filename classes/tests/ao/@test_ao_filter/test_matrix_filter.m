@@ -0,0 +1,48 @@
+% TEST_MATRIX_FILTER tests the multichannel matrix filter against ao/filter.
+function res = test_matrix_filter(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a1 = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  a2 = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  fs = a1.fs;
+  
+  f11 = miir(plist('type', 'lowpass', 'order', 4, 'fc', 0.1, 'fs', fs));
+  f12 = miir(plist('type', 'highpass', 'order', 2, 'fc', 1, 'fs', fs));
+  f21 = miir(plist('type', 'bandpass', 'order', 3, 'fc', [0.5 2], 'fs', fs));
+  f22 = miir(plist('type', 'lowpass', 'order', 2, 'fc', 1, 'fs', fs));
+  
+  % Each output is the sum of the inputs filtered one by one
+  F = matrix([f11 f12; f21 f22], plist('shape', [2 2]));
+  A = matrix([a1; a2], plist('shape', [2 1]));
+  Y = filter(A, F);
+  
+  yr = {filter(a1, f11) + filter(a2, f12), filter(a1, f21) + filter(a2, f22)};
+  for kk = 1:2
+    assert(isequal(size(Y.objs(kk).y), size(a1.y)), 'The matrix filter should keep the size of the data');
+    assert(max(abs(Y.objs(kk).y - yr{kk}.y)) <= 1e-10*max(abs(yr{kk}.y)), ...
+      'Row %d of the matrix filter should give the sum of the inputs filtered one by one', kk);
+    assert(isequal(Y.objs(kk).yunits, yr{kk}.yunits), 'The matrix filter should set the units of the sum');
+  end
+  
+  % A single input filtered by a column of filters keeps their final states
+  F = matrix([f11; f21], plist('shape', [2 1]));
+  Y = filter(matrix(a1, plist('shape', [1 1])), F);
+  
+  filts = [f11 f21];
+  for kk = 1:2
+    b  = filter(a1, filts(kk));
+    fb = find(b.procinfo, 'filter');
+    fy = find(Y.objs(kk).procinfo, 'filter');
+    assert(max(abs(Y.objs(kk).y - b.y)) <= 1e-10*max(abs(b.y)), ...
+      'Row %d of the matrix filter should give the output of ao/filter', kk);
+    assert(max(abs(fy.histout(:) - fb.histout(:))) <= 1e-10*max(abs(b.y)), ...
+      'Row %d of the matrix filter should set the final state of ao/filter', kk);
+  end
+  
+  % Return result message
+  res = 'Performed tests of the multichannel matrix filter';
+end
+% END
@@ -0,0 +1,4 @@
+%%%%%%%%%%%%%%%%%%%%   path: classes\tests\ao\@test_ao_filtfilt   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help classes\tests\ao\@test_ao_filtfilt\test_ao_filtfilt">classes\tests\ao\@test_ao_filtfilt\test_ao_filtfilt</a>   -  runs tests for the ao method filtfilt.
+%   <a href="matlab:help classes\tests\ao\@test_ao_filtfilt\test_filtfilt_bank">classes\tests\ao\@test_ao_filtfilt\test_filtfilt_bank</a> -  tests the zero-phase filter bank against FILTFILT.
@@ -0,0 +1,17 @@
+% TEST_ao_filtfilt runs tests for the ao method filtfilt.
+%
+
+classdef test_ao_filtfilt < ltpda_uoh_method_tests
+  
+  methods
+    function utp = test_ao_filtfilt()
+      utp = utp@ltpda_uoh_method_tests();
+      utp.className     = 'ao';
+      utp.methodName    = 'filtfilt';
+      utp.module        = 'ltpda';
+      utp.testData      = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 500));
+      utp.configPlist   = plist('filter', miir(plist('type', 'lowpass', 'order', 2, 'fc', 1, 'fs', 10)));
+    end
+  end
+  
+end
@@ -0,0 +1,36 @@
+% TEST_FILTFILT_BANK tests the zero-phase filter bank against FILTFILT.
+function res = test_filtfilt_bank(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a  = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  fs = a.fs;
+  x  = a.y(:);
+  
+  f1 = miir(plist('type', 'lowpass', 'order', 2, 'fc', 1, 'fs', fs));
+  f2 = miir(plist('type', 'highpass', 'order', 2, 'fc', 0.1, 'fs', fs));
+  
+  % A single filter
+  b  = filtfilt(a, f1);
+  yr = filtfilt(f1.a, f1.b, x);
+  assert(max(abs(b.y(:) - yr)) <= 1e-10*max(abs(yr)), 'A single filter should give the output of FILTFILT');
+  
+  % A bank is the filter of the sum or the product of its responses
+  num = {conv(f1.a, f2.b) + conv(f2.a, f1.b), conv(f1.a, f2.a)};
+  den = {conv(f1.b, f2.b), conv(f1.b, f2.b)};
+  banks = {'parallel', 'serial'};
+  for kk = 1:numel(banks)
+    fb = filterbank(plist('filters', [f1 f2], 'type', banks{kk}));
+    b  = filtfilt(a, fb);
+    yr = filtfilt(num{kk}, den{kk}, x);
+    assert(isequal(size(b.y), size(a.y)), 'The %s bank should keep the size of the data', banks{kk});
+    assert(max(abs(b.y(:) - yr)) <= 1e-8*max(abs(yr)), ...
+      'The %s bank should give the output of FILTFILT with the filter of the bank', banks{kk});
+  end
+  
+  % Return result message
+  res = 'Performed tests of the zero-phase filter banks';
+end
+% END
@@ -0,0 +1,4 @@
+%%%%%%%%%%%%%%%%%%%%   path: classes\tests\ao\@test_ao_resample   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help classes\tests\ao\@test_ao_resample\test_ao_resample">classes\tests\ao\@test_ao_resample\test_ao_resample</a>  -  runs tests for the ao method resample.
+%   <a href="matlab:help classes\tests\ao\@test_ao_resample\test_polyresample">classes\tests\ao\@test_ao_resample\test_polyresample</a> -  tests the polyphase resampler against RESAMPLE.
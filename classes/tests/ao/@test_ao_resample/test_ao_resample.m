@@ -0,0 +1,17 @@
+% TEST_ao_resample runs tests for the ao method resample.
+%
+
+classdef test_ao_resample < ltpda_uoh_method_tests
+  
+  methods
+    function utp = test_ao_resample()
+      utp = utp@ltpda_uoh_method_tests();
+      utp.className     = 'ao';
+      utp.methodName    = 'resample';
+      utp.module        = 'ltpda';
+      utp.testData      = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 500));
+      utp.configPlist   = plist('fsout', 3);
+    end
+  end
+  
+end
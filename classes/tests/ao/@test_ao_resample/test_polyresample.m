@@ -0,0 +1,36 @@
+% TEST_POLYRESAMPLE tests the polyphase resampler against RESAMPLE.
+function res = test_polyresample(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test data
+  a  = ao(plist('waveform', 'noise', 'fs', 10, 'nsecs', 2000));
+  fs = a.fs;
+  x  = a.y(:);
+  
+  % Down and up by rational factors, with the default filter
+  fsout = [3 1 25];
+  for kk = 1:numel(fsout)
+    [P, Q] = rat(fsout(kk)/fs, 1e-12);
+    [yr, br] = resample(x, P, Q);
+    b = resample(a, plist('fsout', fsout(kk)));
+    assert(b.fs == fsout(kk), 'The resampled data should have the output rate');
+    assert(isequal(numel(b.y), numel(yr)), 'The polyphase resampler should give the samples of RESAMPLE');
+    assert(max(abs(b.y(:) - yr)) <= 1e-10*max(abs(yr)), ...
+      'The polyphase resampler by %d/%d should give the output of RESAMPLE', P, Q);
+    f = find(b.procinfo, 'filter');
+    assert(max(abs(f.a(:) - br(:))) <= 1e-12*max(abs(br)), 'The procinfo should hold the filter of RESAMPLE');
+  end
+  
+  % With a given filter
+  [P, Q] = rat(3/fs, 1e-12);
+  filt = mfir(fir1(60, 0.25), P*fs);
+  yr   = resample(x, P, Q, P*filt.a);
+  b    = resample(a, plist('fsout', 3, 'filter', filt));
+  assert(max(abs(b.y(:) - yr)) <= 1e-10*max(abs(yr)), 'The polyphase resampler with a given filter should give the output of RESAMPLE');
+  
+  % Return result message
+  res = 'Performed tests of the polyphase resampler';
+end
+% END
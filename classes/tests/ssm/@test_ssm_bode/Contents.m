@@ -1,6 +1,8 @@
 %%%%%%%%%%%%%%%%%%%%   path: classes\tests\ssm\@test_ssm_bode   %%%%%%%%%%%%%%%%%%%%
 %
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_bode_all_inputs_outputs">classes\tests\ssm\@test_ssm_bode\test_bode_all_inputs_outputs</a> -  tests the bode method with all inputs and outputs.
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_continuous_response">classes\tests\ssm\@test_ssm_bode\test_continuous_response</a>     -  tests the continuous-time response against a direct solve.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_getInfo">classes\tests\ssm\@test_ssm_bode\test_getInfo</a>                 -  tests getting the method info from the method.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_preserves_plotinfo">classes\tests\ssm\@test_ssm_bode\test_preserves_plotinfo</a>      -  override because ssm objects don't do anything
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_response_derivatives">classes\tests\ssm\@test_ssm_bode\test_response_derivatives</a>    -  tests the response derivatives against the bode of parameterDiff.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_bode\test_ssm_bode">classes\tests\ssm\@test_ssm_bode\test_ssm_bode</a>                - % Make an array of test objects
@@ -0,0 +1,35 @@
+% TEST_CONTINUOUS_RESPONSE tests the continuous-time response against a direct solve.
+function res = test_continuous_response(varargin)
+  
+  % Stable continuous model with many states
+  Ns = 120;
+  Ni = 3;
+  No = 2;
+  rs = RandStream('mt19937ar', 'Seed', 1);
+  V  = orth(randn(rs, Ns));
+  A  = V*diag(-logspace(-2, 2, Ns))*V.';
+  B  = randn(rs, Ns, Ni);
+  C  = randn(rs, No, Ns);
+  D  = randn(rs, No, Ni);
+  
+  f = logspace(-4, 3, 200);
+  w = 2*pi*f;
+  
+  % Make response
+  G = ssm.doBode(A, B, C, D, w, 0);
+  
+  % Reference response C*(jw - A)^-1*B + D
+  maxErr = 0;
+  for kk=1:numel(w)
+    Gref   = C*((1i*w(kk)*eye(Ns) - A)\B) + D;
+    maxErr = max(maxErr, norm(G(:,:,kk) - Gref)/norm(Gref));
+  end
+  
+  % Checks
+  assert(isequal(size(G), [No Ni numel(w)]), 'The response doesn''t have the expected size');
+  assert(maxErr < 1e-10, 'The continuous-time response differs from the direct solve');
+  
+  % Return message
+  res = 'ssm/bode passed continuous-time response tests';
+    
+end
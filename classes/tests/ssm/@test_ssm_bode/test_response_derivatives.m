@@ -0,0 +1,43 @@
+% TEST_RESPONSE_DERIVATIVES tests the response derivatives against the bode of parameterDiff.
+function res = test_response_derivatives(varargin)
+  
+  % The derivatives of the frequency response of ssm models used by the
+  % Fisher matrix: the derivatives of all the parameters computed at once
+  % must match the bode of parameterDiff for each parameter.
+  params = {'DAMP','K'};
+  values = [0.1, 0.1];
+  
+  mod = ssm(plist('built-in','HARMONIC_OSC_1D',...
+    'Version','Fitting',...
+    'Continuous',1,...
+    'SYMBOLIC PARAMS',params));
+  
+  mod.setParameters(plist('names',params,'values',values));
+  
+  inNames  = {'COMMAND.force'};
+  outNames = {'HARMONIC_OSC_1D.position'};
+  freqs    = logspace(-3, log10(0.5), 50);
+  dstep    = [1e-5 1e-5];
+  
+  d = mod.responseDerivatives(params, dstep, inNames, outNames, freqs);
+  
+  % Checks
+  assert(isequal(size(d), [numel(freqs) 1 1 numel(params)]), 'The derivatives don''t have the expected size');
+  for ii = 1:numel(params)
+    dH  = mod.parameterDiff(plist('names', params(ii), 'values', dstep(ii)));
+    spl = plist(...
+      'outputs',    {strrep(outNames{1}, '.', sprintf('_DIFF_%s.', params{ii}))}, ...
+      'inputs',     inNames, ...
+      'reorganize', true,    ...
+      'f',          freqs);
+    dd = bode(dH, spl);
+    dd = dd.objs.y;
+    di = d(:,1,1,ii);
+    assert(all(abs(di(:) - dd(:)) <= 1e-6*max(abs(dd(:)))), ...
+      'The derivatives of parameter %s differ from parameterDiff', params{ii});
+  end
+  
+  % Return message
+  res = 'ssm/responseDerivatives passed tests against parameterDiff';
+  
+end
@@ -3,6 +3,9 @@
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_ao_input">classes\tests\ssm\@test_ssm_simulate\test_ao_input</a>           -  tests the simulate method with an input AO.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_covariance_input">classes\tests\ssm\@test_ssm_simulate\test_covariance_input</a>   -  tests the simulate method with an input covariance
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_cpsd_input">classes\tests\ssm\@test_ssm_simulate\test_cpsd_input</a>         -  tests the simulate method with an input cpsd
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_decimation">classes\tests\ssm\@test_ssm_simulate\test_decimation</a>         -  tests the simulate method with output decimation.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_getInfo">classes\tests\ssm\@test_ssm_simulate\test_getInfo</a>            -  tests getting the method info from the method.
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_loglikelihood_td">classes\tests\ssm\@test_ssm_simulate\test_loglikelihood_td</a>   -  tests the time-domain log-likelihood against the simulated outputs.
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_noise_seed">classes\tests\ssm\@test_ssm_simulate\test_noise_seed</a>         -  tests that simulate gives reproducible noise for a fixed seed.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_preserves_plotinfo">classes\tests\ssm\@test_ssm_simulate\test_preserves_plotinfo</a> -  override because the output of simulate is no longer
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_simulate\test_ssm_simulate">classes\tests\ssm\@test_ssm_simulate\test_ssm_simulate</a>       - % Make a test object
@@ -0,0 +1,58 @@
+% TEST_DECIMATION tests the simulate method with output decimation.
+function res = test_decimation(varargin)
+  
+  utp = varargin{1};
+  
+  % Build test system
+  sys = ssm(plist('built-in', 'HARMONIC_OSC_1D'));
+  
+  % sample rate
+  fs = 10;
+  nSecs = 100;
+  a = ao.randn(nSecs, fs);
+  Ndecim = 10;
+  
+  % All outputs
+  outputs = sys.getPortNamesForBlocks(plist('blocks', 'HARMONIC_OSC_1D', 'type', 'outputs'));
+  
+  pl = plist(...
+    'AOS VARIABLE NAMES', 'COMMAND.force', ...
+    'AOS', a, ...
+    'return outputs', outputs);
+  
+  sys.modifyTimeStep(1/fs);
+  full = simulate(sys, pl);
+  pick = simulate(sys, pl.pset('decimation factor', Ndecim, 'decimation mode', 'pick'));
+  avrg = simulate(sys, pl.pset('decimation factor', Ndecim, 'decimation mode', 'mean'));
+  
+  % Reference decimation of the full-rate simulation
+  yfull = reshape(full.objs(1).y, Ndecim, []);
+  
+  % Checks
+  assert(isequal(numel(pick.objs(1).y), nSecs*fs/Ndecim), 'The decimated output doesn''t have the expected number of samples');
+  assert(isequal(pick.objs(1).fs, fs/Ndecim), 'The decimated output doesn''t have the decimated sample rate');
+  assert(isequal(pick.objs(1).nsecs, nSecs), 'The decimated output doesn''t span the simulated time');
+  assert(max(abs(pick.objs(1).y(:) - yfull(1,:).')) <= 1e-12*max(abs(yfull(:))), 'The picked samples differ from the full-rate simulation');
+  assert(max(abs(avrg.objs(1).y(:) - mean(yfull, 1).')) <= 1e-12*max(abs(yfull(:))), 'The block averages differ from the full-rate simulation');
+  
+  % The same with noise inputs, drawn from a fixed seed
+  portNames = sys.getPortNamesForBlocks(plist('blocks', {'COMMAND', 'NOISE'}));
+  pln = plist(...
+    'COVARIANCE VARIABLE NAMES', portNames, ...
+    'COVARIANCE', eye(numel(portNames)), ...
+    'return outputs', outputs, ...
+    'nsamples', nSecs*fs, ...
+    'seed', 1234);
+  fulln = simulate(sys, pln);
+  pickn = simulate(sys, pln.pset('decimation factor', Ndecim, 'decimation mode', 'pick'));
+  avrgn = simulate(sys, pln.pset('decimation factor', Ndecim, 'decimation mode', 'mean'));
+  yfulln = reshape(fulln.objs(1).y, Ndecim, []);
+  
+  assert(isequal(numel(pickn.objs(1).y), nSecs*fs/Ndecim), 'The decimated noise output doesn''t have the expected number of samples');
+  assert(max(abs(pickn.objs(1).y(:) - yfulln(1,:).')) <= 1e-12*max(abs(yfulln(:))), 'The picked noise samples differ from the full-rate simulation');
+  assert(max(abs(avrgn.objs(1).y(:) - mean(yfulln, 1).')) <= 1e-12*max(abs(yfulln(:))), 'The noise block averages differ from the full-rate simulation');
+  
+  % Return message
+  res = 'ssm/simulate passed decimation tests';
+    
+end
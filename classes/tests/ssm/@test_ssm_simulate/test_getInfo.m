@@ -49,6 +49,18 @@ function res = test_getInfo(varargin)
   p = param({'force complete', 'Force the use of the complete simulation code.'}, paramValue.FALSE_TRUE);
   pl.append(p);
   
+  p = param({'decimation factor', 'Store only one output sample every N simulated samples.'}, paramValue.DOUBLE_VALUE(1));
+  pl.append(p);
+  
+  p = param({'decimation mode', ['How the stored sample is obtained when decimating:<ul>', ...
+    '<li>''pick'' - the first sample of each block</li>', ...
+    '<li>''mean'' - the average over each block</li></ul>']}, {1, {'pick', 'mean'}, paramValue.SINGLE});
+  pl.append(p);
+  
+  p = param({'seed', ['The seed of the white noise inputs. If empty, a seed is drawn ', ...
+    'from the MATLAB random number generator.']}, paramValue.EMPTY_DOUBLE);
+  pl.append(p);
+
   utp.expectedPlists = pl;
   
   
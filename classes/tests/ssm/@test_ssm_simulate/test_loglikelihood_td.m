@@ -0,0 +1,53 @@
+% TEST_LOGLIKELIHOOD_TD tests the time-domain log-likelihood against the simulated outputs.
+function res = test_loglikelihood_td(varargin)
+  
+  % The chi-square of the time-domain log-likelihood must be the one
+  % computed on the simulated outputs, whichever of the mex file or the
+  % MATLAB residual products is used.
+  params = {'DAMP','K'};
+  values = [0.1, 0.1];
+  
+  mod = ssm(plist('built-in','HARMONIC_OSC_1D',...
+    'Version','Fitting',...
+    'Continuous',1,...
+    'SYMBOLIC PARAMS',params));
+  
+  mod.setParameters(plist('names',params,'values',values));
+  
+  in    = ao(plist('waveform','sine wave','fs',10,'nsecs',300,'f',0.2));
+  noise = ao(plist('waveform','noise','fs',10,'nsecs',in.nsecs,'sigma',0.1));
+  
+  sim = mod.keepParameters;
+  sim.modifyTimeStep(0.1);
+  
+  mout = sim.simulate(plist('AOS', [in noise], ...
+                            'AOS VARIABLE NAMES', {'COMMAND.force' 'NOISE.readout'}, ...
+                            'return outputs',  {'HARMONIC_OSC_1D.position'}));
+  
+  out      = mout.getObjectAtIndex(1,1);
+  inNames  = {'COMMAND.force'};
+  outNames = {'HARMONIC_OSC_1D.position'};
+  
+  x  = [0.12 0.09];
+  S  = 0.01;
+  cb = 100;
+  ca = 50;
+  
+  [loglk, chi2] = utils.math.loglikelihood_ssm_td_core(x, mod, in.y.', out.y.', S, in.fs, ...
+    params, inNames, outNames, 'cutbefore', cb, 'cutafter', ca);
+  
+  chi2ref = utils.math.chisquare_ssm_td(x, in, out, params, mod, inNames, outNames, ...
+    'cutbefore', cb, 'cutafter', ca);
+  
+  N = numel(out.y) - cb - ca - 1;
+  
+  % Checks
+  assert(abs(chi2 - chi2ref) <= 1e-9*abs(chi2ref), ...
+    'The chi-square differs from the one of the simulated outputs: %g ~= %g', chi2, chi2ref);
+  assert(abs(loglk*N*S - chi2ref*(N - numel(x))) <= 1e-9*abs(chi2ref*N), ...
+    'The log-likelihood does not match the residual products of the simulated outputs');
+  
+  % Return message
+  res = 'ssm time-domain log-likelihood passed tests against the simulated outputs';
+  
+end
@@ -0,0 +1,51 @@
+% TEST_NOISE_SEED tests that simulate gives reproducible noise for a fixed seed.
+function res = test_noise_seed(varargin)
+  
+  utp = varargin{1};
+  
+  % Build test system
+  sys = ssm(plist('built-in', 'HARMONIC_OSC_1D'));
+  
+  % sample rate
+  fs = 10;
+  nSecs = 100;
+  
+  % Get port names
+  portNames = sys.getPortNamesForBlocks(plist('blocks', {'COMMAND', 'NOISE'}));
+  
+  % All outputs
+  outputs = sys.getPortNamesForBlocks(plist('blocks', 'HARMONIC_OSC_1D', 'type', 'outputs'));
+  
+  pl = plist(...
+    'COVARIANCE VARIABLE NAMES', portNames, ...
+    'COVARIANCE', eye(2), ...
+    'return outputs', outputs, ...
+    'nsamples', nSecs*fs, ...
+    'seed', 1234);
+  
+  sys.modifyTimeStep(1/fs);
+  out1 = simulate(sys, pl);
+  % the global stream must not matter when a seed is given
+  randn(100, 1);
+  out2 = simulate(sys, pl);
+  out3 = simulate(sys, pl.pset('seed', 4321));
+  % the MATLAB code draws the same noise as the mex file
+  out4 = simulate(sys, pl.pset('seed', 1234, 'force complete', true));
+  % and the decimated noise is the one of the full-rate simulation
+  out5 = simulate(sys, pl.pset('force complete', false, 'decimation factor', 10));
+  out6 = simulate(sys, pl.pset('force complete', true));
+  
+  % Checks
+  assert(isequal(out1.objs(1).y, out2.objs(1).y), 'Two simulations with the same seed differ');
+  assert(~isequal(out1.objs(1).y, out3.objs(1).y), 'Two simulations with different seeds are the same');
+  assert(any(out1.objs(1).y ~= 0), 'The noise simulation is identically zero');
+  y1 = out1.objs(1).y;
+  assert(max(abs(out4.objs(1).y - y1)) <= 1e-10*max(abs(y1)), 'The MATLAB simulation draws different noise from the mex file');
+  assert(isequal(numel(out5.objs(1).y), nSecs*fs/10), 'The decimated noise simulation doesn''t have the expected number of samples');
+  assert(max(abs(out5.objs(1).y(:) - reshape(y1(1:10:end), [], 1))) <= 1e-12*max(abs(y1)), 'The decimated noise differs from the full-rate simulation');
+  assert(max(abs(out6.objs(1).y(:) - reshape(y1(1:10:end), [], 1))) <= 1e-10*max(abs(y1)), 'The decimated MATLAB noise differs from the full-rate simulation');
+  
+  % Return message
+  res = 'ssm/simulate passed noise seed tests';
+    
+end
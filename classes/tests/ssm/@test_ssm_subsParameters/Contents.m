@@ -1,6 +1,7 @@
 %%%%%%%%%%%%%%%%%%%%   path: classes\tests\ssm\@test_ssm_subsParameters   %%%%%%%%%%%%%%%%%%%%
 %
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_subsParameters\test_getInfo">classes\tests\ssm\@test_ssm_subsParameters\test_getInfo</a>            -  tests getting the method info from the method.
+%   <a href="matlab:help classes\tests\ssm\@test_ssm_subsParameters\test_parameter_evaluator">classes\tests\ssm\@test_ssm_subsParameters\test_parameter_evaluator</a> -  tests the evaluator against the substitution.
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_subsParameters\test_preserves_plotinfo">classes\tests\ssm\@test_ssm_subsParameters\test_preserves_plotinfo</a> -  override because ssm objects don't do anything
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_subsParameters\test_ssm_subsParameters">classes\tests\ssm\@test_ssm_subsParameters\test_ssm_subsParameters</a> - % Make a test object
 %   <a href="matlab:help classes\tests\ssm\@test_ssm_subsParameters\test_substitute">classes\tests\ssm\@test_ssm_subsParameters\test_substitute</a>         -  tests substituting parameters.
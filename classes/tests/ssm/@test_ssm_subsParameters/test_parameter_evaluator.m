@@ -0,0 +1,32 @@
+% TEST_PARAMETER_EVALUATOR tests the evaluator against the substitution.
+function res = test_parameter_evaluator(varargin)
+  
+  
+  utp = varargin{1};
+  
+  % Test System
+  sys  = utp.testData;
+  vals = [2 0.3];
+  
+  % The names are matched regardless of case, as in subsParameters
+  ev  = sys.buildParameterEvaluator({'m', 'k'});
+  out = copy(sys, 1);
+  out.applyParameterEvaluator(ev, vals);
+  
+  ref = sys.setParameters(plist('names', {'M', 'K'}, 'values', vals));
+  ref = ref.subsParameters;
+  
+  fields = {'amats', 'bmats', 'cmats', 'dmats'};
+  for ff = 1:numel(fields)
+    for kk = 1:numel(ref.(fields{ff}))
+      r = double(ref.(fields{ff}){kk});
+      e = double(out.(fields{ff}){kk});
+      assert(isequal(size(r), size(e)), 'The evaluated matrices should have the size of the substituted ones');
+      assert(all(abs(r(:) - e(:)) <= 1e-12*max(abs(r(:)), 1)), 'The evaluated matrices should equal the substituted ones');
+    end
+  end
+  
+  % Call super class 
+  res = 'Performed tests of the parameter evaluator';
+end
+% END
@@ -0,0 +1,94 @@
+#include <math.h>
+
+#include "philox.h"
+
+/*
+ * Counter-based random numbers (Philox4x32-10).
+ *
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011).
+ *
+ * The generator has no state: the numbers are a pure function of the key
+ * (the seed) and of the counter, so any element of a random sequence can be
+ * computed independently of the others. This makes simulations reproducible
+ * regardless of how the work is split between calls or threads.
+ *
+ * $Id$
+ */
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+#define PHILOX_TWO_PI 6.283185307179586476925286766559
+
+/*
+ * The Philox4x32 bijection with 10 rounds.
+ *
+ *  ctr - 4 counter words
+ *  key - 2 key words
+ *  out - 4 output words
+ */
+void philox4x32_10(const philox_uint32 *ctr, const philox_uint32 *key, philox_uint32 *out)
+{
+  philox_uint32 c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  philox_uint32 k0 = key[0], k1 = key[1];
+  philox_uint64 p0, p1;
+  int r;
+
+  for (r=0; r<10; r++) {
+    if (r > 0) {
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+    p0 = (philox_uint64)PHILOX_M0 * c0;
+    p1 = (philox_uint64)PHILOX_M1 * c2;
+    c0 = (philox_uint32)(p1 >> 32) ^ c1 ^ k0;
+    c2 = (philox_uint32)(p0 >> 32) ^ c3 ^ k1;
+    c1 = (philox_uint32)p1;
+    c3 = (philox_uint32)p0;
+  }
+
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+/*
+ * Uniform double in the open interval (0,1) from two 32 bit words.
+ */
+static double philox_uniform(philox_uint32 a, philox_uint32 b)
+{
+  philox_uint64 u = ((philox_uint64)(a >> 5) << 26) | (philox_uint64)(b >> 6);
+  return ((double)u + 0.5) / 9007199254740992.0;
+}
+
+/*
+ * Fill out[0..n-1] with standard normal deviates for the given seed,
+ * sample index and stream. Each Philox block gives two deviates via the
+ * Box-Muller transform, so out[i] only depends on (seed, sample, stream, i).
+ */
+void philox_randn(philox_uint64 seed, philox_uint64 sample, philox_uint32 stream, double *out, int n)
+{
+  philox_uint32 ctr[4], key[2], r[4];
+  double        u1, u2, rho;
+  int           ii;
+
+  key[0] = (philox_uint32)seed;
+  key[1] = (philox_uint32)(seed >> 32);
+  ctr[0] = (philox_uint32)sample;
+  ctr[1] = (philox_uint32)(sample >> 32);
+  ctr[3] = stream;
+
+  for (ii=0; ii<n; ii+=2) {
+    ctr[2] = (philox_uint32)(ii/2);
+    philox4x32_10(ctr, key, r);
+    u1  = philox_uniform(r[0], r[1]);
+    u2  = philox_uniform(r[2], r[3]);
+    rho = sqrt(-2.0*log(u1));
+    out[ii] = rho*cos(PHILOX_TWO_PI*u2);
+    if (ii+1 < n)
+      out[ii+1] = rho*sin(PHILOX_TWO_PI*u2);
+  }
+}
@@ -0,0 +1,17 @@
+/*
+ * Header for philox.c
+ *
+ * $Id$
+ */
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+typedef unsigned int       philox_uint32;
+typedef unsigned long long philox_uint64;
+
+/* from philox.c */
+void philox4x32_10(const philox_uint32 *ctr, const philox_uint32 *key, philox_uint32 *out);
+void philox_randn(philox_uint64 seed, philox_uint64 sample, philox_uint32 stream, double *out, int n);
+
+#endif
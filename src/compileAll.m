@@ -28,6 +28,66 @@ cd ltpda_ssmsim
 compile()
 cd ..
 
+% LTPDA_SSMBODE
+cd ltpda_ssmbode
+compile()
+cd ..
+
+% LTPDA_DARE
+cd ltpda_dare
+compile()
+cd ..
+
+% LTPDA_LOGLIKELIHOOD
+cd ltpda_loglikelihood
+compile()
+cd ..
+
+% LTPDA_IIRBANK
+cd ltpda_iirbank
+compile()
+cd ..
+
+% LTPDA_SOSFILT
+cd ltpda_sosfilt
+compile()
+cd ..
+
+% LTPDA_IIRCHUNK
+cd ltpda_iirchunk
+compile()
+cd ..
+
+% LTPDA_IIRFILTFILT
+cd ltpda_iirfiltfilt
+compile()
+cd ..
+
+% LTPDA_MCHIIR
+cd ltpda_mchiir
+compile()
+cd ..
+
+% LTPDA_NGPROP
+cd ltpda_ngprop
+compile()
+cd ..
+
+% LTPDA_MCHNOISE
+cd ltpda_mchnoise
+compile()
+cd ..
+
+% LTPDA_POLYRESAMPLE
+cd ltpda_polyresample
+compile()
+cd ..
+
+% LTPDA_FDELAY
+cd ltpda_fdelay
+compile()
+cd ..
+
 % Back to starting directory
 cmd = sprintf('cd %s', path_mem);
 eval(cmd);
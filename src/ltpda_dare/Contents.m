@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_dare   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_dare\compile">src\ltpda_dare\compile</a>         -  package within MATLAB
+%   <a href="matlab:help src\ltpda_dare\ltpda_dare">src\ltpda_dare\ltpda_dare</a>      -  A mex file to solve the discrete algebraic Riccati equation of a Kalman filter.
+%   <a href="matlab:help src\ltpda_dare\test_ltpda_dare">src\ltpda_dare\test_ltpda_dare</a> - %
@@ -0,0 +1,354 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_dare.h"
+
+#define DEBUG 0
+/*
+ * A mex file to solve the discrete algebraic Riccati equation of the
+ * steady-state Kalman filter
+ *
+ *   X = A*X*A' - A*X*C'*(C*X*C' + R)^-1*C*X*A' + Q
+ *
+ * with the structured doubling algorithm, see
+ * Chu, E.K.-W., Fan, H.-Y. and Lin, W.-W., "A structure-preserving doubling
+ * algorithm for continuous-time algebraic Riccati equations", Linear Algebra
+ * and its Applications, 396 (2005), pp. 55-80, and the references therein.
+ *
+ * Starting from A0 = A', G0 = C'*R^-1*C, H0 = Q the iteration
+ *
+ *   W       = I + Gk*Hk
+ *   A(k+1)  = Ak*W^-1*Ak
+ *   G(k+1)  = Gk + Ak*W^-1*Gk*Ak'
+ *   H(k+1)  = Hk + Ak'*Hk*W^-1*Ak
+ *
+ * converges quadratically, Hk -> X. The iteration stops when the relative
+ * change of Hk (1-norm) falls below the tolerance.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [X, niter] = ltpda_dare(A, C, Q, R, tol, maxit);
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *X;
+
+  /* inputs */
+  double *A, *C, *Q, *R;
+  double  tol;
+  long int maxit;
+
+  /* work space */
+  double *Ak, *Gk, *W, *Y, *T1, *T2, *RC;
+  long int *piv;
+
+  long int n, p, ii, jj, iter;
+  double   dnorm, xnorm;
+  int      converged;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 4 || nrhs == 6) && (nlhs == 1 || nlhs == 2) )/* let's go */
+  {
+    for (ii=0; ii<4; ii++) {
+      if ( !mxIsDouble(prhs[ii]) || mxIsComplex(prhs[ii]) )
+        mexErrMsgTxt("### the input matrices must be real double arrays");
+    }
+
+    /*----------------- set inputs*/
+    A = mxGetPr(prhs[0]);
+    C = mxGetPr(prhs[1]);
+    Q = mxGetPr(prhs[2]);
+    R = mxGetPr(prhs[3]);
+
+    n = (long int)mxGetM(prhs[0]);
+    p = (long int)mxGetM(prhs[1]);
+
+    if ( (long int)mxGetN(prhs[0]) != n || (long int)mxGetN(prhs[1]) != n ||
+         (long int)mxGetM(prhs[2]) != n || (long int)mxGetN(prhs[2]) != n ||
+         (long int)mxGetM(prhs[3]) != p || (long int)mxGetN(prhs[3]) != p )
+      mexErrMsgTxt("### the input matrices have inconsistent sizes");
+
+    tol   = 1e-12;
+    maxit = 100;
+    if (nrhs == 6) {
+      tol   = mxGetScalar(prhs[4]);
+      maxit = (long int)mxGetScalar(prhs[5]);
+    }
+
+    #if DEBUG
+    mexPrintf("Nstates: %d\n", n);
+    mexPrintf("Noutputs: %d\n", p);
+    mexPrintf("tol: %g\n", tol);
+    mexPrintf("maxit: %d\n", maxit);
+    #endif
+
+    plhs[0] = mxCreateDoubleMatrix(n, n, mxREAL);
+    X = mxGetPr(plhs[0]);
+
+    Ak  = (double*)calloc(n*n+1, sizeof(double));
+    Gk  = (double*)calloc(n*n+1, sizeof(double));
+    W   = (double*)calloc(n*n+1, sizeof(double));
+    Y   = (double*)calloc(2*n*n+1, sizeof(double));
+    T1  = (double*)calloc(n*n+1, sizeof(double));
+    T2  = (double*)calloc(n*n+1, sizeof(double));
+    RC  = (double*)calloc(p*(n+p)+1, sizeof(double));
+    piv = (long int*)calloc(n+p+1, sizeof(long int));
+
+    /* A0 = A' */
+    for (jj=0; jj<n; jj++)
+      for (ii=0; ii<n; ii++)
+        Ak[ii + jj*n] = A[jj + ii*n];
+
+    /* G0 = C'*R^-1*C */
+    memcpy(RC, R, p*p*sizeof(double));
+    memcpy(&(RC[p*p]), C, p*n*sizeof(double));
+    if (lu_factor(RC, p, piv))
+      mexErrMsgTxt("### the measurement noise covariance is singular");
+    lu_solve(RC, piv, p, &(RC[p*p]), n);
+    mat_mult(C, 1, &(RC[p*p]), 0, Gk, n, n, p, 0.0);
+    symmetrise(Gk, n);
+
+    /* H0 = Q */
+    memcpy(X, Q, n*n*sizeof(double));
+    symmetrise(X, n);
+
+    converged = 0;
+    for (iter=1; iter<=maxit; iter++) {
+
+      /* W = I + Gk*Hk */
+      mat_mult(Gk, 0, X, 0, W, n, n, n, 0.0);
+      for (ii=0; ii<n; ii++)
+        W[ii + ii*n] += 1.0;
+      if (lu_factor(W, n, piv)) {
+        mexWarnMsgTxt("### the doubling iteration broke down, the result is not reliable");
+        break;
+      }
+
+      /* [Y1 Y2] = W^-1*[Ak Gk] */
+      memcpy(Y, Ak, n*n*sizeof(double));
+      memcpy(&(Y[n*n]), Gk, n*n*sizeof(double));
+      lu_solve(W, piv, n, Y, 2*n);
+
+      /* H(k+1) = Hk + Ak'*(Hk*Y1) */
+      mat_mult(X, 0, Y, 0, T1, n, n, n, 0.0);
+      mat_mult(Ak, 1, T1, 0, T2, n, n, n, 0.0);
+      symmetrise(T2, n);
+      dnorm = norm1(T2, n);
+      for (ii=0; ii<n*n; ii++)
+        X[ii] += T2[ii];
+      xnorm = norm1(X, n);
+
+      /* G(k+1) = Gk + (Ak*Y2)*Ak' */
+      mat_mult(Ak, 0, &(Y[n*n]), 0, T1, n, n, n, 0.0);
+      mat_mult(T1, 0, Ak, 1, Gk, n, n, n, 1.0);
+      symmetrise(Gk, n);
+
+      /* A(k+1) = Ak*Y1 */
+      mat_mult(Ak, 0, Y, 0, T1, n, n, n, 0.0);
+      memcpy(Ak, T1, n*n*sizeof(double));
+
+      #if DEBUG
+      mexPrintf("iteration %d: relative change %g\n", iter, dnorm/xnorm);
+      #endif
+
+      if (dnorm <= tol*xnorm) {
+        converged = 1;
+        break;
+      }
+    }
+
+    if (!converged && iter > maxit)
+      mexWarnMsgTxt("### the Riccati solution did not converge within the maximum number of iterations");
+
+    if (nlhs == 2)
+      plhs[1] = mxCreateDoubleScalar((double)(iter > maxit ? maxit : iter));
+
+    free(Ak);
+    free(Gk);
+    free(W);
+    free(Y);
+    free(T1);
+    free(T2);
+    free(RC);
+    free(piv);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Cc = op(Aa)*op(Bb) + beta*Cc, with op(M) = M or M' and Cc m x n,
+ * inner dimension k. All matrices are column-major.
+ */
+void mat_mult(const double *Aa, int tA, const double *Bb, int tB, double *Cc,
+              long int m, long int n, long int k, double beta)
+{
+  long int ii, jj, kk;
+  double   b, s;
+  const double *acol;
+  double  *ccol;
+
+  for (jj=0; jj<n; jj++) {
+    ccol = &(Cc[jj*m]);
+    if (tA) {
+      /* dot products of columns of Aa with the column of op(Bb) */
+      for (ii=0; ii<m; ii++) {
+        acol = &(Aa[ii*k]);
+        s = 0.0;
+        for (kk=0; kk<k; kk++)
+          s += acol[kk] * (tB ? Bb[jj + kk*n] : Bb[kk + jj*k]);
+        ccol[ii] = beta*ccol[ii] + s;
+      }
+    }
+    else {
+      for (ii=0; ii<m; ii++)
+        ccol[ii] *= beta;
+      for (kk=0; kk<k; kk++) {
+        b = tB ? Bb[jj + kk*n] : Bb[kk + jj*k];
+        if (b == 0.0)
+          continue;
+        acol = &(Aa[kk*m]);
+        for (ii=0; ii<m; ii++)
+          ccol[ii] += acol[ii]*b;
+      }
+    }
+  }
+}
+
+/*
+ * In-place LU factorisation with partial pivoting of the n x n matrix M.
+ * Returns 1 if the matrix is singular.
+ */
+int lu_factor(double *M, long int n, long int *piv)
+{
+  long int ii, jj, kk, pp;
+  double   amax, t, l;
+
+  for (kk=0; kk<n; kk++) {
+    pp   = kk;
+    amax = fabs(M[kk + kk*n]);
+    for (ii=kk+1; ii<n; ii++) {
+      if (fabs(M[ii + kk*n]) > amax) {
+        amax = fabs(M[ii + kk*n]);
+        pp   = ii;
+      }
+    }
+    piv[kk] = pp;
+    if (amax == 0.0)
+      return 1;
+    if (pp != kk) {
+      for (jj=0; jj<n; jj++) {
+        t = M[kk + jj*n]; M[kk + jj*n] = M[pp + jj*n]; M[pp + jj*n] = t;
+      }
+    }
+    for (ii=kk+1; ii<n; ii++)
+      M[ii + kk*n] /= M[kk + kk*n];
+    for (jj=kk+1; jj<n; jj++) {
+      l = M[kk + jj*n];
+      if (l == 0.0)
+        continue;
+      for (ii=kk+1; ii<n; ii++)
+        M[ii + jj*n] -= M[ii + kk*n]*l;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Solves M*X = B in place for the nrhs columns of B, with M factorised
+ * by lu_factor.
+ */
+void lu_solve(const double *M, const long int *piv, long int n, double *B, long int nrhs)
+{
+  long int ii, jj, kk;
+  double  *b, t;
+
+  for (jj=0; jj<nrhs; jj++) {
+    b = &(B[jj*n]);
+    for (kk=0; kk<n; kk++) {
+      if (piv[kk] != kk) {
+        t = b[kk]; b[kk] = b[piv[kk]]; b[piv[kk]] = t;
+      }
+    }
+    /* forward substitution with the unit lower triangle */
+    for (kk=0; kk<n; kk++) {
+      t = b[kk];
+      if (t == 0.0)
+        continue;
+      for (ii=kk+1; ii<n; ii++)
+        b[ii] -= M[ii + kk*n]*t;
+    }
+    /* back substitution with the upper triangle */
+    for (kk=n-1; kk>=0; kk--) {
+      b[kk] /= M[kk + kk*n];
+      t = b[kk];
+      if (t == 0.0)
+        continue;
+      for (ii=0; ii<kk; ii++)
+        b[ii] -= M[ii + kk*n]*t;
+    }
+  }
+}
+
+/*
+ * M = (M + M')/2
+ */
+void symmetrise(double *M, long int n)
+{
+  long int ii, jj;
+  double   s;
+
+  for (jj=0; jj<n; jj++) {
+    for (ii=jj+1; ii<n; ii++) {
+      s = 0.5*(M[ii + jj*n] + M[jj + ii*n]);
+      M[ii + jj*n] = s;
+      M[jj + ii*n] = s;
+    }
+  }
+}
+
+/*
+ * 1-norm (maximum absolute column sum)
+ */
+double norm1(const double *M, long int n)
+{
+  long int ii, jj;
+  double   s, nrm;
+
+  nrm = 0.0;
+  for (jj=0; jj<n; jj++) {
+    s = 0.0;
+    for (ii=0; ii<n; ii++)
+      s += fabs(M[ii + jj*n]);
+    if (s > nrm)
+      nrm = s;
+  }
+  return nrm;
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_dare version %s\n", version);
+  mexPrintf("  usage:    X = ltpda_dare(A, C, Q, R);\n");
+  mexPrintf("            [X, niter] = ltpda_dare(A, C, Q, R, tol, maxit);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
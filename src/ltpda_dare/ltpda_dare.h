@@ -0,0 +1,18 @@
+/*
+ * Header for ltpda_dare.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void mat_mult(const double *Aa, int tA, const double *Bb, int tB, double *Cc,
+              long int m, long int n, long int k, double beta);
+
+int lu_factor(double *M, long int n, long int *piv);
+
+void lu_solve(const double *M, const long int *piv, long int n, double *B, long int nrhs);
+
+void symmetrise(double *M, long int n);
+
+double norm1(const double *M, long int n);
@@ -0,0 +1,24 @@
+% LTPDA_DARE A mex file to solve the discrete algebraic Riccati equation of a Kalman filter.
+%
+% function X = ltpda_dare(A, C, Q, R);
+% function [X, niter] = ltpda_dare(A, C, Q, R, tol, maxit);
+%
+% Solves X = A*X*A' - A*X*C'*(C*X*C' + R)^-1*C*X*A' + Q for the steady-state
+% prediction covariance X with the structured doubling algorithm.
+%
+% Inputs:
+%          A - The state transition matrix (Nstates x Nstates)
+%          C - The measurement matrix (Nmeas x Nstates)
+%          Q - The process noise covariance (Nstates x Nstates)
+%          R - The measurement noise covariance (Nmeas x Nmeas)
+%        tol - (optional) relative tolerance on the change of X [1e-12]
+%      maxit - (optional) maximum number of doubling steps [100]
+%
+% Outputs:
+%          X - The stabilising solution
+%      niter - The number of doubling steps used
+%
+% The steady-state Kalman gain is K = X*C'*(C*X*C' + R)^-1. Each step costs
+% O(Nstates^3) operations and the convergence is quadratic, so a few tens of
+% steps are usually enough.
+%
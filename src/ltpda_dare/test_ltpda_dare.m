@@ -0,0 +1,36 @@
+clear all;
+compile
+
+Nstates = 150;
+Nmeas   = 4;
+
+%% Validate against the Riccati recursion
+
+A = 0.99*orth(randn(Nstates));
+C = randn(Nmeas, Nstates);
+B = randn(Nstates);
+Q = B*B' + 1e-3*eye(Nstates);
+R = diag(1:Nmeas);
+
+tic
+[X, niter] = ltpda_dare(A, C, Q, R);
+tmex = toc
+niter
+
+tic
+P = eye(Nstates)*1e20;
+for i=1:10000
+  P = A*P*A'+Q;
+  K = P*C'*(C*P*C'+R)^-1;
+  P = (eye(Nstates) - K*C)*P;
+end
+P = A*P*A'+Q;
+tmat = toc
+
+norm(X-P, 1)/norm(P, 1)
+tmat/tmex
+
+%% Residual of the Riccati equation
+
+Res = A*X*A' - A*X*C'*((C*X*C' + R)\(C*X*A')) + Q - X;
+norm(Res, 1)/norm(X, 1)
@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_fdelay   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_fdelay\compile">src\ltpda_fdelay\compile</a>           -  package within MATLAB
+%   <a href="matlab:help src\ltpda_fdelay\ltpda_fdelay">src\ltpda_fdelay\ltpda_fdelay</a>      -  A mex file to delay data by fractional numbers of samples.
+%   <a href="matlab:help src\ltpda_fdelay\test_ltpda_fdelay">src\ltpda_fdelay\test_ltpda_fdelay</a> - %
@@ -0,0 +1,210 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_fdelay.h"
+
+#define DEBUG 0
+
+/* number of output samples of a delay computed in turn */
+#define BLOCK 4096
+
+/*
+ * A mex file to delay data by fractional numbers of samples, with
+ * windowed-sinc filters as in utils.math.fdfilt_delay_core.
+ *
+ * The delay D of an output sample is split in its integer part round(D)
+ * and its fraction f, and the sample is
+ *
+ *   y(n) = sum over k of h(k) * x(n - round(D) - k),   k = -half..half
+ *
+ * with h(k) = sinc(f-k)*w(k), normalised to a unit sum. As
+ * sin(pi*(f-k)) = (-1)^k * sin(pi*f), the normalised filter is
+ *
+ *   h(k) = c(k)/sum(c),   c(k) = (-1)^k*w(k)/(f-k)
+ *
+ * so that the filter of any delay is built from the signed window ws(k) =
+ * (-1)^k*w(k) with a division per tap: each delay can change from a
+ * sample to the next. The input samples out of x take the fill value of
+ * the channel.
+ *
+ * The output samples of each delay are computed in blocks of BLOCK, which
+ * are shared between threads when the file is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function y = ltpda_fdelay(x, D, chan, ws, fill, off, Ny, nthreads);
+ *
+ * x    - Nx x Nch
+ * D    - 1 x Nd, constant delays in samples, or Ny x Nd
+ * chan - 1 x Nd, the channel of x of each delay (1-based)
+ * ws   - 1 x N, the signed window, N odd
+ * fill - 1 x Nch, the value of the samples out of x
+ * off  - the index in x of the output sample 0 (0-based)
+ * Ny   - number of output samples
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y;
+
+  /* inputs */
+  double *x, *D, *chan, *ws, *fill;
+
+  long int Nx, Nch, Nd, N, off, Ny, Nb, tt, kk;
+  long int Dstep = 0;
+  int      nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 7 || nrhs == 8) && (nlhs == 1) )/* let's go */
+  {
+    for (kk=0; kk<5; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, delays, channels, window and fill values must be real double arrays");
+    }
+
+    Nx  = (long int)mxGetM(prhs[0]);
+    Nch = (long int)mxGetN(prhs[0]);
+    Nd  = (long int)mxGetN(prhs[1]);
+    N   = (long int)mxGetNumberOfElements(prhs[3]);
+    off = (long int)mxGetScalar(prhs[5]);
+    Ny  = (long int)mxGetScalar(prhs[6]);
+    nthreads = 0;
+    if (nrhs == 8)
+      nthreads = (int)mxGetScalar(prhs[7]);
+    if (Ny < 0)
+      Ny = 0;
+
+    if ( (long int)mxGetM(prhs[1]) == Ny )
+      Dstep = 1;
+    else if ( mxGetM(prhs[1]) == 1 )
+      Dstep = 0;
+    else
+      mexErrMsgTxt("### the delays must be a row, or have a row per output sample");
+    if ( (long int)mxGetNumberOfElements(prhs[2]) != Nd )
+      mexErrMsgTxt("### there must be a channel per delay");
+    if ( N < 1 || N%2 == 0 )
+      mexErrMsgTxt("### the window must have an odd number of taps");
+    if ( (long int)mxGetNumberOfElements(prhs[4]) != Nch )
+      mexErrMsgTxt("### there must be a fill value per channel");
+
+    #if DEBUG
+    mexPrintf("Nx: %d\n", Nx);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Ndelays: %d\n", Nd);
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Ny: %d\n", Ny);
+    #endif
+
+    /*----------------- set inputs*/
+    x    = mxGetPr(prhs[0]);
+    D    = mxGetPr(prhs[1]);
+    chan = mxGetPr(prhs[2]);
+    ws   = mxGetPr(prhs[3]);
+    fill = mxGetPr(prhs[4]);
+
+    for (kk=0; kk<Nd; kk++) {
+      if (chan[kk] < 1 || chan[kk] > Nch)
+        mexErrMsgTxt("### the channels must be indices of the columns of the data");
+    }
+
+    /* outputs */
+    plhs[0] = mxCreateDoubleMatrix(Ny, Nd, mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    Nb = (Ny + BLOCK - 1)/BLOCK;
+    #pragma omp parallel for schedule(dynamic)
+    for (tt=0; tt<Nb*Nd; tt++) {
+      long int dd = tt/Nb;
+      long int b0 = (tt%Nb)*BLOCK;
+      long int nb = (Ny - b0 < BLOCK) ? Ny - b0 : BLOCK;
+      long int cc = (long int)chan[dd] - 1;
+
+      fd_block(x + cc*Nx, Nx, fill[cc], ws, (N-1)/2,
+               D + dd*(Dstep ? Ny : 1) + b0*Dstep, Dstep,
+               off + b0, nb, y + dd*Ny + b0);
+    }
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * The ny output samples of a delay, from the output sample at the index n
+ * of x. D points to the delay of the first sample, the next ones are
+ * Dstep apart.
+ */
+void fd_block(const double *x, long int Nx, double fill, const double *ws,
+              long int half, const double *D, long int Dstep, long int n,
+              long int ny, double *y)
+{
+  long int nn, kk, j;
+  double   d, f, c, s, sc;
+
+  for (nn=0; nn<ny; nn++, n++, D+=Dstep) {
+    /* round as MATLAB, half away from zero */
+    d = (*D >= 0.0) ? floor(*D + 0.5) : -floor(0.5 - *D);
+    f = *D - d;
+    /* x(j - k) is the tap k */
+    j = n - (long int)d;
+
+    if (f == 0.0) {
+      y[nn] = (j >= 0 && j < Nx) ? x[j] : fill;
+      continue;
+    }
+
+    s  = 0.0;
+    sc = 0.0;
+    if (j - half >= 0 && j + half < Nx) {
+      for (kk=-half; kk<=half; kk++) {
+        c   = ws[kk + half]/(f - kk);
+        sc += c;
+        s  += c*x[j - kk];
+      }
+    }
+    else {
+      /* near the ends, the taps out of x take the fill value */
+      for (kk=-half; kk<=half; kk++) {
+        c   = ws[kk + half]/(f - kk);
+        sc += c;
+        s  += c*((j - kk >= 0 && j - kk < Nx) ? x[j - kk] : fill);
+      }
+    }
+    y[nn] = s/sc;
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_fdelay version %s\n", version);
+  mexPrintf("  usage:    y = ltpda_fdelay(x, D, chan, ws, fill, off, Ny);\n");
+  mexPrintf("            y = ltpda_fdelay(x, D, chan, ws, fill, off, Ny, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
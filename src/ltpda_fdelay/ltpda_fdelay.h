@@ -0,0 +1,11 @@
+/*
+ * Header for ltpda_fdelay.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void fd_block(const double *x, long int Nx, double fill, const double *ws,
+              long int half, const double *D, long int Dstep, long int n,
+              long int ny, double *y);
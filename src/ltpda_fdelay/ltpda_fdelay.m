@@ -0,0 +1,29 @@
+% LTPDA_FDELAY A mex file to delay data by fractional numbers of samples.
+%
+% function y = ltpda_fdelay(x, D, chan, ws, fill, off, Ny);
+% function y = ltpda_fdelay(x, D, chan, ws, fill, off, Ny, nthreads);
+%
+% Applies the windowed-sinc fractional delay filters of
+% utils.math.fdfilt_delay_core. The filter of each output sample is built
+% from the signed window with a division per tap, so that the delays may
+% change from a sample to the next. The output sample n (0-based) of a
+% delay is the input sample off+n-D of its channel; the input samples out
+% of x take the fill value of the channel. The blocks of output samples of
+% the delays are shared between threads.
+%
+% Inputs:
+%          x - The data (Nx x Nchannels)
+%          D - The delays in samples: a row of constant delays (1 x
+%              Ndelays), or the delays of each output sample (Ny x Ndelays)
+%       chan - The channel of each delay (1 x Ndelays)
+%         ws - The signed window (-1)^k*w(k), k = -(N-1)/2..(N-1)/2
+%       fill - The value of the samples out of x (1 x Nchannels)
+%        off - The index in x of the output sample 0
+%         Ny - The number of output samples
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The delayed data (Ny x Ndelays)
+%
+% This is the compiled engine of utils.math.fdelay.
+%
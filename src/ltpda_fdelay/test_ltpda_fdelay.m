@@ -0,0 +1,51 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+fs       = 4;
+
+x = randn(Nsamples, 1) + 0.1;
+
+%% Validate against the filter of fdfilt_delay_core
+
+kernel = utils.math.fdkernel(51, 'blackman3');
+D  = 33.27;
+k  = -kernel.half:kernel.half;
+h  = sinc(D - round(D) - k).*kernel.w;
+h  = h/sum(h);
+m  = mean(x);
+i0 = kernel.N + kernel.half - round(D);
+yr = filter(h, 1, [zeros(kernel.N, 1); x - m; zeros(kernel.N, 1)]) + m;
+yr = yr(i0+1:i0+Nsamples);
+
+tic
+y = utils.math.fdelay(x, D, kernel);
+tmex = toc
+max(abs(y - yr))
+
+%% Many time-varying delays of the same channel
+
+t = (0:Nsamples-1)'/fs;
+D = [30 + 1e-3*sin(2*pi*t/1e4), 31 + 2e-3*cos(2*pi*t/1e4), 32.5*ones(Nsamples, 1)];
+tic
+yd = utils.math.fdelay(x, D, kernel);
+tmex = toc
+max(abs(yd(:, 3) - utils.math.fdelay(x, 32.5, kernel)))
+
+%% The same output with one thread
+
+yd1 = ltpda_fdelay(x, D, [1 1 1], kernel.ws, mean(x), 0, Nsamples, 1);
+isequal(yd1, yd)
+
+%% Streaming in chunks
+
+ys = [];
+zi = 33;
+for kk = 1:10
+  [yk, zi] = utils.math.fdelay(x((kk-1)*Nsamples/10+1:kk*Nsamples/10), D((kk-1)*Nsamples/10+1:kk*Nsamples/10, :), kernel, zi);
+  ys = [ys; yk];
+end
+[yk, zi] = utils.math.fdelay(zeros(kernel.half, 1), D(end-kernel.half+1:end, :), kernel, zi);
+ys = [ys; yk];
+y0 = ltpda_fdelay(x, D, [1 1 1], kernel.ws, 0, 0, Nsamples);
+max(max(abs(ys - y0)))
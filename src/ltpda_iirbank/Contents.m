@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_iirbank   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_iirbank\compile">src\ltpda_iirbank\compile</a>            -  package within MATLAB
+%   <a href="matlab:help src\ltpda_iirbank\ltpda_iirbank">src\ltpda_iirbank\ltpda_iirbank</a>      -  A mex file to filter data with a bank of IIR filters in a single pass.
+%   <a href="matlab:help src\ltpda_iirbank\test_ltpda_iirbank">src\ltpda_iirbank\test_ltpda_iirbank</a> - %
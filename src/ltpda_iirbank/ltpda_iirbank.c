@@ -0,0 +1,246 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_iirbank.h"
+
+#define DEBUG 0
+
+/* number of samples filtered by all the sections before moving on */
+#define BLOCK 4096
+
+/*
+ * A mex file to filter data with a bank of IIR filters in a single pass.
+ *
+ * The filters are in direct form II transposed, as in MATLAB's filter, with
+ * their coefficients padded with zeros to a common length M. The data are
+ * processed in blocks of BLOCK samples: each block goes through all the
+ * sections while it is in the cache, either
+ *
+ *   parallel - every section filters the input, the outputs are summed
+ *   serial   - every section filters the output of the previous one
+ *
+ * The channels, and the sections of a parallel bank, are independent and
+ * are shared between threads when the file is compiled with OpenMP. The
+ * outputs of a parallel bank are summed in a fixed order, so the result
+ * does not depend on the number of threads.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial, nthreads);
+ *
+ * x      - N x Nch
+ * num    - Nfilt x M
+ * den    - Nfilt x M
+ * Zi     - (M-1) x Nfilt x Nch
+ * serial - 0 for a parallel bank, 1 for a serial bank
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y, *Zf;
+
+  /* inputs */
+  double *x, *num, *den, *Zi;
+
+  /* normalised coefficients, one row per section */
+  double *nc, *dc;
+
+  /* block outputs of the sections of a parallel bank */
+  double *w;
+
+  long int N, Nch, Nfilt, M, Ns, ff, kk;
+  mwSize   dims[3];
+  int      serial;
+  int      nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 5 || nrhs == 6) && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<4; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, coefficients and states must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      N   = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      N   = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    Nfilt = (long int)mxGetM(prhs[1]);
+    M     = (long int)mxGetN(prhs[1]);
+    Ns    = M - 1;
+
+    if ( Nfilt < 1 || M < 1 ||
+         (long int)mxGetM(prhs[2]) != Nfilt || (long int)mxGetN(prhs[2]) != M )
+      mexErrMsgTxt("### the numerator and denominator coefficients must have the same size");
+    if ( (long int)mxGetNumberOfElements(prhs[3]) != Ns*Nfilt*Nch )
+      mexErrMsgTxt("### the initial states must be a (M-1) x Nfilt x Nch array");
+
+    serial   = (int)mxGetScalar(prhs[4]);
+    nthreads = 0;
+    if (nrhs == 6)
+      nthreads = (int)mxGetScalar(prhs[5]);
+
+    #if DEBUG
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Nfilt: %d\n", Nfilt);
+    mexPrintf("M: %d\n", M);
+    #endif
+
+    /*----------------- set inputs*/
+    x   = mxGetPr(prhs[0]);
+    num = mxGetPr(prhs[1]);
+    den = mxGetPr(prhs[2]);
+    Zi  = mxGetPr(prhs[3]);
+
+    nc = (double*)calloc(Nfilt*M, sizeof(double));
+    dc = (double*)calloc(Nfilt*M, sizeof(double));
+    for (ff=0; ff<Nfilt; ff++) {
+      if (den[ff] == 0.0) {
+        free(nc);
+        free(dc);
+        mexErrMsgTxt("### the first denominator coefficient of each filter must be nonzero");
+      }
+      for (kk=0; kk<M; kk++) {
+        nc[ff*M+kk] = num[ff + kk*Nfilt]/den[ff];
+        dc[ff*M+kk] = den[ff + kk*Nfilt]/den[ff];
+      }
+    }
+
+    /* outputs, with the shape of the input */
+    plhs[0] = mxCreateDoubleMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    /* the states are updated in place in the output array */
+    dims[0] = (mwSize)Ns;
+    dims[1] = (mwSize)Nfilt;
+    dims[2] = (mwSize)Nch;
+    if (nlhs > 1) {
+      plhs[1] = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+      Zf = mxGetPr(plhs[1]);
+    }
+    else {
+      Zf = (double*)calloc(Ns*Nfilt*Nch+1, sizeof(double));
+    }
+    memcpy(Zf, Zi, Ns*Nfilt*Nch*sizeof(double));
+
+    w = NULL;
+    if (!serial)
+      w = (double*)calloc(BLOCK*Nfilt*Nch, sizeof(double));
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    #pragma omp parallel
+    {
+      long int b0, nb, pp, cc, ss, nn;
+      double  *yb, *wb;
+
+      for (b0=0; b0<N; b0+=BLOCK) {
+        nb = (N - b0 < BLOCK) ? N - b0 : BLOCK;
+
+        if (serial) {
+          #pragma omp for schedule(static)
+          for (cc=0; cc<Nch; cc++) {
+            yb = y + cc*N + b0;
+            iir_section(x + cc*N + b0, yb, nb, nc, dc, M, Zf + cc*Ns*Nfilt);
+            for (ss=1; ss<Nfilt; ss++)
+              iir_section(yb, yb, nb, nc + ss*M, dc + ss*M, M, Zf + ss*Ns + cc*Ns*Nfilt);
+          }
+        }
+        else {
+          #pragma omp for schedule(static)
+          for (pp=0; pp<Nch*Nfilt; pp++) {
+            cc = pp/Nfilt;
+            ss = pp%Nfilt;
+            iir_section(x + cc*N + b0, w + pp*BLOCK, nb, nc + ss*M, dc + ss*M, M, Zf + ss*Ns + cc*Ns*Nfilt);
+          }
+          #pragma omp for schedule(static)
+          for (cc=0; cc<Nch; cc++) {
+            yb = y + cc*N + b0;
+            wb = w + cc*Nfilt*BLOCK;
+            for (nn=0; nn<nb; nn++)
+              yb[nn] = wb[nn];
+            for (ss=1; ss<Nfilt; ss++)
+              for (nn=0; nn<nb; nn++)
+                yb[nn] += wb[ss*BLOCK + nn];
+          }
+        }
+      }
+    }
+
+    if (nlhs <= 1)
+      free(Zf);
+    if (w != NULL)
+      free(w);
+    free(nc);
+    free(dc);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Filter N samples of x into y (which may be x) with one section in direct
+ * form II transposed. The coefficients are normalised by den[0], and the
+ * M-1 states in z are updated.
+ */
+void iir_section(const double *x, double *y, long int N,
+                 const double *num, const double *den, long int M,
+                 double *z)
+{
+  long int nn, kk;
+  double   xi, yo;
+
+  if (M == 1) {
+    for (nn=0; nn<N; nn++)
+      y[nn] = num[0]*x[nn];
+    return;
+  }
+
+  for (nn=0; nn<N; nn++) {
+    xi = x[nn];
+    yo = num[0]*xi + z[0];
+    for (kk=1; kk<M-1; kk++)
+      z[kk-1] = z[kk] + num[kk]*xi - den[kk]*yo;
+    z[M-2] = num[M-1]*xi - den[M-1]*yo;
+    y[nn] = yo;
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_iirbank version %s\n", version);
+  mexPrintf("  usage:    [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial);\n");
+  mexPrintf("            [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,11 @@
+/*
+ * Header for ltpda_iirbank.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void iir_section(const double *x, double *y, long int N,
+                 const double *num, const double *den, long int M,
+                 double *z);
@@ -0,0 +1,25 @@
+% LTPDA_IIRBANK A mex file to filter data with a bank of IIR filters in a single pass.
+%
+% function [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial);
+% function [y, Zf] = ltpda_iirbank(x, num, den, Zi, serial, nthreads);
+%
+% Applies all the filters of a bank, in direct form II transposed as
+% FILTER, while reading the data once. Each block of samples goes through
+% all the sections before the next one is read. In a parallel bank the
+% outputs of the filters are summed; in a serial bank each filter filters
+% the output of the previous one.
+%
+% Inputs:
+%          x - The data (Nsamples x Nchannels, or a vector)
+%        num - The numerator coefficients (Nfilters x M), padded with zeros
+%        den - The denominator coefficients (Nfilters x M), padded with zeros
+%         Zi - The initial states ((M-1) x Nfilters x Nchannels)
+%     serial - 0 for a parallel bank, 1 for a serial bank
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The filtered data, with the size of x
+%         Zf - The final states ((M-1) x Nfilters x Nchannels)
+%
+% This is the compiled version of utils.math.iirbank.
+%
@@ -0,0 +1,61 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nch      = 3;
+
+%% Validate against filter, for a parallel and a serial bank
+
+f1 = miir(plist('type', 'lowpass', 'order', 4, 'fc', 0.1, 'fs', 10));
+f2 = miir(plist('type', 'highpass', 'order', 2, 'fc', 1, 'fs', 10));
+f3 = miir(plist('type', 'bandpass', 'order', 3, 'fc', [0.5 2], 'fs', 10));
+filts = [f1 f2 f3];
+
+M   = max(arrayfun(@(f) max(numel(f.a), numel(f.b)), filts));
+num = zeros(numel(filts), M);
+den = zeros(numel(filts), M);
+for ff = 1:numel(filts)
+  num(ff, 1:numel(filts(ff).a)) = filts(ff).a;
+  den(ff, 1:numel(filts(ff).b)) = filts(ff).b;
+end
+x  = randn(Nsamples, Nch);
+Zi = randn(M-1, numel(filts), Nch);
+
+for serial = [0 1]
+  
+  tic
+  [yx, Zfx] = ltpda_iirbank(x, num, den, Zi, serial);
+  tmex = toc
+  
+  tic
+  y  = zeros(size(x));
+  Zf = zeros(size(Zi));
+  for cc = 1:Nch
+    u = x(:,cc);
+    for ff = 1:numel(filts)
+      [yf, Zf(:,ff,cc)] = filter(num(ff,:), den(ff,:), u, Zi(:,ff,cc));
+      if serial
+        u = yf;
+      else
+        y(:,cc) = y(:,cc) + yf;
+      end
+    end
+    if serial
+      y(:,cc) = u;
+    end
+  end
+  tmat = toc
+  
+  max(abs(yx(:) - y(:)))/max(abs(y(:)))
+  max(abs(Zfx(:) - Zf(:)))
+  tmat/tmex
+  
+end
+
+%% Continuity of the states between two calls
+
+[y1, Z1] = ltpda_iirbank(x(1:1000,1), num, den, Zi(:,:,1), 0);
+[y2, Z2] = ltpda_iirbank(x(1001:end,1), num, den, Z1, 0);
+[y, Z]   = ltpda_iirbank(x(:,1), num, den, Zi(:,:,1), 0);
+max(abs([y1; y2] - y))
+max(abs(Z2(:) - Z(:)))
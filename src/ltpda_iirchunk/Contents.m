@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_iirchunk   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_iirchunk\compile">src\ltpda_iirchunk\compile</a>             -  package within MATLAB
+%   <a href="matlab:help src\ltpda_iirchunk\ltpda_iirchunk">src\ltpda_iirchunk\ltpda_iirchunk</a>      -  A mex file to filter a long series with an IIR filter in parallel chunks.
+%   <a href="matlab:help src\ltpda_iirchunk\test_ltpda_iirchunk">src\ltpda_iirchunk\test_ltpda_iirchunk</a> - %
@@ -0,0 +1,343 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_iirchunk.h"
+
+#define DEBUG 0
+
+/*
+ * A mex file to filter a long series with an IIR filter in parallel chunks.
+ *
+ * The filter is in direct form II transposed, as in MATLAB's filter, which
+ * is the state-space system
+ *
+ *   y[n]   = c*z[n] + d*x[n]
+ *   z[n+1] = F*z[n] + g*x[n]
+ *
+ * with the companion matrix F(i,1) = -den(i+1), F(i,i+1) = 1. Since the
+ * filter is linear, the output of a chunk is the output from zero state
+ * plus the free response of the state at the start of the chunk:
+ *
+ *   1. every chunk is filtered from zero state (the first one from Zi), in
+ *      parallel, which gives its output and its final state e(p)
+ *   2. the states at the chunk boundaries are propagated serially,
+ *      s(p+1) = e(p) + F^L*s(p), with F^L computed once by squaring
+ *   3. the free response of s(p) is added to each chunk, in parallel
+ *
+ * Only step 2 is serial, and it costs one small matrix-vector product per
+ * chunk. The result is exact up to rounding.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks, nthreads);
+ *
+ * x       - N x Nch
+ * num     - 1 x M
+ * den     - 1 x M
+ * Zi      - (M-1) x Nch
+ * nchunks - number of chunks, 0 for one per thread
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y, *Zf;
+
+  /* inputs */
+  double *x, *num, *den, *Zi;
+
+  /* normalised coefficients */
+  double *nc, *dc;
+
+  /* F^L and its workspace */
+  double *FL, *W;
+
+  /* final states of the chunks from zero state, states at their start */
+  double *E, *S;
+
+  long int N, Nch, M, Ns, L, P, pp, cc, kk, jj;
+  int      nchunks;
+  int      nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 5 || nrhs == 6) && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<4; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, coefficients and states must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      N   = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      N   = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    M  = (long int)mxGetNumberOfElements(prhs[1]);
+    Ns = M - 1;
+
+    if ( M < 1 || (long int)mxGetNumberOfElements(prhs[2]) != M )
+      mexErrMsgTxt("### the numerator and denominator coefficients must have the same length");
+    if ( (long int)mxGetNumberOfElements(prhs[3]) != Ns*Nch )
+      mexErrMsgTxt("### the initial states must be a (M-1) x Nch array");
+
+    nchunks  = (int)mxGetScalar(prhs[4]);
+    nthreads = 0;
+    if (nrhs == 6)
+      nthreads = (int)mxGetScalar(prhs[5]);
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    if (nchunks <= 0)
+      nchunks = omp_get_max_threads();
+    #endif
+    if (nchunks <= 0)
+      nchunks = 1;
+
+    /* chunks of L samples, none of them empty */
+    P = (N < nchunks) ? N : nchunks;
+    if (P < 1)
+      P = 1;
+    L = (N + P - 1)/P;
+    if (L < 1)
+      L = 1;
+    P = (N + L - 1)/L;
+    if (P < 1)
+      P = 1;
+
+    #if DEBUG
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("M: %d\n", M);
+    mexPrintf("chunks: %d of %d samples\n", P, L);
+    #endif
+
+    /*----------------- set inputs*/
+    x   = mxGetPr(prhs[0]);
+    num = mxGetPr(prhs[1]);
+    den = mxGetPr(prhs[2]);
+    Zi  = mxGetPr(prhs[3]);
+
+    if (den[0] == 0.0)
+      mexErrMsgTxt("### the first denominator coefficient must be nonzero");
+
+    nc = (double*)calloc(M, sizeof(double));
+    dc = (double*)calloc(M, sizeof(double));
+    for (kk=0; kk<M; kk++) {
+      nc[kk] = num[kk]/den[0];
+      dc[kk] = den[kk]/den[0];
+    }
+
+    /* outputs, with the shape of the input */
+    plhs[0] = mxCreateDoubleMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(Ns, Nch, mxREAL);
+      Zf = mxGetPr(plhs[1]);
+    }
+    else {
+      Zf = (double*)calloc(Ns*Nch+1, sizeof(double));
+    }
+    memcpy(Zf, Zi, Ns*Nch*sizeof(double));
+
+    FL = (double*)calloc(Ns*Ns+1, sizeof(double));
+    W  = (double*)calloc(2*Ns*Ns+1, sizeof(double));
+    E  = (double*)calloc(P*Ns+1, sizeof(double));
+    S  = (double*)calloc(P*Ns+1, sizeof(double));
+
+    /* propagation of the state over one chunk */
+    if (P > 1 && Ns > 0)
+      companion_power(dc, Ns, L, FL, W);
+
+    /* do the business */
+    for (cc=0; cc<Nch; cc++) {
+
+      if (P == 1) {
+        iir_filter(x + cc*N, y + cc*N, N, nc, dc, M, Zf + cc*Ns);
+        continue;
+      }
+
+      /* 1. the chunks from zero state, the first one from Zi */
+      memset(E, 0, P*Ns*sizeof(double));
+      memcpy(E, Zf + cc*Ns, Ns*sizeof(double));
+      #pragma omp parallel for schedule(static)
+      for (pp=0; pp<P; pp++) {
+        long int n0 = pp*L;
+        long int nn = (N - n0 < L) ? N - n0 : L;
+        iir_filter(x + cc*N + n0, y + cc*N + n0, nn, nc, dc, M, E + pp*Ns);
+      }
+
+      /* 2. the states at the start of the chunks */
+      memcpy(S + Ns, E, Ns*sizeof(double));
+      for (pp=1; pp<P-1; pp++) {
+        for (kk=0; kk<Ns; kk++) {
+          double s = E[pp*Ns + kk];
+          for (jj=0; jj<Ns; jj++)
+            s += FL[kk*Ns + jj]*S[pp*Ns + jj];
+          S[(pp+1)*Ns + kk] = s;
+        }
+      }
+
+      /* 3. the free responses of these states */
+      #pragma omp parallel for schedule(static)
+      for (pp=1; pp<P; pp++) {
+        long int n0 = pp*L;
+        long int nn = (N - n0 < L) ? N - n0 : L;
+        iir_free(y + cc*N + n0, nn, dc, M, S + pp*Ns);
+      }
+
+      /* final states */
+      for (kk=0; kk<Ns; kk++)
+        Zf[cc*Ns + kk] = E[(P-1)*Ns + kk] + S[(P-1)*Ns + kk];
+    }
+
+    if (nlhs <= 1)
+      free(Zf);
+    free(FL);
+    free(W);
+    free(E);
+    free(S);
+    free(nc);
+    free(dc);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Filter N samples of x into y in direct form II transposed. The
+ * coefficients are normalised by den[0], and the M-1 states in z are
+ * updated.
+ */
+void iir_filter(const double *x, double *y, long int N,
+                const double *num, const double *den, long int M,
+                double *z)
+{
+  long int nn, kk;
+  double   xi, yo;
+
+  if (M == 1) {
+    for (nn=0; nn<N; nn++)
+      y[nn] = num[0]*x[nn];
+    return;
+  }
+
+  for (nn=0; nn<N; nn++) {
+    xi = x[nn];
+    yo = num[0]*xi + z[0];
+    for (kk=1; kk<M-1; kk++)
+      z[kk-1] = z[kk] + num[kk]*xi - den[kk]*yo;
+    z[M-2] = num[M-1]*xi - den[M-1]*yo;
+    y[nn] = yo;
+  }
+}
+
+/*
+ * Add to y the response of the filter to the states in z and no input,
+ * over N samples. The states in z are propagated.
+ */
+void iir_free(double *y, long int N, const double *den, long int M,
+              double *z)
+{
+  long int nn, kk;
+  double   yo;
+
+  if (M == 1)
+    return;
+
+  for (nn=0; nn<N; nn++) {
+    yo = z[0];
+    for (kk=1; kk<M-1; kk++)
+      z[kk-1] = z[kk] - den[kk]*yo;
+    z[M-2] = -den[M-1]*yo;
+    y[nn] += yo;
+  }
+}
+
+/*
+ * P = F^L for the Ns x Ns companion matrix of den (row-major), by
+ * repeated squaring. W is a workspace of 2*Ns*Ns values.
+ */
+void companion_power(const double *den, long int Ns, long int L,
+                     double *P, double *W)
+{
+  double  *B, *T;
+  long int ii;
+
+  B = W;
+  T = W + Ns*Ns;
+
+  memset(B, 0, Ns*Ns*sizeof(double));
+  for (ii=0; ii<Ns; ii++) {
+    B[ii*Ns] = -den[ii+1];
+    if (ii+1 < Ns)
+      B[ii*Ns + ii+1] += 1.0;
+  }
+
+  memset(P, 0, Ns*Ns*sizeof(double));
+  for (ii=0; ii<Ns; ii++)
+    P[ii*Ns + ii] = 1.0;
+
+  while (L > 0) {
+    if (L & 1) {
+      mat_mult(P, B, T, Ns);
+      memcpy(P, T, Ns*Ns*sizeof(double));
+    }
+    L >>= 1;
+    if (L > 0) {
+      mat_mult(B, B, T, Ns);
+      memcpy(B, T, Ns*Ns*sizeof(double));
+    }
+  }
+}
+
+/*
+ * C = A*B for n x n row-major matrices
+ */
+void mat_mult(const double *A, const double *B, double *C, long int n)
+{
+  long int ii, jj, kk;
+  double   s;
+
+  for (ii=0; ii<n; ii++) {
+    for (jj=0; jj<n; jj++) {
+      s = 0.0;
+      for (kk=0; kk<n; kk++)
+        s += A[ii*n + kk]*B[kk*n + jj];
+      C[ii*n + jj] = s;
+    }
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_iirchunk version %s\n", version);
+  mexPrintf("  usage:    [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks);\n");
+  mexPrintf("            [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
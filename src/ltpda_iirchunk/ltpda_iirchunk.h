@@ -0,0 +1,19 @@
+/*
+ * Header for ltpda_iirchunk.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void iir_filter(const double *x, double *y, long int N,
+                const double *num, const double *den, long int M,
+                double *z);
+
+void iir_free(double *y, long int N, const double *den, long int M,
+              double *z);
+
+void companion_power(const double *den, long int Ns, long int L,
+                     double *P, double *W);
+
+void mat_mult(const double *A, const double *B, double *C, long int n);
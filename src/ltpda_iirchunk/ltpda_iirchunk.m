@@ -0,0 +1,25 @@
+% LTPDA_IIRCHUNK A mex file to filter a long series with an IIR filter in parallel chunks.
+%
+% function [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks);
+% function [y, Zf] = ltpda_iirchunk(x, num, den, Zi, nchunks, nthreads);
+%
+% Filters the data as FILTER does, in direct form II transposed, but splits
+% each channel into chunks which are filtered from zero state in parallel.
+% The states at the chunk boundaries are then propagated with the powers
+% of the companion matrix of the filter, and their free responses are
+% added to the chunks. The result is the one of FILTER up to rounding.
+%
+% Inputs:
+%          x - The data (Nsamples x Nchannels, or a vector)
+%        num - The numerator coefficients (1 x M), padded with zeros
+%        den - The denominator coefficients (1 x M), padded with zeros
+%         Zi - The initial states ((M-1) x Nchannels)
+%    nchunks - The number of chunks, 0 for one per thread
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The filtered data, with the size of x
+%         Zf - The final states ((M-1) x Nchannels)
+%
+% This is the compiled version of utils.math.iirchunk.
+%
@@ -0,0 +1,39 @@
+clear all;
+compile
+
+Nsamples = 1e7;
+
+%% Validate against filter, for several numbers of chunks
+
+f = miir(plist('type', 'lowpass', 'order', 6, 'fc', 0.01, 'fs', 10));
+M   = max(numel(f.a), numel(f.b));
+num = zeros(1, M);
+den = zeros(1, M);
+num(1:numel(f.a)) = f.a;
+den(1:numel(f.b)) = f.b;
+
+x  = randn(Nsamples, 1);
+Zi = randn(M-1, 1);
+
+tic
+[y, Zf] = filter(num, den, x, Zi);
+tmat = toc
+
+for nchunks = [1 2 7 64 0]
+  
+  tic
+  [yx, Zfx] = ltpda_iirchunk(x, num, den, Zi, nchunks);
+  tmex = toc
+  
+  max(abs(yx - y))/max(abs(y))
+  max(abs(Zfx - Zf))
+  tmat/tmex
+  
+end
+
+%% Continuity of the states between two calls
+
+[y1, Z1] = ltpda_iirchunk(x(1:1000), num, den, Zi, 4);
+[y2, Z2] = ltpda_iirchunk(x(1001:end), num, den, Z1, 4);
+max(abs([y1; y2] - y))
+max(abs(Z2 - Zf))
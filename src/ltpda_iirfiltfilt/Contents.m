@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_iirfiltfilt   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_iirfiltfilt\compile">src\ltpda_iirfiltfilt\compile</a>                -  package within MATLAB
+%   <a href="matlab:help src\ltpda_iirfiltfilt\ltpda_iirfiltfilt">src\ltpda_iirfiltfilt\ltpda_iirfiltfilt</a>      -  A mex file for the zero-phase filtering of data with a bank of IIR filters.
+%   <a href="matlab:help src\ltpda_iirfiltfilt\test_ltpda_iirfiltfilt">src\ltpda_iirfiltfilt\test_ltpda_iirfiltfilt</a> - %
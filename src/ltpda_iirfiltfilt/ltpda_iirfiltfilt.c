@@ -0,0 +1,315 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_iirfiltfilt.h"
+
+#define DEBUG 0
+
+/* number of samples filtered by all the sections before moving on */
+#define BLOCK 4096
+
+/*
+ * A mex file for the zero-phase filtering of data with a bank of IIR filters.
+ *
+ * The data are extended at both ends by a reflection of nfact samples, as
+ * in MATLAB's filtfilt, and filtered forward and then backward by the bank.
+ * Each pass starts from the steady state of the sections for the first
+ * sample it sees: the unit steady states zi of the sections (see iirinit)
+ * are scaled by that sample, and in a serial bank also by the DC gains of
+ * the previous sections.
+ *
+ * Both passes work in place on the extended data, in blocks of BLOCK
+ * samples which go through all the sections while they are in the cache.
+ * The backward pass reads the data from the end, so nothing is reversed or
+ * copied. The sections are shared between threads when the file is
+ * compiled with OpenMP:
+ *
+ *   parallel - all the sections filter the same block, the outputs are
+ *              summed in a fixed order
+ *   serial   - the section s filters the block b-s while the section 0
+ *              filters the block b
+ *
+ * $Id$
+ */
+
+
+/*
+ * function y = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact, nthreads);
+ *
+ * x      - N x Nch
+ * num    - Nfilt x M
+ * den    - Nfilt x M
+ * zi     - (M-1) x Nfilt
+ * serial - 0 for a parallel bank, 1 for a serial bank
+ * nfact  - number of samples of the reflections
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y;
+
+  /* inputs */
+  double *x, *num, *den, *zi;
+
+  /* normalised coefficients, one row per section, and DC gains */
+  double *nc, *dc, *gain;
+
+  /* extended data, states and block outputs of a parallel bank */
+  double *E, *F, *Z, *w;
+
+  long int N, Nch, Nfilt, M, Ns, Ne, nfact, ff, kk, cc;
+  int      serial;
+  int      nthreads;
+  double   sn, sd;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 6 || nrhs == 7) && nlhs == 1 )/* let's go */
+  {
+    for (kk=0; kk<4; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, coefficients and states must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      N   = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      N   = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    Nfilt = (long int)mxGetM(prhs[1]);
+    M     = (long int)mxGetN(prhs[1]);
+    Ns    = M - 1;
+
+    if ( Nfilt < 1 || M < 1 ||
+         (long int)mxGetM(prhs[2]) != Nfilt || (long int)mxGetN(prhs[2]) != M )
+      mexErrMsgTxt("### the numerator and denominator coefficients must have the same size");
+    if ( (long int)mxGetNumberOfElements(prhs[3]) != Ns*Nfilt )
+      mexErrMsgTxt("### the initial states must be a (M-1) x Nfilt array");
+
+    serial   = (int)mxGetScalar(prhs[4]);
+    nfact    = (long int)mxGetScalar(prhs[5]);
+    nthreads = 0;
+    if (nrhs == 7)
+      nthreads = (int)mxGetScalar(prhs[6]);
+
+    if (nfact < 0)
+      nfact = 0;
+    if (N <= nfact)
+      mexErrMsgTxt("### Data must have length more than 3 times the filter order.");
+
+    #if DEBUG
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Nfilt: %d\n", Nfilt);
+    mexPrintf("M: %d\n", M);
+    mexPrintf("nfact: %d\n", nfact);
+    #endif
+
+    /*----------------- set inputs*/
+    x   = mxGetPr(prhs[0]);
+    num = mxGetPr(prhs[1]);
+    den = mxGetPr(prhs[2]);
+    zi  = mxGetPr(prhs[3]);
+
+    nc   = (double*)calloc(Nfilt*M, sizeof(double));
+    dc   = (double*)calloc(Nfilt*M, sizeof(double));
+    gain = (double*)calloc(Nfilt, sizeof(double));
+    for (ff=0; ff<Nfilt; ff++) {
+      if (den[ff] == 0.0) {
+        free(nc);
+        free(dc);
+        free(gain);
+        mexErrMsgTxt("### the first denominator coefficient of each filter must be nonzero");
+      }
+      sn = 0.0;
+      sd = 0.0;
+      for (kk=0; kk<M; kk++) {
+        nc[ff*M+kk] = num[ff + kk*Nfilt]/den[ff];
+        dc[ff*M+kk] = den[ff + kk*Nfilt]/den[ff];
+        sn += nc[ff*M+kk];
+        sd += dc[ff*M+kk];
+      }
+      gain[ff] = (sd != 0.0) ? sn/sd : 0.0;
+    }
+
+    /* output, with the shape of the input */
+    plhs[0] = mxCreateDoubleMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    Ne = N + 2*nfact;
+    E  = (double*)calloc(Ne, sizeof(double));
+    F  = NULL;
+    w  = NULL;
+    if (!serial) {
+      F = (double*)calloc(Ne, sizeof(double));
+      w = (double*)calloc(BLOCK*Nfilt, sizeof(double));
+    }
+    Z = (double*)calloc(Ns*Nfilt+1, sizeof(double));
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    for (cc=0; cc<Nch; cc++) {
+      const double *xc = x + cc*N;
+
+      /* odd reflections of the data at both ends */
+      for (kk=0; kk<nfact; kk++) {
+        E[kk]           = 2.0*xc[0] - xc[nfact-kk];
+        E[nfact+N+kk]   = 2.0*xc[N-1] - xc[N-2-kk];
+      }
+      memcpy(E + nfact, xc, N*sizeof(double));
+
+      if (serial) {
+        bank_pass(E, E, Ne,  1, nc, dc, zi, gain, Nfilt, M, serial, Z, w);
+        bank_pass(E, E, Ne, -1, nc, dc, zi, gain, Nfilt, M, serial, Z, w);
+      }
+      else {
+        bank_pass(E, F, Ne,  1, nc, dc, zi, gain, Nfilt, M, serial, Z, w);
+        bank_pass(F, E, Ne, -1, nc, dc, zi, gain, Nfilt, M, serial, Z, w);
+      }
+
+      memcpy(y + cc*N, E + nfact, N*sizeof(double));
+    }
+
+    free(E);
+    if (F != NULL)
+      free(F);
+    if (w != NULL)
+      free(w);
+    free(Z);
+    free(nc);
+    free(dc);
+    free(gain);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * One pass of the bank over the N samples of in, forward (dir = 1) or
+ * backward (dir = -1), into out. out may be in for a serial bank. The
+ * states Z start from the steady state for the first sample of the pass.
+ */
+void bank_pass(double *in, double *out, long int N, long int dir,
+               const double *nc, const double *dc, const double *zi,
+               const double *gain, long int Nfilt, long int M,
+               int serial, double *Z, double *w)
+{
+  long int Ns, Nb, ff, kk;
+  double   u;
+
+  Ns = M - 1;
+  Nb = (N + BLOCK - 1)/BLOCK;
+
+  /* initial states */
+  u = (dir > 0) ? in[0] : in[N-1];
+  for (ff=0; ff<Nfilt; ff++) {
+    for (kk=0; kk<Ns; kk++)
+      Z[ff*Ns + kk] = zi[ff*Ns + kk]*u;
+    if (serial)
+      u *= gain[ff];
+  }
+
+  #pragma omp parallel
+  {
+    long int bb, tt, ss, nb, nn, p0;
+    double  *po, s;
+
+    if (serial) {
+      /* wavefront over the blocks and the sections */
+      for (tt=0; tt<Nb+Nfilt-1; tt++) {
+        #pragma omp for schedule(static)
+        for (ss=0; ss<Nfilt; ss++) {
+          bb = tt - ss;
+          if (bb >= 0 && bb < Nb) {
+            nb = (N - bb*BLOCK < BLOCK) ? N - bb*BLOCK : BLOCK;
+            p0 = (dir > 0) ? bb*BLOCK : N-1-bb*BLOCK;
+            iir_section(out + p0, dir, out + p0, dir, nb,
+                        nc + ss*M, dc + ss*M, M, Z + ss*Ns);
+          }
+        }
+      }
+    }
+    else {
+      for (bb=0; bb<Nb; bb++) {
+        nb = (N - bb*BLOCK < BLOCK) ? N - bb*BLOCK : BLOCK;
+        p0 = (dir > 0) ? bb*BLOCK : N-1-bb*BLOCK;
+        #pragma omp for schedule(static)
+        for (ss=0; ss<Nfilt; ss++)
+          iir_section(in + p0, dir, w + ss*BLOCK, 1, nb,
+                      nc + ss*M, dc + ss*M, M, Z + ss*Ns);
+        #pragma omp single
+        {
+          po = out + p0;
+          for (nn=0; nn<nb; nn++) {
+            s = w[nn];
+            for (ss=1; ss<Nfilt; ss++)
+              s += w[ss*BLOCK + nn];
+            po[nn*dir] = s;
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Filter N samples of x with one section in direct form II transposed. The
+ * samples are x[0], x[sx], x[2*sx], ... and the outputs go to y[0], y[sy],
+ * y[2*sy], ...; y may be x. The coefficients are normalised by den[0], and
+ * the M-1 states in z are updated.
+ */
+void iir_section(const double *x, long int sx, double *y, long int sy,
+                 long int N, const double *num, const double *den, long int M,
+                 double *z)
+{
+  long int nn, kk;
+  double   xi, yo;
+
+  if (M == 1) {
+    for (nn=0; nn<N; nn++)
+      y[nn*sy] = num[0]*x[nn*sx];
+    return;
+  }
+
+  for (nn=0; nn<N; nn++) {
+    xi = x[nn*sx];
+    yo = num[0]*xi + z[0];
+    for (kk=1; kk<M-1; kk++)
+      z[kk-1] = z[kk] + num[kk]*xi - den[kk]*yo;
+    z[M-2] = num[M-1]*xi - den[M-1]*yo;
+    y[nn*sy] = yo;
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_iirfiltfilt version %s\n", version);
+  mexPrintf("  usage:    y = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact);\n");
+  mexPrintf("            y = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,16 @@
+/*
+ * Header for ltpda_iirfiltfilt.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void iir_section(const double *x, long int sx, double *y, long int sy,
+                 long int N, const double *num, const double *den, long int M,
+                 double *z);
+
+void bank_pass(double *in, double *out, long int N, long int dir,
+               const double *nc, const double *dc, const double *zi,
+               const double *gain, long int Nfilt, long int M,
+               int serial, double *Z, double *w);
@@ -0,0 +1,26 @@
+% LTPDA_IIRFILTFILT A mex file for the zero-phase filtering of data with a bank of IIR filters.
+%
+% function y = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact);
+% function y = ltpda_iirfiltfilt(x, num, den, zi, serial, nfact, nthreads);
+%
+% Extends the data by odd reflections of nfact samples at both ends, and
+% filters them forward and then backward with all the filters of the bank,
+% as FILTFILT does with a single filter. Each pass starts from the steady
+% state of the filters for its first sample. Both passes go over blocks of
+% samples in place, and the backward pass reads the data from the end.
+%
+% Inputs:
+%          x - The data (Nsamples x Nchannels, or a vector)
+%        num - The numerator coefficients (Nfilters x M), padded with zeros
+%        den - The denominator coefficients (Nfilters x M), padded with zeros
+%         zi - The steady states of the filters for a unit input
+%              ((M-1) x Nfilters), see utils.math.iirinit
+%     serial - 0 for a parallel bank, 1 for a serial bank
+%      nfact - The number of samples of the reflections
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The filtered data, with the size of x
+%
+% This is the compiled version of utils.math.filtfilt_filterbank.
+%
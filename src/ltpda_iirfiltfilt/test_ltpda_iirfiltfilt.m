@@ -0,0 +1,51 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+
+%% Validate against filtfilt of the combined filter, for a parallel and a serial bank
+
+f1 = miir(plist('type', 'lowpass', 'order', 4, 'fc', 0.1, 'fs', 10));
+f2 = miir(plist('type', 'highpass', 'order', 2, 'fc', 1, 'fs', 10));
+filts = [f1 f2];
+
+M   = max(arrayfun(@(f) max(numel(f.a), numel(f.b)), filts));
+num = zeros(numel(filts), M);
+den = zeros(numel(filts), M);
+zi  = zeros(M-1, numel(filts));
+for ff = 1:numel(filts)
+  num(ff, 1:numel(filts(ff).a)) = filts(ff).a;
+  den(ff, 1:numel(filts(ff).b)) = filts(ff).b;
+  zi(:, ff) = utils.math.iirinit(num(ff,:), den(ff,:));
+end
+x = randn(Nsamples, 1);
+
+% serial: the cascade of the filters
+a = conv(num(1,:), num(2,:));
+b = conv(den(1,:), den(2,:));
+tic
+y = filtfilt(a, b, x);
+tmat = toc
+tic
+yx = ltpda_iirfiltfilt(x, num, den, zi, 1, 3*(numel(b)-1));
+tmex = toc
+% the edges differ, as the steady states are set per filter
+max(abs(yx(1e4:end-1e4) - y(1e4:end-1e4)))/max(abs(y))
+tmat/tmex
+
+% parallel: the sum of the filters
+a = conv(num(1,:), den(2,:)) + conv(num(2,:), den(1,:));
+tic
+y = filtfilt(a, b, x);
+tmat = toc
+tic
+yx = ltpda_iirfiltfilt(x, num, den, zi, 0, 3*(numel(b)-1));
+tmex = toc
+max(abs(yx(1e4:end-1e4) - y(1e4:end-1e4)))/max(abs(y))
+tmat/tmex
+
+%% Constant data go through unchanged up to the DC gain
+
+yx = ltpda_iirfiltfilt(ones(1000, 1), num, den, zi, 1, 3*(numel(b)-1));
+g  = prod(sum(num, 2)./sum(den, 2))^2;
+max(abs(yx - g))
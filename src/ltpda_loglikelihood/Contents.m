@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_loglikelihood   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_loglikelihood\compile">src\ltpda_loglikelihood\compile</a>                  -  package within MATLAB
+%   <a href="matlab:help src\ltpda_loglikelihood\ltpda_loglikelihood">src\ltpda_loglikelihood\ltpda_loglikelihood</a>      -  A mex file to compute the frequency-domain log-likelihood of a multichannel model.
+%   <a href="matlab:help src\ltpda_loglikelihood\test_ltpda_loglikelihood">src\ltpda_loglikelihood\test_ltpda_loglikelihood</a> - %
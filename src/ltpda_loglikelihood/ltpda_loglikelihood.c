@@ -0,0 +1,294 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_loglikelihood.h"
+
+#define DEBUG 0
+/*
+ * A mex file to compute the frequency-domain log-likelihood of a
+ * multichannel model
+ *
+ *   h(f)  = TF(f) * in(f)
+ *   r(f)  = out(f) - h(f)
+ *   Lf(f) = real( r(f)' * S(f) * r(f) )
+ *   L     = sum(Lf)
+ *   snr   = sqrt(2) * real( sum(h'*S*out)^2 / sum(h'*S*h) )
+ *
+ * where S(f) is the inverse cross-spectral matrix of the noise. All the
+ * quantities are computed in a single pass over the frequencies. The
+ * frequencies are independent and are shared between threads when the file
+ * is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF, nthreads);
+ *
+ * in  - Nf x Nin
+ * out - Nf x Nout
+ * S   - Nf x Nout x Nout
+ * TF  - Nf x Nout x Nin
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *Lf;
+
+  /* inputs */
+  double *inr, *ini, *outr, *outi, *Sr, *Si, *TFr, *TFi;
+
+  /* per-frequency partial sums of h'*S*out and h'*S*h */
+  double *hsr, *hsi, *hhr, *hhi;
+
+  /* buffers for missing imaginary parts */
+  double *zin, *zout, *zS, *zTF;
+
+  long int Nf, Nin, Nout, ff;
+  double   L, HSr, HSi, HHr, HHi, num_r, num_i, den;
+  int      nthreads;
+  int      nt;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 4 || nrhs == 5) && (nlhs >= 1 && nlhs <= 3) )/* let's go */
+  {
+    for (nt=0; nt<4; nt++) {
+      if ( !mxIsDouble(prhs[nt]) )
+        mexErrMsgTxt("### the inputs must be double arrays");
+    }
+
+    Nf   = (long int)mxGetM(prhs[0]);
+    Nin  = (long int)mxGetN(prhs[0]);
+    Nout = (long int)mxGetN(prhs[1]);
+
+    if ( (long int)mxGetM(prhs[1]) != Nf ||
+         (long int)mxGetNumberOfElements(prhs[2]) != Nf*Nout*Nout ||
+         (long int)mxGetNumberOfElements(prhs[3]) != Nf*Nout*Nin )
+      mexErrMsgTxt("### the inputs have inconsistent sizes");
+
+    nthreads = 0;
+    if (nrhs == 5)
+      nthreads = (int)mxGetScalar(prhs[4]);
+
+    #if DEBUG
+    mexPrintf("Nf: %d\n", Nf);
+    mexPrintf("Nin: %d\n", Nin);
+    mexPrintf("Nout: %d\n", Nout);
+    #endif
+
+    /*----------------- set inputs*/
+    zin  = NULL;
+    zout = NULL;
+    zS   = NULL;
+    zTF  = NULL;
+    inr  = mxGetPr(prhs[0]);
+    ini  = imag_part(prhs[0], &zin);
+    outr = mxGetPr(prhs[1]);
+    outi = imag_part(prhs[1], &zout);
+    Sr   = mxGetPr(prhs[2]);
+    Si   = imag_part(prhs[2], &zS);
+    TFr  = mxGetPr(prhs[3]);
+    TFi  = imag_part(prhs[3], &zTF);
+
+    /* output Lf */
+    plhs[0] = mxCreateDoubleMatrix(1, 1, mxREAL);
+    if (nlhs > 1)
+      plhs[1] = mxCreateDoubleMatrix(1, 1, mxREAL);
+    if (nlhs > 2) {
+      plhs[2] = mxCreateDoubleMatrix(Nf, 1, mxREAL);
+      Lf = mxGetPr(plhs[2]);
+    }
+    else {
+      Lf = (double*)calloc(Nf+1, sizeof(double));
+    }
+
+    hsr = (double*)calloc(Nf+1, sizeof(double));
+    hsi = (double*)calloc(Nf+1, sizeof(double));
+    hhr = (double*)calloc(Nf+1, sizeof(double));
+    hhi = (double*)calloc(Nf+1, sizeof(double));
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    #pragma omp parallel
+    {
+      double *wr, *wi;
+      long int kk;
+
+      /* h, r and out, then S*r, S*out and S*h */
+      wr = (double*)calloc(6*Nout+1, sizeof(double));
+      wi = (double*)calloc(6*Nout+1, sizeof(double));
+
+      #pragma omp for schedule(static)
+      for (kk=0; kk<Nf; kk++) {
+        loglikelihood_freq(kk, Nf, Nin, Nout, inr, ini, outr, outi, Sr, Si, TFr, TFi,
+                           wr, wi, &(Lf[kk]), &(hsr[kk]), &(hsi[kk]), &(hhr[kk]), &(hhi[kk]));
+      }
+
+      free(wr);
+      free(wi);
+    }
+
+    /* sums over frequencies, in a fixed order */
+    L   = 0.0;
+    HSr = 0.0;
+    HSi = 0.0;
+    HHr = 0.0;
+    HHi = 0.0;
+    for (ff=0; ff<Nf; ff++) {
+      L   += Lf[ff];
+      HSr += hsr[ff];
+      HSi += hsi[ff];
+      HHr += hhr[ff];
+      HHi += hhi[ff];
+    }
+
+    mxGetPr(plhs[0])[0] = L;
+    if (nlhs > 1) {
+      /* real( HS^2 / HH ) */
+      num_r = HSr*HSr - HSi*HSi;
+      num_i = 2.0*HSr*HSi;
+      den   = HHr*HHr + HHi*HHi;
+      mxGetPr(plhs[1])[0] = sqrt(2.0) * (num_r*HHr + num_i*HHi)/den;
+    }
+
+    if (nlhs <= 2)
+      free(Lf);
+    free(hsr);
+    free(hsi);
+    free(hhr);
+    free(hhi);
+    if (zin != NULL)  free(zin);
+    if (zout != NULL) free(zout);
+    if (zS != NULL)   free(zS);
+    if (zTF != NULL)  free(zTF);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * The imaginary part of an array, or a buffer of zeros (returned in *buf,
+ * to be freed by the caller) if the array is real.
+ */
+double *imag_part(const mxArray *a, double **buf)
+{
+  if (mxIsComplex(a))
+    return mxGetPi(a);
+  *buf = (double*)calloc(mxGetNumberOfElements(a)+1, sizeof(double));
+  return *buf;
+}
+
+/*
+ * Contributions of the frequency bin ff.
+ *
+ *  wr,wi    - 6*Nout work space
+ *  Lf       - output, real( r'*S*r )
+ *  hsr,hsi  - output, h'*S*out
+ *  hhr,hhi  - output, h'*S*h
+ */
+void loglikelihood_freq(long int ff, long int Nf, long int Nin, long int Nout,
+                        const double *inr, const double *ini,
+                        const double *outr, const double *outi,
+                        const double *Sr, const double *Si,
+                        const double *TFr, const double *TFi,
+                        double *wr, double *wi,
+                        double *Lf, double *hsr, double *hsi, double *hhr, double *hhi)
+{
+  long int oo, jj, idx;
+  double  *hr, *hi, *rr, *ri, *sr, *si, *Srr, *Sri, *Sor, *Soi, *Shr, *Shi;
+  double   ar, ai, br, bi, lf, sr_, si_, hr_, hi_;
+
+  hr  = wr;          hi  = wi;
+  rr  = wr + Nout;   ri  = wi + Nout;
+  sr  = wr + 2*Nout; si  = wi + 2*Nout;
+  Srr = wr + 3*Nout; Sri = wi + 3*Nout;
+  Sor = wr + 4*Nout; Soi = wi + 4*Nout;
+  Shr = wr + 5*Nout; Shi = wi + 5*Nout;
+
+  /* h = TF*in, r = out - h */
+  for (oo=0; oo<Nout; oo++) {
+    hr[oo] = 0.0;
+    hi[oo] = 0.0;
+    for (jj=0; jj<Nin; jj++) {
+      idx = ff + oo*Nf + jj*Nf*Nout;
+      ar  = TFr[idx];
+      ai  = TFi[idx];
+      br  = inr[ff + jj*Nf];
+      bi  = ini[ff + jj*Nf];
+      hr[oo] += ar*br - ai*bi;
+      hi[oo] += ar*bi + ai*br;
+    }
+    sr[oo] = outr[ff + oo*Nf];
+    si[oo] = outi[ff + oo*Nf];
+    rr[oo] = sr[oo] - hr[oo];
+    ri[oo] = si[oo] - hi[oo];
+  }
+
+  /* S*r, S*out and S*h */
+  for (oo=0; oo<Nout; oo++) {
+    Srr[oo] = 0.0; Sri[oo] = 0.0;
+    Sor[oo] = 0.0; Soi[oo] = 0.0;
+    Shr[oo] = 0.0; Shi[oo] = 0.0;
+    for (jj=0; jj<Nout; jj++) {
+      idx = ff + oo*Nf + jj*Nf*Nout;
+      ar  = Sr[idx];
+      ai  = Si[idx];
+      Srr[oo] += ar*rr[jj] - ai*ri[jj];
+      Sri[oo] += ar*ri[jj] + ai*rr[jj];
+      Sor[oo] += ar*sr[jj] - ai*si[jj];
+      Soi[oo] += ar*si[jj] + ai*sr[jj];
+      Shr[oo] += ar*hr[jj] - ai*hi[jj];
+      Shi[oo] += ar*hi[jj] + ai*hr[jj];
+    }
+  }
+
+  /* conj(x)'*y sums */
+  lf  = 0.0;
+  sr_ = 0.0; si_ = 0.0;
+  hr_ = 0.0; hi_ = 0.0;
+  for (oo=0; oo<Nout; oo++) {
+    lf  += rr[oo]*Srr[oo] + ri[oo]*Sri[oo];
+    sr_ += hr[oo]*Sor[oo] + hi[oo]*Soi[oo];
+    si_ += hr[oo]*Soi[oo] - hi[oo]*Sor[oo];
+    hr_ += hr[oo]*Shr[oo] + hi[oo]*Shi[oo];
+    hi_ += hr[oo]*Shi[oo] - hi[oo]*Shr[oo];
+  }
+
+  *Lf  = lf;
+  *hsr = sr_;
+  *hsi = si_;
+  *hhr = hr_;
+  *hhi = hi_;
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_loglikelihood version %s\n", version);
+  mexPrintf("  usage:    [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF);\n");
+  mexPrintf("            [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
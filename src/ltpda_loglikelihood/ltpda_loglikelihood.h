@@ -0,0 +1,17 @@
+/*
+ * Header for ltpda_loglikelihood.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+double *imag_part(const mxArray *a, double **buf);
+
+void loglikelihood_freq(long int ff, long int Nf, long int Nin, long int Nout,
+                        const double *inr, const double *ini,
+                        const double *outr, const double *outi,
+                        const double *Sr, const double *Si,
+                        const double *TFr, const double *TFi,
+                        double *wr, double *wi,
+                        double *Lf, double *hsr, double *hsi, double *hhr, double *hhi);
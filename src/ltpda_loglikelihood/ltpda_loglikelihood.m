@@ -0,0 +1,25 @@
+% LTPDA_LOGLIKELIHOOD A mex file to compute the frequency-domain log-likelihood of a multichannel model.
+%
+% function [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF);
+% function [L, snr, Lf] = ltpda_loglikelihood(in, out, S, TF, nthreads);
+%
+% Computes, frequency by frequency, the residual r = out - TF*in and
+%
+%   Lf  = real(r'*S*r)
+%   L   = sum(Lf)
+%   snr = sqrt(2)*real(sum(h'*S*out)^2/sum(h'*S*h)),  h = TF*in
+%
+% Inputs:
+%         in - The input spectra (Nfreqs x Ninputs)
+%        out - The output spectra (Nfreqs x Noutputs)
+%          S - The inverse noise cross-spectral matrix (Nfreqs x Noutputs x Noutputs)
+%         TF - The model transfer functions (Nfreqs x Noutputs x Ninputs)
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          L - The log-likelihood
+%        snr - The signal to noise ratio of the template
+%         Lf - The log-likelihood per frequency (Nfreqs x 1)
+%
+% This is the compiled version of utils.math.loglikelihood.
+%
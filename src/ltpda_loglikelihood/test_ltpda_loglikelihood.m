@@ -0,0 +1,39 @@
+clear all;
+compile
+
+Nfreqs   = 10000;
+Ninputs  = 2;
+Noutputs = 3;
+
+%% Validate against the MATLAB implementation
+
+cplx = @(varargin) complex(randn(varargin{:}), randn(varargin{:}));
+in   = cplx(Nfreqs, Ninputs);
+out  = cplx(Nfreqs, Noutputs);
+S    = cplx(Nfreqs, Noutputs, Noutputs);
+TF   = cplx(Nfreqs, Noutputs, Ninputs);
+
+tic
+[Lx, snrx, Lfx] = ltpda_loglikelihood(in, out, S, TF);
+tmex = toc
+
+tic
+h   = utils.math.mult(TF, in);
+Lf  = real(utils.math.ctmult(out - h, utils.math.mult(S, out - h)));
+L   = sum(Lf);
+hs  = utils.math.ctmult(h, utils.math.mult(S, out));
+hh  = utils.math.ctmult(h, utils.math.mult(S, h));
+snr = sqrt(2)*real(sum(hs).^2/sum(hh));
+tmat = toc
+
+abs(Lx - L)/abs(L)
+abs(snrx - snr)/abs(snr)
+max(abs(Lfx - Lf))/max(abs(Lf))
+tmat/tmex
+
+%% Real noise spectra and a single input
+
+[Lx, snrx] = ltpda_loglikelihood(in(:,1), out, real(S), TF(:,:,1));
+h   = utils.math.mult(TF(:,:,1), in(:,1));
+L   = sum(real(utils.math.ctmult(out - h, utils.math.mult(real(S), out - h))));
+abs(Lx - L)/abs(L)
@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_mchiir   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_mchiir\compile">src\ltpda_mchiir\compile</a>           -  package within MATLAB
+%   <a href="matlab:help src\ltpda_mchiir\ltpda_mchiir">src\ltpda_mchiir\ltpda_mchiir</a>      -  A mex file to filter many channels, each with its own IIR filter, in a single pass.
+%   <a href="matlab:help src\ltpda_mchiir\test_ltpda_mchiir">src\ltpda_mchiir\test_ltpda_mchiir</a> - %
@@ -0,0 +1,242 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_mchiir.h"
+
+#define DEBUG 0
+
+/* number of samples of a group of channels filtered in turn */
+#define BLOCK 1024
+
+/* number of channels interleaved in a group */
+#define GROUP 16
+
+/*
+ * A mex file to filter many channels, each with its own IIR filter, in a
+ * single pass.
+ *
+ * The filters are in direct form II transposed, as in MATLAB's filter.
+ * The channels are interleaved in groups of GROUP, together with their
+ * coefficients and their states, so that each step of the recursion is
+ * done for all the channels of the group in loops which run over the
+ * channels: the compiler vectorises them. The coefficients are padded with
+ * zeros to a common length, which only costs a few multiplications by
+ * zero for the shorter filters. The groups are shared between threads when
+ * the file is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [y, Zf] = ltpda_mchiir(x, num, den, Zi, nthreads);
+ *
+ * x   - N x Nch
+ * num - Nch x M, or 1 x M for a filter shared by all the channels
+ * den - Nch x M, or 1 x M
+ * Zi  - (M-1) x Nch
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y, *Zf;
+
+  /* inputs */
+  double *x, *num, *den, *Zi;
+
+  long int N, Nch, Nf, M, Ns, Ng, gg, ff, kk;
+  int      nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 4 || nrhs == 5) && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<4; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, coefficients and states must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      N   = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      N   = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    Nf = (long int)mxGetM(prhs[1]);
+    M  = (long int)mxGetN(prhs[1]);
+    Ns = M - 1;
+
+    if ( M < 1 || (Nf != 1 && Nf != Nch) )
+      mexErrMsgTxt("### the coefficients must have one row per channel, or a single row");
+    if ( (long int)mxGetM(prhs[2]) != Nf || (long int)mxGetN(prhs[2]) != M )
+      mexErrMsgTxt("### the numerator and denominator coefficients must have the same size");
+    if ( (long int)mxGetNumberOfElements(prhs[3]) != Ns*Nch )
+      mexErrMsgTxt("### the initial states must be a (M-1) x Nch array");
+
+    nthreads = 0;
+    if (nrhs == 5)
+      nthreads = (int)mxGetScalar(prhs[4]);
+
+    #if DEBUG
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Nfilt: %d\n", Nf);
+    mexPrintf("M: %d\n", M);
+    #endif
+
+    /*----------------- set inputs*/
+    x   = mxGetPr(prhs[0]);
+    num = mxGetPr(prhs[1]);
+    den = mxGetPr(prhs[2]);
+    Zi  = mxGetPr(prhs[3]);
+
+    for (ff=0; ff<Nf; ff++) {
+      if (den[ff] == 0.0)
+        mexErrMsgTxt("### the first denominator coefficient of each filter must be nonzero");
+    }
+
+    /* outputs, with the shape of the input */
+    plhs[0] = mxCreateDoubleMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(Ns, Nch, mxREAL);
+      Zf = mxGetPr(plhs[1]);
+    }
+    else {
+      Zf = (double*)calloc(Ns*Nch+1, sizeof(double));
+    }
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    Ng = (Nch + GROUP - 1)/GROUP;
+    #pragma omp parallel for schedule(dynamic)
+    for (gg=0; gg<Ng; gg++) {
+      long int c0 = gg*GROUP;
+      long int G  = (Nch - c0 < GROUP) ? Nch - c0 : GROUP;
+      long int b0, nb, nn, cc, ii, rr;
+      double  *buf, *nc, *dc, *z, *w;
+
+      buf = (double*)calloc(BLOCK*G, sizeof(double));
+      nc  = (double*)calloc(M*G, sizeof(double));
+      dc  = (double*)calloc(M*G, sizeof(double));
+      z   = (double*)calloc(Ns*G+1, sizeof(double));
+      w   = (double*)calloc(G, sizeof(double));
+
+      /* normalised coefficients and states, with the channels innermost */
+      for (cc=0; cc<G; cc++) {
+        rr = (Nf == 1) ? 0 : c0 + cc;
+        for (ii=0; ii<M; ii++) {
+          nc[ii*G + cc] = num[rr + ii*Nf]/den[rr];
+          dc[ii*G + cc] = den[rr + ii*Nf]/den[rr];
+        }
+        for (ii=0; ii<Ns; ii++)
+          z[ii*G + cc] = Zi[ii + (c0 + cc)*Ns];
+      }
+
+      for (b0=0; b0<N; b0+=BLOCK) {
+        nb = (N - b0 < BLOCK) ? N - b0 : BLOCK;
+        for (cc=0; cc<G; cc++)
+          for (nn=0; nn<nb; nn++)
+            buf[nn*G + cc] = x[(c0 + cc)*N + b0 + nn];
+        mch_block(buf, nb, G, nc, dc, M, z, w);
+        for (cc=0; cc<G; cc++)
+          for (nn=0; nn<nb; nn++)
+            y[(c0 + cc)*N + b0 + nn] = buf[nn*G + cc];
+      }
+
+      /* final states */
+      for (cc=0; cc<G; cc++)
+        for (ii=0; ii<Ns; ii++)
+          Zf[ii + (c0 + cc)*Ns] = z[ii*G + cc];
+
+      free(buf);
+      free(nc);
+      free(dc);
+      free(z);
+      free(w);
+    }
+
+    if (nlhs <= 1)
+      free(Zf);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Filter in place nb interleaved samples of G channels, each with its
+ * normalised coefficients num[k*G + c] and den[k*G + c]. The states
+ * z[k*G + c] are updated, w is a workspace of G values.
+ */
+void mch_block(double *buf, long int nb, long int G,
+               const double *num, const double *den, long int M,
+               double *z, double *w)
+{
+  long int nn, kk, cc;
+  double  *v, *zk;
+  const double *zn, *nk, *dk;
+
+  for (nn=0; nn<nb; nn++) {
+    v = buf + nn*G;
+
+    if (M == 1) {
+      for (cc=0; cc<G; cc++)
+        v[cc] *= num[cc];
+      continue;
+    }
+
+    /* outputs of all the channels */
+    for (cc=0; cc<G; cc++) {
+      w[cc] = v[cc];
+      v[cc] = num[cc]*w[cc] + z[cc];
+    }
+
+    /* then their states */
+    for (kk=1; kk<M-1; kk++) {
+      zk = z + (kk-1)*G;
+      zn = z + kk*G;
+      nk = num + kk*G;
+      dk = den + kk*G;
+      for (cc=0; cc<G; cc++)
+        zk[cc] = zn[cc] + nk[cc]*w[cc] - dk[cc]*v[cc];
+    }
+    zk = z + (M-2)*G;
+    nk = num + (M-1)*G;
+    dk = den + (M-1)*G;
+    for (cc=0; cc<G; cc++)
+      zk[cc] = nk[cc]*w[cc] - dk[cc]*v[cc];
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_mchiir version %s\n", version);
+  mexPrintf("  usage:    [y, Zf] = ltpda_mchiir(x, num, den, Zi);\n");
+  mexPrintf("            [y, Zf] = ltpda_mchiir(x, num, den, Zi, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,11 @@
+/*
+ * Header for ltpda_mchiir.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void mch_block(double *buf, long int nb, long int G,
+               const double *num, const double *den, long int M,
+               double *z, double *w);
@@ -0,0 +1,24 @@
+% LTPDA_MCHIIR A mex file to filter many channels, each with its own IIR filter, in a single pass.
+%
+% function [y, Zf] = ltpda_mchiir(x, num, den, Zi);
+% function [y, Zf] = ltpda_mchiir(x, num, den, Zi, nthreads);
+%
+% Filters each channel as FILTER does, in direct form II transposed. The
+% channels are interleaved in groups, with their coefficients and states,
+% so that each step of the recursion is done for all the channels of a
+% group at once. The groups are shared between threads.
+%
+% Inputs:
+%          x - The data (Nsamples x Nchannels, or a vector)
+%        num - The numerator coefficients (Nchannels x M), padded with
+%              zeros, or a single row shared by all the channels
+%        den - The denominator coefficients, with the size of num
+%         Zi - The initial states ((M-1) x Nchannels)
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The filtered data, with the size of x
+%         Zf - The final states ((M-1) x Nchannels)
+%
+% This is the compiled version of utils.math.mchiir.
+%
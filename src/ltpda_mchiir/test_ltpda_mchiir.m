@@ -0,0 +1,49 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nch      = 24;
+
+%% Validate against filter, with a filter per channel
+
+num = zeros(Nch, 1);
+den = zeros(Nch, 1);
+for cc = 1:Nch
+  f = miir(plist('type', 'lowpass', 'order', 1 + mod(cc, 4), 'fc', 0.01*cc, 'fs', 10));
+  num(cc, 1:numel(f.a)) = f.a;
+  den(cc, 1:numel(f.b)) = f.b;
+end
+M = size(num, 2);
+
+x  = randn(Nsamples, Nch);
+Zi = randn(M-1, Nch);
+
+tic
+[yx, Zfx] = ltpda_mchiir(x, num, den, Zi);
+tmex = toc
+
+tic
+y  = zeros(size(x));
+Zf = zeros(size(Zi));
+for cc = 1:Nch
+  [y(:,cc), Zf(:,cc)] = filter(num(cc,:), den(cc,:), x(:,cc), Zi(:,cc));
+end
+tmat = toc
+
+max(abs(yx(:) - y(:)))/max(abs(y(:)))
+max(abs(Zfx(:) - Zf(:)))
+tmat/tmex
+
+%% A filter shared by all the channels
+
+tic
+[yx, Zfx] = ltpda_mchiir(x, num(1,:), den(1,:), Zi);
+tmex = toc
+
+tic
+[y, Zf] = filter(num(1,:), den(1,:), x, Zi);
+tmat = toc
+
+max(abs(yx(:) - y(:)))/max(abs(y(:)))
+max(abs(Zfx(:) - Zf(:)))
+tmat/tmex
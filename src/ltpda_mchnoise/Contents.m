@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_mchnoise   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_mchnoise\compile">src\ltpda_mchnoise\compile</a>             -  package within MATLAB
+%   <a href="matlab:help src\ltpda_mchnoise\ltpda_mchnoise">src\ltpda_mchnoise\ltpda_mchnoise</a>      -  A mex file to generate correlated multichannel noise.
+%   <a href="matlab:help src\ltpda_mchnoise\test_ltpda_mchnoise">src\ltpda_mchnoise\test_ltpda_mchnoise</a> - %
@@ -0,0 +1,337 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "../c_sources/philox.c"
+#include "ltpda_mchnoise.h"
+
+#define DEBUG 0
+
+/* number of samples generated in turn */
+#define BLOCK 4096
+
+/*
+ * A mex file to generate correlated multichannel noise.
+ *
+ * The noise is the output of a bank of one-pole recursions
+ *
+ *   y(i,n) = a(i)*y(i,n-1) + g(i)*w(src(i),n)
+ *   o(k,n) = real( sum of y(i,n) over the poles i of the channel k )
+ *
+ * with complex poles a and gains g (see matrix/mchNoisegen), driven by
+ * independent white noise sources w. The source s is drawn from its own
+ * stream of the counter-based generator of c_sources/philox.c, so that
+ * w(s,n) only depends on the seed, s and n.
+ *
+ * The samples are generated in blocks. In each block the sources are
+ * drawn in parallel, then the channels are computed in parallel, each by
+ * a single thread which sums its poles in a fixed order: the output is the
+ * same for any number of threads. The output goes to memory, or to a
+ * binary file block by block, so that series larger than the memory can
+ * be generated.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename, n0, nthreads);
+ *
+ * a        - Npoles x 1 (complex) poles of the recursions
+ * g        - Npoles x 1 (complex) gains of the noise
+ * y0       - Npoles x 1 (complex) initial states
+ * chan     - Npoles x 1 output channel of each pole (1-based)
+ * src      - Npoles x 1 noise source of each pole (1-based)
+ * Nsamples - number of samples
+ * seed     - seed of the noise
+ * filename - (optional) binary file for the output, '' for memory
+ * n0       - (optional) index of the first sample, 0 by default
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *o, *yfr, *yfi;
+
+  /* inputs */
+  double *ar, *ai, *gr, *gi, *y0r, *y0i, *chan, *src;
+
+  /* poles sorted by channel */
+  double   *par, *pai, *pgr, *pgi, *pyr, *pyi;
+  long int *psrc, *perm, *off;
+
+  /* blocks of the noise and of the output */
+  double *W, *O, *buf;
+
+  long int       Np, Nch, Nsrc, Ns, b0, nb, nn, ii, kk;
+  philox_uint64  seed, n0;
+  int            nthreads;
+  char          *filename;
+  FILE          *fid;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs >= 7 && nrhs <= 10) && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<5; kk++) {
+      if ( !mxIsDouble(prhs[kk]) )
+        mexErrMsgTxt("### the poles, gains, states and indices must be double arrays");
+    }
+
+    Np = (long int)mxGetNumberOfElements(prhs[0]);
+    for (kk=1; kk<5; kk++) {
+      if ( (long int)mxGetNumberOfElements(prhs[kk]) != Np )
+        mexErrMsgTxt("### there must be a gain, a state, a channel and a source per pole");
+    }
+    if ( mxIsComplex(prhs[3]) || mxIsComplex(prhs[4]) )
+      mexErrMsgTxt("### the channels and sources must be real");
+
+    Ns   = (long int)mxGetScalar(prhs[5]);
+    seed = (philox_uint64)mxGetScalar(prhs[6]);
+    if (Ns < 0)
+      Ns = 0;
+
+    filename = NULL;
+    if (nrhs >= 8 && mxIsChar(prhs[7]) && mxGetNumberOfElements(prhs[7]) > 0) {
+      kk = (long int)mxGetNumberOfElements(prhs[7]) + 1;
+      filename = (char*)mxCalloc(kk, sizeof(char));
+      mxGetString(prhs[7], filename, kk);
+    }
+    n0 = 0;
+    if (nrhs >= 9)
+      n0 = (philox_uint64)mxGetScalar(prhs[8]);
+    nthreads = 0;
+    if (nrhs == 10)
+      nthreads = (int)mxGetScalar(prhs[9]);
+
+    /*----------------- set inputs*/
+    ar   = mxGetPr(prhs[0]);
+    ai   = mxGetPi(prhs[0]);
+    gr   = mxGetPr(prhs[1]);
+    gi   = mxGetPi(prhs[1]);
+    y0r  = mxGetPr(prhs[2]);
+    y0i  = mxGetPi(prhs[2]);
+    chan = mxGetPr(prhs[3]);
+    src  = mxGetPr(prhs[4]);
+
+    Nch  = 0;
+    Nsrc = 0;
+    for (ii=0; ii<Np; ii++) {
+      if (chan[ii] < 1 || src[ii] < 1)
+        mexErrMsgTxt("### the channels and sources must be positive indices");
+      if ((long int)chan[ii] > Nch)
+        Nch = (long int)chan[ii];
+      if ((long int)src[ii] > Nsrc)
+        Nsrc = (long int)src[ii];
+    }
+
+    #if DEBUG
+    mexPrintf("Npoles: %d\n", Np);
+    mexPrintf("Nchannels: %d\n", Nch);
+    mexPrintf("Nsources: %d\n", Nsrc);
+    mexPrintf("Nsamples: %d\n", Ns);
+    #endif
+
+    /* the poles of each channel, in their order */
+    off  = (long int*)calloc(Nch+1, sizeof(long int));
+    perm = (long int*)calloc(Np+1, sizeof(long int));
+    for (ii=0; ii<Np; ii++)
+      off[(long int)chan[ii]]++;
+    for (kk=0; kk<Nch; kk++)
+      off[kk+1] += off[kk];
+    for (ii=0; ii<Np; ii++)
+      perm[off[(long int)chan[ii]-1]++] = ii;
+    for (kk=Nch; kk>0; kk--)
+      off[kk] = off[kk-1];
+    off[0] = 0;
+
+    par  = (double*)calloc(Np+1, sizeof(double));
+    pai  = (double*)calloc(Np+1, sizeof(double));
+    pgr  = (double*)calloc(Np+1, sizeof(double));
+    pgi  = (double*)calloc(Np+1, sizeof(double));
+    pyr  = (double*)calloc(Np+1, sizeof(double));
+    pyi  = (double*)calloc(Np+1, sizeof(double));
+    psrc = (long int*)calloc(Np+1, sizeof(long int));
+    for (kk=0; kk<Np; kk++) {
+      ii = perm[kk];
+      par[kk]  = ar[ii];
+      pai[kk]  = (ai  != NULL) ? ai[ii]  : 0.0;
+      pgr[kk]  = gr[ii];
+      pgi[kk]  = (gi  != NULL) ? gi[ii]  : 0.0;
+      pyr[kk]  = y0r[ii];
+      pyi[kk]  = (y0i != NULL) ? y0i[ii] : 0.0;
+      psrc[kk] = (long int)src[ii] - 1;
+    }
+
+    /* output in memory, or a file */
+    fid = NULL;
+    buf = NULL;
+    if (filename != NULL) {
+      fid = fopen(filename, "wb");
+      if (fid == NULL) {
+        free(off); free(perm); free(psrc);
+        free(par); free(pai); free(pgr); free(pgi); free(pyr); free(pyi);
+        mexErrMsgTxt("### unable to open the output file");
+      }
+      plhs[0] = mxCreateDoubleMatrix(0, 0, mxREAL);
+      o   = NULL;
+      buf = (double*)calloc(Nch*BLOCK+1, sizeof(double));
+    }
+    else {
+      plhs[0] = mxCreateDoubleMatrix(Nch, Ns, mxREAL);
+      o = mxGetPr(plhs[0]);
+    }
+
+    W = (double*)calloc(Nsrc*BLOCK+1, sizeof(double));
+    O = (double*)calloc(Nch*BLOCK+1, sizeof(double));
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    for (b0=0; b0<Ns; b0+=BLOCK) {
+      nb = (Ns - b0 < BLOCK) ? Ns - b0 : BLOCK;
+
+      #pragma omp parallel
+      {
+        long int ss, cc;
+
+        #pragma omp for schedule(static)
+        for (ss=0; ss<Nsrc; ss++)
+          white_noise(seed, (philox_uint32)ss, n0 + (philox_uint64)b0, nb, W + ss*BLOCK);
+
+        #pragma omp for schedule(dynamic)
+        for (cc=0; cc<Nch; cc++)
+          channel_block(par + off[cc], pai + off[cc], pgr + off[cc], pgi + off[cc],
+                        pyr + off[cc], pyi + off[cc], psrc + off[cc],
+                        off[cc+1] - off[cc], W, nb, O + cc*BLOCK);
+      }
+
+      /* the samples of all the channels, one after the other */
+      if (fid != NULL) {
+        for (nn=0; nn<nb; nn++)
+          for (kk=0; kk<Nch; kk++)
+            buf[nn*Nch + kk] = O[kk*BLOCK + nn];
+        if ((long int)fwrite(buf, sizeof(double), nb*Nch, fid) != nb*Nch) {
+          fclose(fid);
+          mexErrMsgTxt("### unable to write the output file");
+        }
+      }
+      else {
+        for (nn=0; nn<nb; nn++)
+          for (kk=0; kk<Nch; kk++)
+            o[(b0 + nn)*Nch + kk] = O[kk*BLOCK + nn];
+      }
+    }
+
+    if (fid != NULL) {
+      fclose(fid);
+      free(buf);
+      mxFree(filename);
+    }
+
+    /* final states, in the order of the inputs */
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(Np, 1, mxCOMPLEX);
+      yfr = mxGetPr(plhs[1]);
+      yfi = mxGetPi(plhs[1]);
+      for (kk=0; kk<Np; kk++) {
+        yfr[perm[kk]] = pyr[kk];
+        yfi[perm[kk]] = pyi[kk];
+      }
+    }
+
+    free(W);
+    free(O);
+    free(off);
+    free(perm);
+    free(psrc);
+    free(par);
+    free(pai);
+    free(pgr);
+    free(pgi);
+    free(pyr);
+    free(pyi);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * nb samples of the white noise of a source, from the sample n0. The
+ * deviates come in pairs from the generator: the sample n is the element
+ * n%2 of the pair n/2, whatever the blocks are.
+ */
+void white_noise(philox_uint64 seed, philox_uint32 stream, philox_uint64 n0,
+                 long int nb, double *w)
+{
+  double   pair[2];
+  long int ii;
+
+  ii = 0;
+  if (nb > 0 && (n0 & 1)) {
+    philox_randn(seed, n0 >> 1, stream, pair, 2);
+    w[0] = pair[1];
+    ii = 1;
+  }
+  for (; ii+1<nb; ii+=2)
+    philox_randn(seed, (n0 + ii) >> 1, stream, w + ii, 2);
+  if (ii < nb) {
+    philox_randn(seed, (n0 + ii) >> 1, stream, pair, 2);
+    w[ii] = pair[0];
+  }
+}
+
+/*
+ * nb samples of a channel made of Np poles. The poles a, the gains g and
+ * the states y are complex, split in real and imaginary parts; src is the
+ * noise source of each pole in W. The states are updated.
+ */
+void channel_block(const double *ar, const double *ai,
+                   const double *gr, const double *gi,
+                   double *yr, double *yi, const long int *src,
+                   long int Np, const double *W, long int nb, double *out)
+{
+  long int nn, ii;
+  double   w, tr, s;
+
+  for (nn=0; nn<nb; nn++) {
+    s = 0.0;
+    for (ii=0; ii<Np; ii++) {
+      w      = W[src[ii]*BLOCK + nn];
+      tr     = ar[ii]*yr[ii] - ai[ii]*yi[ii] + gr[ii]*w;
+      yi[ii] = ar[ii]*yi[ii] + ai[ii]*yr[ii] + gi[ii]*w;
+      yr[ii] = tr;
+      s     += tr;
+    }
+    out[nn] = s;
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_mchnoise version %s\n", version);
+  mexPrintf("  usage:    [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed);\n");
+  mexPrintf("            [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename);\n");
+  mexPrintf("            [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename, n0);\n");
+  mexPrintf("            [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename, n0, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,15 @@
+/*
+ * Header for ltpda_mchnoise.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void white_noise(philox_uint64 seed, philox_uint32 stream, philox_uint64 n0,
+                 long int nb, double *w);
+
+void channel_block(const double *ar, const double *ai,
+                   const double *gr, const double *gi,
+                   double *yr, double *yi, const long int *src,
+                   long int Np, const double *W, long int nb, double *out);
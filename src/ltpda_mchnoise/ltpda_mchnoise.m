@@ -0,0 +1,35 @@
+% LTPDA_MCHNOISE A mex file to generate correlated multichannel noise.
+%
+% function [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed);
+% function [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename);
+% function [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename, n0);
+% function [o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, filename, n0, nthreads);
+%
+% Runs the one-pole recursions y = a.*y + g.*w(src) and sums the real part
+% of the states of the poles of each channel. The white noise sources w
+% are drawn from a counter-based generator: the noise of a sample of a
+% source only depends on the seed, the index of the sample and the index
+% of the source. The sources and then the channels are shared between
+% threads, with the same output for any number of threads.
+%
+% Inputs:
+%          a - The poles (Npoles x 1, complex)
+%          g - The gains of the noise (Npoles x 1, complex)
+%         y0 - The initial states (Npoles x 1, complex)
+%       chan - The output channel of each pole (Npoles x 1)
+%        src - The noise source of each pole (Npoles x 1)
+%   Nsamples - The number of samples
+%       seed - The seed of the noise
+%   filename - (optional) A binary file for the output, or '' for the
+%              memory. The samples of the channels are written one after
+%              the other: read them with fread(fid, [Nchannels Inf], 'double').
+%         n0 - (optional) The index of the first sample, to continue a
+%              series in several calls [default: 0]
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          o - The noise (Nchannels x Nsamples), empty with a file
+%         yf - The final states (Npoles x 1, complex)
+%
+% This is the compiled engine of matrix/mchNoisegen.
+%
@@ -0,0 +1,54 @@
+@echo off
+rem msvc90freeopts.BAT
+rem
+rem    Compile and link options used for building MEX-files
+rem    using the Microsoft Visual C++ 2008 Express Edition compiler.
+rem
+rem    $Revision$  $Date$
+rem
+rem ********************************************************************
+rem General parameters
+rem ********************************************************************
+set MATLAB=%MATLAB%
+set VS90COMNTOOLS=%VS90COMNTOOLS%
+set VSINSTALLDIR=%VS90COMNTOOLS%\..\..
+set VCINSTALLDIR=%VSINSTALLDIR%\VC
+set MSSdk=C:\Program Files\Microsoft SDKs\Windows\v6.1\
+set LINKERDIR=%MSSdk%
+set MW_TARGET_ARCH=win64
+set PATH=%VCINSTALLDIR%\BIN\amd64;%LINKERDIR%\bin\x64;%LINKERDIR%\bin\win64\x64;%LINKERDIR%\bin;%VSINSTALLDIR%\Common7\IDE;%VSINSTALLDIR%\SDK\v3.5\bin\amd64;%VSINSTALLDIR%\Common7\Tools;%VSINSTALLDIR%\Common7\Tools\bin;%VCINSTALLDIR%\VCPackages;%MATLAB_BIN%;%PATH%
+set INCLUDE=%VCINSTALLDIR%\ATLMFC\INCLUDE;%VCINSTALLDIR%\INCLUDE;%LINKERDIR%\INCLUDE;%VSINSTALLDIR%\SDK\v3.5\include;%INCLUDE%
+set LIB=%VCINSTALLDIR%\ATLMFC\LIB\amd64;%VCINSTALLDIR%\LIB\amd64;%LINKERDIR%\Lib\x64;%VSINSTALLDIR%\SDK\v3.5\lib\amd64;%MATLAB%\extern\lib\%MW_TARGET_ARCH%;%LIB%
+
+rem ********************************************************************
+rem Compiler parameters
+rem ********************************************************************
+set COMPILER=cl
+set COMPFLAGS=/c /Zp8 /GR /W3 /EHsc- /Zc:wchar_t- /DMATLAB_MEX_FILE
+set OPTIMFLAGS=/MD /O2 /Oy- /DNDEBUG
+set DEBUGFLAGS=/MD /Zi /Fd"%OUTDIR%%MEX_NAME%%MEX_EXT%.pdb"
+set NAME_OBJECT=/Fo
+
+rem ********************************************************************
+rem Linker parameters
+rem ********************************************************************
+set LIBLOC=%MATLAB%\extern\lib\%MW_TARGET_ARCH%\microsoft
+set LINKER=link
+set LINKFLAGS=/dll /export:%ENTRYPOINT% /MAP /LIBPATH:"%LIBLOC%" libmx.lib libmex.lib libmat.lib /implib:%LIB_NAME%.x /MACHINE:X64 kernel32.lib user32.lib gdi32.lib winspool.lib comdlg32.lib advapi32.lib shell32.lib ole32.lib oleaut32.lib uuid.lib odbc32.lib odbccp32.lib
+set LINKOPTIMFLAGS=
+set LINKDEBUGFLAGS=/DEBUG /PDB:"%OUTDIR%%MEX_NAME%%MEX_EXT%.pdb"
+set LINK_FILE=
+set LINK_LIB=
+set NAME_OUTPUT=/out:"%OUTDIR%%MEX_NAME%%MEX_EXT%"
+set RSP_FILE_INDICATOR=@
+
+rem ********************************************************************
+rem Resource compiler parameters
+rem ********************************************************************
+set RC_COMPILER=rc /fo "%OUTDIR%mexversion.res"
+set RC_LINKER=
+
+set POSTLINK_CMDS=del "%OUTDIR%%MEX_NAME%.map"
+set POSTLINK_CMDS1=del %LIB_NAME%.x
+set POSTLINK_CMDS2=mt -outputresource:"%OUTDIR%%MEX_NAME%%MEX_EXT%";2 -manifest "%OUTDIR%%MEX_NAME%%MEX_EXT%.manifest"
+set POSTLINK_CMDS3=del "%OUTDIR%%MEX_NAME%%MEX_EXT%.manifest"
@@ -0,0 +1,56 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nch      = 4;
+Npoles   = 8;
+seed     = 1234;
+
+%% Poles and gains of the channels, with a source per channel
+
+a    = 0.99*exp(2i*pi*rand(Npoles*Nch, 1)/4);
+g    = randn(Npoles*Nch, 1) + 1i*randn(Npoles*Nch, 1);
+y0   = zeros(Npoles*Nch, 1);
+chan = repmat((1:Nch)', Npoles, 1);
+src  = kron((1:Nch)', ones(Npoles, 1));
+
+%% Validate against the recursion, with the same noise
+
+tic
+[o, yf] = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed);
+tmex = toc
+
+% the white noise of each source is the output of a unit recursion
+w = ltpda_mchnoise(zeros(Nch, 1), ones(Nch, 1), zeros(Nch, 1), (1:Nch)', (1:Nch)', 1000, seed);
+os = zeros(Nch, 1000);
+for kk = 1:numel(a)
+  y = filter(g(kk), [1 -a(kk)], w(src(kk), :));
+  os(chan(kk), :) = os(chan(kk), :) + real(y);
+end
+max(max(abs(os - o(:, 1:1000))))/max(max(abs(os)))
+
+%% The same noise as the MATLAB version, in pairs of samples
+
+wm = zeros(Nch, 1000);
+for kk = 1:Nch
+  r = utils.math.philoxrandn(seed, 0:499, kk-1, 2);
+  wm(kk, :) = r(:).';
+end
+max(max(abs(wm - w)))
+
+%% The same output with one thread
+
+o1 = ltpda_mchnoise(a, g, y0, chan, src, Nsamples, seed, '', 0, 1);
+isequal(o1, o)
+
+%% Continuity between two calls, to a file
+
+fn = [tempname '.bin'];
+[e1, y1] = ltpda_mchnoise(a, g, y0, chan, src, 1000, seed, fn);
+fid = fopen(fn, 'r');
+x1 = fread(fid, [Nch Inf], 'double');
+fclose(fid);
+[x2, y2] = ltpda_mchnoise(a, g, y1, chan, src, Nsamples-1000, seed, '', 1000);
+max(max(abs([x1 x2] - o)))
+max(abs(y2 - yf))
+delete(fn);
@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_ngprop   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_ngprop\compile">src\ltpda_ngprop\compile</a>           -  package within MATLAB
+%   <a href="matlab:help src\ltpda_ngprop\ltpda_ngprop">src\ltpda_ngprop\ltpda_ngprop</a>      -  A mex file to propagate the state of the Franklin noise generator.
+%   <a href="matlab:help src\ltpda_ngprop\test_ltpda_ngprop">src\ltpda_ngprop\test_ltpda_ngprop</a> - %
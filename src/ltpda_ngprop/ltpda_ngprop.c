@@ -0,0 +1,246 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_ngprop.h"
+#include "../c_sources/philox.c"
+
+#define DEBUG 0
+
+/* number of samples of a group of streams drawn and propagated in turn */
+#define BLOCK 256
+
+/* number of streams interleaved in a group */
+#define GROUP 8
+
+/*
+ * A mex file to propagate the state of the noise generator of Franklin.
+ *
+ * Each stream of noise is the recursion
+ *
+ *   y(n) = E*y(n-1) + Tprop*r(n)
+ *   x(n) = num*y(n)
+ *
+ * driven by the white noise r(n), which is drawn from a counter-based
+ * generator (see c_sources/philox.c): the noise of the sample n of the
+ * stream s only depends on the seed, n and s. A series can then be
+ * generated in several calls, from the sample index n0 of each call and
+ * the final states of the previous one, with the numbers of a single call.
+ *
+ * The noise is drawn in blocks of BLOCK samples. The streams are
+ * interleaved in groups of GROUP, with their states, so that the products
+ * of each step are done for all the streams of a group in loops which run
+ * over the streams: the compiler vectorises them. The groups are shared
+ * between threads when the file is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0, nthreads);
+ *
+ * Tprop - n x n
+ * E     - n x n
+ * num   - 1 x n
+ * y     - n x Nst, the initial states of the streams
+ * ns    - number of samples
+ * seed  - seed of the noise
+ * n0    - (optional) index of the first sample, 0 by default
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *x, *yf;
+
+  /* inputs */
+  double *T, *E, *num, *y;
+
+  long int       n, Nst, ns, Ng, gg, kk;
+  philox_uint64  seed, n0;
+  int            nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs >= 6 && nrhs <= 8) && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<4; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the matrices, coefficients and states must be real double arrays");
+    }
+
+    n   = (long int)mxGetM(prhs[0]);
+    Nst = (long int)mxGetN(prhs[3]);
+    if ( n < 1 || (long int)mxGetN(prhs[0]) != n ||
+         (long int)mxGetM(prhs[1]) != n || (long int)mxGetN(prhs[1]) != n )
+      mexErrMsgTxt("### Tprop and E must be square matrices of the same size");
+    if ( (long int)mxGetNumberOfElements(prhs[2]) != n )
+      mexErrMsgTxt("### there must be one numerator coefficient per state");
+    if ( (long int)mxGetM(prhs[3]) != n )
+      mexErrMsgTxt("### the initial states must be a n x Nstreams array");
+
+    ns   = (long int)mxGetScalar(prhs[4]);
+    seed = (philox_uint64)mxGetScalar(prhs[5]);
+    n0   = 0;
+    if (nrhs >= 7)
+      n0 = (philox_uint64)mxGetScalar(prhs[6]);
+    nthreads = 0;
+    if (nrhs == 8)
+      nthreads = (int)mxGetScalar(prhs[7]);
+    if (ns < 0)
+      ns = 0;
+
+    #if DEBUG
+    mexPrintf("n: %d\n", n);
+    mexPrintf("Nstreams: %d\n", Nst);
+    mexPrintf("ns: %d\n", ns);
+    #endif
+
+    /*----------------- set inputs*/
+    T   = mxGetPr(prhs[0]);
+    E   = mxGetPr(prhs[1]);
+    num = mxGetPr(prhs[2]);
+    y   = mxGetPr(prhs[3]);
+
+    /* outputs */
+    plhs[0] = mxCreateDoubleMatrix(ns, Nst, mxREAL);
+    x = mxGetPr(plhs[0]);
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(n, Nst, mxREAL);
+      yf = mxGetPr(plhs[1]);
+    }
+    else {
+      yf = (double*)calloc(n*Nst+1, sizeof(double));
+    }
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    Ng = (Nst + GROUP - 1)/GROUP;
+    #pragma omp parallel for schedule(dynamic)
+    for (gg=0; gg<Ng; gg++) {
+      long int s0 = gg*GROUP;
+      long int G  = (Nst - s0 < GROUP) ? Nst - s0 : GROUP;
+      long int b0, nb, nn, ss, ii;
+      double  *R, *z, *zn, *r, *w, *t;
+
+      R  = (double*)calloc(BLOCK*n*G, sizeof(double));
+      z  = (double*)calloc(n*G, sizeof(double));
+      zn = (double*)calloc(n*G, sizeof(double));
+      r  = (double*)calloc(n, sizeof(double));
+      w  = (double*)calloc(G, sizeof(double));
+
+      /* states with the streams innermost */
+      for (ss=0; ss<G; ss++)
+        for (ii=0; ii<n; ii++)
+          z[ii*G + ss] = y[ii + (s0 + ss)*n];
+
+      for (b0=0; b0<ns; b0+=BLOCK) {
+        nb = (ns - b0 < BLOCK) ? ns - b0 : BLOCK;
+
+        /* the noise of the block */
+        for (ss=0; ss<G; ss++) {
+          for (nn=0; nn<nb; nn++) {
+            philox_randn(seed, n0 + (philox_uint64)(b0 + nn), (philox_uint32)(s0 + ss), r, (int)n);
+            for (ii=0; ii<n; ii++)
+              R[(nn*n + ii)*G + ss] = r[ii];
+          }
+        }
+
+        /* propagate */
+        for (nn=0; nn<nb; nn++) {
+          ng_step(E, T, num, n, G, z, zn, R + nn*n*G, w);
+          t  = z;
+          z  = zn;
+          zn = t;
+          for (ss=0; ss<G; ss++)
+            x[(s0 + ss)*ns + b0 + nn] = w[ss];
+        }
+      }
+
+      /* final states */
+      for (ss=0; ss<G; ss++)
+        for (ii=0; ii<n; ii++)
+          yf[ii + (s0 + ss)*n] = z[ii*G + ss];
+
+      free(R);
+      free(z);
+      free(zn);
+      free(r);
+      free(w);
+    }
+
+    if (nlhs <= 1)
+      free(yf);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * One step of G interleaved streams: zn = E*z + T*r and w = num*zn. The
+ * matrices are n x n, column-major; z, zn and r hold the n values of each
+ * stream with the streams innermost.
+ */
+void ng_step(const double *E, const double *T, const double *num,
+             long int n, long int G, const double *z, double *zn,
+             const double *r, double *w)
+{
+  long int ii, jj, ss;
+  double   e, t, c;
+  double  *acc;
+  const double *zj, *rj;
+
+  for (ii=0; ii<n; ii++) {
+    acc = zn + ii*G;
+    for (ss=0; ss<G; ss++)
+      acc[ss] = 0.0;
+    for (jj=0; jj<n; jj++) {
+      e  = E[ii + jj*n];
+      t  = T[ii + jj*n];
+      zj = z + jj*G;
+      rj = r + jj*G;
+      for (ss=0; ss<G; ss++)
+        acc[ss] += e*zj[ss] + t*rj[ss];
+    }
+  }
+
+  for (ss=0; ss<G; ss++)
+    w[ss] = 0.0;
+  for (ii=0; ii<n; ii++) {
+    c   = num[ii];
+    acc = zn + ii*G;
+    for (ss=0; ss<G; ss++)
+      w[ss] += c*acc[ss];
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_ngprop version %s\n", version);
+  mexPrintf("  usage:    [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed);\n");
+  mexPrintf("            [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0);\n");
+  mexPrintf("            [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
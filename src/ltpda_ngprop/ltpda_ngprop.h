@@ -0,0 +1,11 @@
+/*
+ * Header for ltpda_ngprop.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void ng_step(const double *E, const double *T, const double *num,
+             long int n, long int G, const double *z, double *zn,
+             const double *r, double *w);
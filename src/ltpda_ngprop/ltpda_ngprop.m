@@ -0,0 +1,29 @@
+% LTPDA_NGPROP A mex file to propagate the state of the Franklin noise generator.
+%
+% function [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed);
+% function [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0);
+% function [x, yf] = ltpda_ngprop(Tprop, E, num, y, ns, seed, n0, nthreads);
+%
+% Propagates each stream with y = E*y + Tprop*r and x = num*y, where r is
+% white noise drawn from a counter-based generator: the noise of a sample
+% of a stream only depends on the seed, the index of the sample and the
+% index of the stream. The streams are propagated together, in groups
+% which are shared between threads.
+%
+% Inputs:
+%      Tprop - The matrix of the noise (n x n), see ao/ngsetup
+%          E - The propagation matrix (n x n)
+%        num - The numerator coefficients (1 x n)
+%          y - The initial states (n x Nstreams)
+%         ns - The number of samples
+%       seed - The seed of the noise
+%         n0 - (optional) The index of the first sample, to continue a
+%              series in several calls [default: 0]
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          x - The noise (ns x Nstreams)
+%         yf - The final states (n x Nstreams)
+%
+% This is the compiled version of ao/ngprop.
+%
@@ -0,0 +1,55 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nst      = 16;
+fs       = 10;
+seed     = 1234;
+
+%% The matrices of a pole/zero model
+
+pzm = pzmodel(1, {[0.1 2], 0.5}, {[0.02 3], 1});
+[num, den] = ao.ngconv(pzm);
+[Tinit, Tprop, E] = ao.ngsetup(den, fs);
+n   = length(Tprop);
+num = num';
+num = [num zeros(1, n-length(num))];
+y   = Tinit*randn(n, Nst);
+
+%% Validate against the recursion, with the same noise
+
+tic
+[x, yf] = ltpda_ngprop(Tprop, E, num, y, Nsamples, seed);
+tmex = toc
+
+% the white noise of each sample is the state of a unit recursion
+xs= zeros(1000, 1);
+ys = y(:, 1);
+for kk = 1:1000
+  [r, rf] = ltpda_ngprop(eye(n), zeros(n), eye(1, n), zeros(n, 1), 1, seed, kk-1);
+  ys = E*ys + Tprop*rf;
+  xs(kk) = num*ys;
+end
+max(abs(xs - x(1:1000, 1)))/max(abs(xs))
+
+%% The same noise as the MATLAB version
+
+R  = utils.math.philoxrandn(seed, 0:999, 0, n);
+xm = zeros(1000, 1);
+ys = y(:, 1);
+for kk = 1:1000
+  ys = E*ys + Tprop*R(:, kk);
+  xm(kk) = num*ys;
+end
+max(abs(xm - x(1:1000, 1)))/max(abs(xm))
+
+tic
+ao.ngprop(Tprop, E, num', y, Nsamples, seed);
+tall = toc
+
+%% Continuity between two calls
+
+[x1, y1] = ltpda_ngprop(Tprop, E, num, y, 1000, seed);
+[x2, y2] = ltpda_ngprop(Tprop, E, num, y1, Nsamples-1000, seed, 1000);
+max(max(abs([x1; x2] - x)))
+max(max(abs(y2 - yf)))
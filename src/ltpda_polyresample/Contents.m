@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_polyresample   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_polyresample\compile">src\ltpda_polyresample\compile</a>                 -  package within MATLAB
+%   <a href="matlab:help src\ltpda_polyresample\ltpda_polyresample">src\ltpda_polyresample\ltpda_polyresample</a>      -  A mex file to resample data by P/Q with a polyphase FIR filter.
+%   <a href="matlab:help src\ltpda_polyresample\test_ltpda_polyresample">src\ltpda_polyresample\test_ltpda_polyresample</a> - %
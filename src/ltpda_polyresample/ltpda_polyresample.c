@@ -0,0 +1,199 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_polyresample.h"
+
+#define DEBUG 0
+
+/* number of output samples of a channel computed in turn */
+#define BLOCK 4096
+
+/*
+ * A mex file to resample data by a rational factor P/Q with a FIR filter.
+ *
+ * The output is the one of upfirdn(x, h, P, Q),
+ *
+ *   y(m) = sum over k of h(k) * xu(m*Q - k)
+ *
+ * where xu is x upsampled by P with zeros, but only the output samples
+ * which are asked for are computed, and the zeros are never multiplied:
+ * the filter is split in its P phases h(r), h(r+P), h(r+2P), ... and the
+ * output sample m is the phase r = m*Q mod P applied to the input samples
+ * before floor(m*Q/P).
+ *
+ * The output samples of each channel are computed in blocks of BLOCK,
+ * which are shared between threads when the file is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function y = ltpda_polyresample(x, h, P, Q, n0, m0, Ny, nthreads);
+ *
+ * x  - Nx x Nch, the input samples n0 to n0+Nx-1 of each channel
+ * h  - the filter
+ * P  - upsampling factor
+ * Q  - downsampling factor
+ * n0 - index of the first input sample
+ * m0 - index of the first output sample
+ * Ny - number of output samples
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y;
+
+  /* inputs */
+  double *x, *h;
+
+  /* the phases of the filter */
+  double *H;
+
+  long int Nx, Nch, Lh, Lp, P, Q, n0, m0, Ny, Nb, tt, rr, ii, kk;
+  int      nthreads;
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 7 || nrhs == 8) && (nlhs == 1) )/* let's go */
+  {
+    for (kk=0; kk<2; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data and the filter must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      Nx  = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      Nx  = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    Lh = (long int)mxGetNumberOfElements(prhs[1]);
+    P  = (long int)mxGetScalar(prhs[2]);
+    Q  = (long int)mxGetScalar(prhs[3]);
+    n0 = (long int)mxGetScalar(prhs[4]);
+    m0 = (long int)mxGetScalar(prhs[5]);
+    Ny = (long int)mxGetScalar(prhs[6]);
+    nthreads = 0;
+    if (nrhs == 8)
+      nthreads = (int)mxGetScalar(prhs[7]);
+
+    if (Lh < 1)
+      mexErrMsgTxt("### the filter must have at least one coefficient");
+    if (P < 1 || Q < 1)
+      mexErrMsgTxt("### the resampling factors must be positive integers");
+    if (n0 < 0 || m0 < 0)
+      mexErrMsgTxt("### the indices of the first samples must be positive");
+    if (Ny < 0)
+      Ny = 0;
+
+    #if DEBUG
+    mexPrintf("Nx: %d\n", Nx);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Lh: %d\n", Lh);
+    mexPrintf("P/Q: %d/%d\n", P, Q);
+    mexPrintf("Ny: %d\n", Ny);
+    #endif
+
+    /*----------------- set inputs*/
+    x = mxGetPr(prhs[0]);
+    h = mxGetPr(prhs[1]);
+
+    /* the P phases of Lp coefficients, one after the other */
+    Lp = (Lh + P - 1)/P;
+    H  = (double*)calloc(P*Lp, sizeof(double));
+    for (rr=0; rr<P; rr++)
+      for (ii=0; rr+ii*P<Lh; ii++)
+        H[rr*Lp + ii] = h[rr + ii*P];
+
+    /* outputs */
+    plhs[0] = mxCreateDoubleMatrix(Ny, Nch, mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    Nb = (Ny + BLOCK - 1)/BLOCK;
+    #pragma omp parallel for schedule(dynamic)
+    for (tt=0; tt<Nb*Nch; tt++) {
+      long int cc = tt/Nb;
+      long int b0 = (tt%Nb)*BLOCK;
+      long int nb = (Ny - b0 < BLOCK) ? Ny - b0 : BLOCK;
+
+      poly_block(H, P, Q, Lp, x + cc*Nx, Nx, m0 + b0, n0, nb, y + cc*Ny + b0);
+    }
+
+    free(H);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * The ny output samples of a channel from the output sample m. The phase
+ * and the last input sample of each output sample are stepped from those
+ * of the first one, so that m*Q is never computed.
+ */
+void poly_block(const double *H, long int P, long int Q, long int Lp,
+                const double *x, long int Nx, long int m, long int n0,
+                long int ny, double *y)
+{
+  long int nn, ii, r, j, i0, i1, dq, rq;
+  const double *Hr;
+  double   s;
+
+  /* m*Q = j*P + r */
+  j  = (m/P)*Q + ((m%P)*Q)/P - n0;
+  r  = ((m%P)*Q)%P;
+  dq = Q/P;
+  rq = Q%P;
+
+  for (nn=0; nn<ny; nn++) {
+    /* the taps which fall on the input samples 0..Nx-1 */
+    i0 = (j >= Nx) ? j - Nx + 1 : 0;
+    i1 = (j + 1 < Lp) ? j + 1 : Lp;
+    Hr = H + r*Lp;
+    s  = 0.0;
+    for (ii=i0; ii<i1; ii++)
+      s += Hr[ii]*x[j - ii];
+    y[nn] = s;
+
+    j += dq;
+    r += rq;
+    if (r >= P) {
+      r -= P;
+      j++;
+    }
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_polyresample version %s\n", version);
+  mexPrintf("  usage:    y = ltpda_polyresample(x, h, P, Q, n0, m0, Ny);\n");
+  mexPrintf("            y = ltpda_polyresample(x, h, P, Q, n0, m0, Ny, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,11 @@
+/*
+ * Header for ltpda_polyresample.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void poly_block(const double *H, long int P, long int Q, long int Lp,
+                const double *x, long int Nx, long int m, long int n0,
+                long int ny, double *y);
@@ -0,0 +1,26 @@
+% LTPDA_POLYRESAMPLE A mex file to resample data by P/Q with a polyphase FIR filter.
+%
+% function y = ltpda_polyresample(x, h, P, Q, n0, m0, Ny);
+% function y = ltpda_polyresample(x, h, P, Q, n0, m0, Ny, nthreads);
+%
+% Computes the output samples m0 to m0+Ny-1 of upfirdn(x, h, P, Q), where
+% the input samples before and after x are zeros. Each output sample is one
+% of the P phases of the filter applied to the input samples: the zeros of
+% the upsampled data are never multiplied, and the other output samples
+% are not computed. The blocks of output samples of the channels are
+% shared between threads.
+%
+% Inputs:
+%          x - The data (Nx x Nchannels), the input samples n0 to n0+Nx-1
+%          h - The filter
+%       P, Q - The resampling factor P/Q
+%         n0 - The index of the first input sample
+%         m0 - The index of the first output sample
+%         Ny - The number of output samples
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          y - The resampled data (Ny x Nchannels)
+%
+% This is the compiled engine of utils.math.polyresample.
+%
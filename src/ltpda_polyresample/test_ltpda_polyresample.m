@@ -0,0 +1,45 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nch      = 4;
+fs       = 100;
+fsout    = 1;
+
+x = randn(Nsamples, Nch);
+
+%% Validate against resample
+
+kernel = utils.math.resamplekernel(fsout, fs);
+tic
+y = utils.math.polyresample(x, kernel);
+tmex = toc
+
+tic
+yr = resample(x, fsout, fs);
+tall = toc
+max(max(abs(y - yr)))
+
+kernel = utils.math.resamplekernel(3, 7);
+max(max(abs(utils.math.polyresample(x(1:1e4, :), kernel) - resample(x(1:1e4, :), 3, 7))))
+
+kernel = utils.math.resamplekernel(7, 3);
+max(max(abs(utils.math.polyresample(x(1:1e4, :), kernel) - resample(x(1:1e4, :), 7, 3))))
+
+%% The same output with one thread
+
+kernel = utils.math.resamplekernel(fsout, fs);
+y1 = ltpda_polyresample(x, kernel.h, kernel.P, kernel.Q, 0, kernel.delay, size(y, 1), 1);
+isequal(y1, y)
+
+%% Streaming in chunks
+
+ys = [];
+zi = [];
+for kk = 1:10
+  [yk, zi] = utils.math.polyresample(x((kk-1)*Nsamples/10+1:kk*Nsamples/10, :), kernel, zi);
+  ys = [ys; yk];
+end
+[yk, zi] = utils.math.polyresample(zeros(kernel.delay*kernel.Q, Nch), kernel, zi);
+ys = [ys; yk];
+max(max(abs(ys(kernel.delay+1:kernel.delay+size(y, 1), :) - y)))
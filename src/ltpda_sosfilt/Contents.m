@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_sosfilt   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_sosfilt\compile">src\ltpda_sosfilt\compile</a>            -  package within MATLAB
+%   <a href="matlab:help src\ltpda_sosfilt\ltpda_sosfilt">src\ltpda_sosfilt\ltpda_sosfilt</a>      -  A mex file to filter data with a cascade of second-order sections.
+%   <a href="matlab:help src\ltpda_sosfilt\test_ltpda_sosfilt">src\ltpda_sosfilt\test_ltpda_sosfilt</a> - %
@@ -0,0 +1,289 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_sosfilt.h"
+
+#define DEBUG 0
+
+/* number of samples of all the channels filtered by each section in turn */
+#define BLOCK 1024
+
+/* from this number of channels on, the vectorised loop runs over channels */
+#define MIN_CHANNELS 4
+
+/*
+ * A mex file to filter data with a cascade of second-order sections.
+ *
+ * Each section is a biquad in direct form II transposed,
+ *
+ *   y(n)  = a0*x(n) + z1
+ *   z1    = a1*x(n) - b1*y(n) + z2
+ *   z2    = a2*x(n) - b2*y(n)
+ *
+ * with the coefficients normalised by b0 (the LTPDA convention: a is the
+ * numerator, b the denominator). The innermost loop runs over independent
+ * recursions, so that the compiler vectorises it:
+ *
+ *   - with MIN_CHANNELS channels or more, the channels are interleaved in a
+ *     block buffer and the loop runs over the channels, which share the
+ *     coefficients;
+ *   - with fewer channels, as for the single series of ao/filter, the
+ *     sections are pipelined: at step t the section k filters the sample
+ *     t-k, which the section k-1 has filtered at step t-1, so the loop
+ *     runs over the sections. The channels are shared between threads when
+ *     the file is compiled with OpenMP.
+ *
+ * Both orders do the same operations on each sample, so the output does
+ * not depend on the number of channels or threads.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function [y, Zf] = ltpda_sosfilt(x, sos, Zi);
+ *
+ * x   - N x Nch
+ * sos - Nsec x 6, one section [a0 a1 a2 b0 b1 b2] per row
+ * Zi  - 2 x Nsec x Nch
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double *y, *Zf;
+
+  /* inputs */
+  double *x, *sos, *Zi;
+
+  /* normalised sections, states with the channels innermost, block buffer */
+  double *s, *z, *buf;
+
+  /* the coefficients of the pipeline, one array per coefficient */
+  double *c;
+
+  long int N, Nch, Nsec, b0, nb, nn, cc, kk;
+  mwSize   dims[3];
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( nrhs == 3 && (nlhs >= 1 && nlhs <= 2) )/* let's go */
+  {
+    for (kk=0; kk<3; kk++) {
+      if ( !mxIsDouble(prhs[kk]) || mxIsComplex(prhs[kk]) )
+        mexErrMsgTxt("### the data, sections and states must be real double arrays");
+    }
+
+    if (mxGetM(prhs[0]) == 1) {
+      N   = (long int)mxGetN(prhs[0]);
+      Nch = 1;
+    }
+    else {
+      N   = (long int)mxGetM(prhs[0]);
+      Nch = (long int)mxGetN(prhs[0]);
+    }
+    Nsec = (long int)mxGetM(prhs[1]);
+
+    if ( Nsec < 1 || mxGetN(prhs[1]) != 6 )
+      mexErrMsgTxt("### the sections must be a Nsec x 6 array");
+    if ( (long int)mxGetNumberOfElements(prhs[2]) != 2*Nsec*Nch )
+      mexErrMsgTxt("### the initial states must be a 2 x Nsec x Nch array");
+
+    #if DEBUG
+    mexPrintf("N: %d\n", N);
+    mexPrintf("Nch: %d\n", Nch);
+    mexPrintf("Nsec: %d\n", Nsec);
+    #endif
+
+    /*----------------- set inputs*/
+    x   = mxGetPr(prhs[0]);
+    sos = mxGetPr(prhs[1]);
+    Zi  = mxGetPr(prhs[2]);
+
+    s = (double*)calloc(6*Nsec, sizeof(double));
+    for (kk=0; kk<Nsec; kk++) {
+      if (sos[kk + 3*Nsec] == 0.0) {
+        free(s);
+        mexErrMsgTxt("### the leading denominator coefficient of each section must be nonzero");
+      }
+      for (nn=0; nn<6; nn++)
+        s[6*kk + nn] = sos[kk + nn*Nsec]/sos[kk + 3*Nsec];
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(mxGetM(prhs[0]), mxGetN(prhs[0]), mxREAL);
+    y = mxGetPr(plhs[0]);
+
+    dims[0] = 2;
+    dims[1] = (mwSize)Nsec;
+    dims[2] = (mwSize)Nch;
+    if (nlhs > 1) {
+      plhs[1] = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+      Zf = mxGetPr(plhs[1]);
+    }
+    else {
+      Zf = (double*)calloc(2*Nsec*Nch+1, sizeof(double));
+    }
+
+    if (Nch >= MIN_CHANNELS) {
+
+      /* states: z[(2*k + j)*Nch + c] */
+      z = (double*)calloc(2*Nsec*Nch+1, sizeof(double));
+      for (cc=0; cc<Nch; cc++)
+        for (kk=0; kk<2*Nsec; kk++)
+          z[kk*Nch + cc] = Zi[kk + cc*2*Nsec];
+
+      buf = (double*)calloc(BLOCK*Nch, sizeof(double));
+
+      /* do the business */
+      for (b0=0; b0<N; b0+=BLOCK) {
+        nb = (N - b0 < BLOCK) ? N - b0 : BLOCK;
+        for (cc=0; cc<Nch; cc++)
+          for (nn=0; nn<nb; nn++)
+            buf[nn*Nch + cc] = x[cc*N + b0 + nn];
+        sos_block(buf, nb, Nch, s, Nsec, z);
+        for (cc=0; cc<Nch; cc++)
+          for (nn=0; nn<nb; nn++)
+            y[cc*N + b0 + nn] = buf[nn*Nch + cc];
+      }
+
+      for (cc=0; cc<Nch; cc++)
+        for (kk=0; kk<2*Nsec; kk++)
+          Zf[kk + cc*2*Nsec] = z[kk*Nch + cc];
+
+      free(buf);
+      free(z);
+    }
+    else {
+
+      /* c[j*Nsec + k]: the coefficient j of the section k */
+      c = (double*)calloc(6*Nsec, sizeof(double));
+      for (kk=0; kk<Nsec; kk++)
+        for (nn=0; nn<6; nn++)
+          c[nn*Nsec + kk] = s[6*kk + nn];
+
+      /* do the business */
+      #pragma omp parallel for schedule(static)
+      for (cc=0; cc<Nch; cc++) {
+        double   *z1, *z2, *u, *v;
+        long int  ks;
+
+        z1 = (double*)calloc(4*Nsec, sizeof(double));
+        z2 = z1 + Nsec;
+        u  = z1 + 2*Nsec;
+        v  = z1 + 3*Nsec;
+        for (ks=0; ks<Nsec; ks++) {
+          z1[ks] = Zi[2*ks + cc*2*Nsec];
+          z2[ks] = Zi[2*ks + 1 + cc*2*Nsec];
+        }
+        sos_pipeline(x + cc*N, y + cc*N, N, c, Nsec, z1, z2, u, v);
+        for (ks=0; ks<Nsec; ks++) {
+          Zf[2*ks + cc*2*Nsec]     = z1[ks];
+          Zf[2*ks + 1 + cc*2*Nsec] = z2[ks];
+        }
+        free(z1);
+      }
+
+      free(c);
+    }
+
+    if (nlhs <= 1)
+      free(Zf);
+
+    free(s);
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Filter in place nb interleaved samples of Nch channels with the Nsec
+ * normalised sections. The states z are updated.
+ */
+void sos_block(double *buf, long int nb, long int Nch,
+               const double *sos, long int Nsec, double *z)
+{
+  long int kk, nn, cc;
+  double   a0, a1, a2, b1, b2;
+  double  *z1, *z2, *v;
+  double   xi, yo;
+
+  for (kk=0; kk<Nsec; kk++) {
+    a0 = sos[6*kk];
+    a1 = sos[6*kk + 1];
+    a2 = sos[6*kk + 2];
+    b1 = sos[6*kk + 4];
+    b2 = sos[6*kk + 5];
+    z1 = z + 2*kk*Nch;
+    z2 = z + (2*kk + 1)*Nch;
+    for (nn=0; nn<nb; nn++) {
+      v = buf + nn*Nch;
+      for (cc=0; cc<Nch; cc++) {
+        xi     = v[cc];
+        yo     = a0*xi + z1[cc];
+        z1[cc] = a1*xi - b1*yo + z2[cc];
+        z2[cc] = a2*xi - b2*yo;
+        v[cc]  = yo;
+      }
+    }
+  }
+}
+
+/*
+ * Filter the N samples of one channel with the Nsec normalised sections,
+ * pipelined: at step t, the section k filters the sample t-k, which is
+ * in u[k], and writes its output to v[k]. The sections active at step t
+ * are contiguous, so the loop over them is vectorised. The coefficients
+ * are c[j*Nsec + k] and the states z1, z2 are updated.
+ */
+void sos_pipeline(const double *x, double *y, long int N,
+                  const double *c, long int Nsec,
+                  double *z1, double *z2, double *u, double *v)
+{
+  const double *a0 = c,          *a1 = c + Nsec,   *a2 = c + 2*Nsec;
+  const double *b1 = c + 4*Nsec, *b2 = c + 5*Nsec;
+  long int t, kk, lo, hi;
+  double   xi, yo;
+
+  for (t=0; t<N+Nsec-1; t++) {
+    u[0] = (t < N) ? x[t] : 0.0;
+    lo   = (t - N + 1 > 0) ? t - N + 1 : 0;
+    hi   = (t < Nsec - 1) ? t : Nsec - 1;
+    /* the arrays do not overlap */
+    #pragma omp simd
+    for (kk=lo; kk<=hi; kk++) {
+      xi     = u[kk];
+      yo     = a0[kk]*xi + z1[kk];
+      z1[kk] = a1[kk]*xi - b1[kk]*yo + z2[kk];
+      z2[kk] = a2[kk]*xi - b2[kk]*yo;
+      v[kk]  = yo;
+    }
+    if (t >= Nsec - 1)
+      y[t - Nsec + 1] = v[Nsec - 1];
+    for (kk=1; kk<Nsec; kk++)
+      u[kk] = v[kk-1];
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_sosfilt version %s\n", version);
+  mexPrintf("  usage:    [y, Zf] = ltpda_sosfilt(x, sos, Zi);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,14 @@
+/*
+ * Header for ltpda_sosfilt.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void sos_block(double *buf, long int nb, long int Nch,
+               const double *sos, long int Nsec, double *z);
+
+void sos_pipeline(const double *x, double *y, long int N,
+                  const double *c, long int Nsec,
+                  double *z1, double *z2, double *u, double *v);
@@ -0,0 +1,25 @@
+% LTPDA_SOSFILT A mex file to filter data with a cascade of second-order sections.
+%
+% function [y, Zf] = ltpda_sosfilt(x, sos, Zi);
+%
+% Filters the data through each biquad section in turn, in direct form II
+% transposed. With four channels or more, the channels are interleaved in
+% blocks so that each step of the recursion is done for all the channels
+% at once. With fewer channels, as for a single series, the sections are
+% pipelined: the section k filters the sample n while the section k+1
+% filters the sample n-1, so that each step is done for all the sections
+% at once, and the channels are shared between threads. The output is
+% the same in both cases.
+%
+% Inputs:
+%          x - The data (Nsamples x Nchannels, or a vector)
+%        sos - The sections (Nsections x 6), one [a0 a1 a2 b0 b1 b2] per
+%              row, with a the numerator and b the denominator
+%         Zi - The initial states (2 x Nsections x Nchannels)
+%
+% Outputs:
+%          y - The filtered data, with the size of x
+%         Zf - The final states (2 x Nsections x Nchannels)
+%
+% This is the compiled version of utils.math.sosfilt.
+%
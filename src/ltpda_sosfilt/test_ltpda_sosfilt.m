@@ -0,0 +1,48 @@
+clear all;
+compile
+
+Nsamples = 1e6;
+Nch      = 8;
+
+%% Validate against filter, section by section
+
+pzm = pzmodel(1, {[0.1 2], [1 3], 0.5}, {[2 1.5], 4});
+f   = miir(pzm, plist('fs', 100));
+sos = f.sos;
+
+x  = randn(Nsamples, Nch);
+Zi = randn(2, size(sos,1), Nch);
+
+tic
+[yx, Zfx] = ltpda_sosfilt(x, sos, Zi);
+tmex = toc
+
+tic
+y  = x;
+Zf = zeros(size(Zi));
+for cc = 1:Nch
+  for kk = 1:size(sos,1)
+    [y(:,cc), Zf(:,kk,cc)] = filter(sos(kk,1:3), sos(kk,4:6), y(:,cc), Zi(:,kk,cc));
+  end
+end
+tmat = toc
+
+max(abs(yx(:) - y(:)))/max(abs(y(:)))
+max(abs(Zfx(:) - Zf(:)))
+tmat/tmex
+
+%% The pipelined sections, for fewer channels, give the same output
+
+[y1, Zf1] = ltpda_sosfilt(x(:,1:2), sos, Zi(:,:,1:2));
+isequal(y1, yx(:,1:2))
+isequal(Zf1, Zfx(:,:,1:2))
+
+tic
+ltpda_sosfilt(x(:,1), sos, Zi(:,:,1));
+t1 = toc
+
+%% Against the direct form of the whole filter
+
+y = filter(f.a, f.b, x(:,1));
+yx = ltpda_sosfilt(x(:,1), sos, zeros(2, size(sos,1)));
+max(abs(yx - y))/max(abs(y))
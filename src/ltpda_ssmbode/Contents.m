@@ -0,0 +1,5 @@
+%%%%%%%%%%%%%%%%%%%%   path: src\ltpda_ssmbode   %%%%%%%%%%%%%%%%%%%%
+%
+%   <a href="matlab:help src\ltpda_ssmbode\compile">src\ltpda_ssmbode\compile</a>            -  package within MATLAB
+%   <a href="matlab:help src\ltpda_ssmbode\ltpda_ssmbode">src\ltpda_ssmbode\ltpda_ssmbode</a>      -  A mex file to compute the frequency response of a SS model in Hessenberg form.
+%   <a href="matlab:help src\ltpda_ssmbode\test_ltpda_ssmbode">src\ltpda_ssmbode\test_ltpda_ssmbode</a> - %
@@ -0,0 +1,344 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mex.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "matrix.h"
+#include "version.h"
+#include "ltpda_ssmbode.h"
+
+#define DEBUG 0
+/*
+ * A mex file to compute the frequency response of a state-space model
+ * given in Hessenberg form:
+ *
+ *   G(z) = P * (z*I - H)^-1 * Q + D
+ *
+ * for a vector of (complex) values of z. For a discrete system z = exp(i*w*Ts),
+ * for a continuous system z = i*w.
+ *
+ * Since H is upper Hessenberg, z*I - H is factorised in O(n^2) with a
+ * Gaussian elimination that only pivots between adjacent rows, see
+ * Laub, A.J., "Efficient Multivariable Frequency Response Computations",
+ * IEEE Transactions on Automatic Control, AC-26 (1981), pp. 407-408.
+ *
+ * The frequencies are independent and are shared between threads when the
+ * file is compiled with OpenMP.
+ *
+ * $Id$
+ */
+
+
+/*
+ * function G = ltpda_ssmbode(H, P, Q, D, z, nthreads);
+ */
+void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+  /* outputs */
+  double  *Gr, *Gi;
+
+  /* inputs */
+  double *H, *P, *Q, *D;
+  double *zr, *zi;
+
+  /* kernel matrices, possibly for the transposed problem */
+  double *negH, *Pk, *Qk, *Dk;
+
+  long int n, No, Ni, Nf, Nok, Nik;
+  long int ldg, sdg;
+  long int ii, jj, ff;
+  int      transpose;
+  int      nthreads;
+  mwSize   dims[3];
+
+
+  /* parse input functions */
+
+  if( (nrhs == 0) || (nlhs == 0) )
+  {
+    print_usage(VERSION);
+  }
+
+  if( (nrhs == 5 || nrhs == 6) && (nlhs == 1) )/* let's go */
+  {
+    for (ii=0; ii<4; ii++) {
+      if ( !mxIsDouble(prhs[ii]) || mxIsComplex(prhs[ii]) )
+        mexErrMsgTxt("### the system matrices must be real double arrays");
+    }
+
+    /*----------------- set inputs*/
+    H  = mxGetPr(prhs[0]);
+    P  = mxGetPr(prhs[1]);
+    Q  = mxGetPr(prhs[2]);
+    D  = mxGetPr(prhs[3]);
+    zr = mxGetPr(prhs[4]);
+    zi = mxGetPi(prhs[4]);
+
+    n  = (long int)mxGetM(prhs[0]);
+    No = (long int)mxGetM(prhs[1]);
+    Ni = (long int)mxGetN(prhs[2]);
+    Nf = (long int)mxGetNumberOfElements(prhs[4]);
+
+    if ( (long int)mxGetN(prhs[0]) != n || (long int)mxGetN(prhs[1]) != n || (long int)mxGetM(prhs[2]) != n )
+      mexErrMsgTxt("### the sizes of H, P and Q are inconsistent");
+    if ( !mxIsEmpty(prhs[3]) && ((long int)mxGetM(prhs[3]) != No || (long int)mxGetN(prhs[3]) != Ni) )
+      mexErrMsgTxt("### the size of D is inconsistent");
+
+    nthreads = 0;
+    if (nrhs == 6)
+      nthreads = (int)mxGetScalar(prhs[5]);
+
+    #if DEBUG
+    mexPrintf("Nstates: %d\n", n);
+    mexPrintf("Noutputs: %d\n", No);
+    mexPrintf("Ninputs: %d\n", Ni);
+    mexPrintf("Nfreqs: %d\n", Nf);
+    #endif
+
+    /* output G, No x Ni x Nf */
+    dims[0] = No;
+    dims[1] = Ni;
+    dims[2] = Nf;
+    plhs[0] = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxCOMPLEX);
+    Gr = mxGetPr(plhs[0]);
+    Gi = mxGetPi(plhs[0]);
+
+    if (No == 0 || Ni == 0 || Nf == 0)
+      return;
+
+    /*
+     * The back substitution costs O(n^2) per right-hand side. If there are
+     * fewer outputs than inputs, solve the transposed problem
+     *   G.' = (Q.'*J) * (z*I - J*H.'*J)^-1 * (J*P.') + D.'
+     * where J is the exchange matrix, so that J*H.'*J is upper Hessenberg.
+     */
+    transpose = (No < Ni);
+
+    negH = (double*)calloc(n*n+1, sizeof(double));
+    Dk   = (double*)calloc(No*Ni, sizeof(double));
+    if (transpose) {
+      Nok = Ni;
+      Nik = No;
+      Pk  = (double*)calloc(Nok*n+1, sizeof(double));
+      Qk  = (double*)calloc(n*Nik+1, sizeof(double));
+      /* row-major J*H.'*J: element (i,j) is H(n-1-j, n-1-i) */
+      for (ii=0; ii<n; ii++)
+        for (jj=0; jj<n; jj++)
+          negH[ii*n+jj] = -H[(n-1-jj) + (n-1-ii)*n];
+      for (ii=0; ii<Nok; ii++)
+        for (jj=0; jj<n; jj++)
+          Pk[ii + jj*Nok] = Q[(n-1-jj) + ii*n];
+      for (ii=0; ii<n; ii++)
+        for (jj=0; jj<Nik; jj++)
+          Qk[ii + jj*n] = P[jj + (n-1-ii)*No];
+      if (!mxIsEmpty(prhs[3]))
+        for (ii=0; ii<Nok; ii++)
+          for (jj=0; jj<Nik; jj++)
+            Dk[ii + jj*Nok] = D[jj + ii*No];
+      ldg = No;
+      sdg = 1;
+    }
+    else {
+      Nok = No;
+      Nik = Ni;
+      Pk  = P;
+      Qk  = Q;
+      /* row-major H */
+      for (ii=0; ii<n; ii++)
+        for (jj=0; jj<n; jj++)
+          negH[ii*n+jj] = -H[ii + jj*n];
+      if (!mxIsEmpty(prhs[3]))
+        memcpy(Dk, D, No*Ni*sizeof(double));
+      ldg = 1;
+      sdg = No;
+    }
+
+    #ifdef _OPENMP
+    if (nthreads > 0)
+      omp_set_num_threads(nthreads);
+    #endif
+
+    /* do the business */
+    #pragma omp parallel private(ff)
+    {
+      double *Mr, *Mi, *Xr, *Xi;
+
+      /* per-thread work space */
+      Mr = (double*)malloc((n*n+1)*sizeof(double));
+      Mi = (double*)malloc((n*n+1)*sizeof(double));
+      Xr = (double*)malloc((n*Nik+1)*sizeof(double));
+      Xi = (double*)malloc((n*Nik+1)*sizeof(double));
+
+      #pragma omp for schedule(static)
+      for (ff=0; ff<Nf; ff++) {
+        hess_response(negH, Pk, Qk, Dk, n, Nok, Nik,
+                      zr[ff], (zi == NULL) ? 0.0 : zi[ff],
+                      Mr, Mi, Xr, Xi,
+                      &(Gr[ff*No*Ni]), &(Gi[ff*No*Ni]), ldg, sdg);
+      }
+
+      free(Mr);
+      free(Mi);
+      free(Xr);
+      free(Xi);
+    }
+
+    free(negH);
+    free(Dk);
+    if (transpose) {
+      free(Pk);
+      free(Qk);
+    }
+
+  }
+  else
+  {
+    print_usage(VERSION);
+  }
+}
+
+/*
+ * Response at a single value of z.
+ *
+ *  negH   - minus the upper Hessenberg matrix, row-major n x n
+ *  P      - No x n, column-major
+ *  Q      - n x Ni, column-major
+ *  D      - No x Ni, column-major
+ *  Mr,Mi  - n x n work space
+ *  Xr,Xi  - n x Ni work space
+ *  Gr,Gi  - output, element (o,i) is stored at o*ldg + i*sdg
+ */
+void hess_response(const double *negH, const double *P, const double *Q, const double *D,
+                   long int n, long int No, long int Ni, double zr, double zi,
+                   double *Mr, double *Mi, double *Xr, double *Xi,
+                   double *Gr, double *Gi, long int ldg, long int sdg)
+{
+  long int kk, jj, ii, oo;
+  double   ar, ai, br, bi, lr, li, den, tr, ti;
+  double  *rowr, *rowi, *nxtr, *nxti;
+
+  /* M = z*I - H */
+  memcpy(Mr, negH, n*n*sizeof(double));
+  memset(Mi, 0, n*n*sizeof(double));
+  for (kk=0; kk<n; kk++) {
+    Mr[kk*n+kk] += zr;
+    Mi[kk*n+kk]  = zi;
+  }
+
+  /* X = Q, row-major */
+  for (kk=0; kk<n; kk++) {
+    for (ii=0; ii<Ni; ii++) {
+      Xr[kk*Ni+ii] = Q[kk + ii*n];
+      Xi[kk*Ni+ii] = 0.0;
+    }
+  }
+
+  /* elimination of the sub-diagonal */
+  for (kk=0; kk<n-1; kk++) {
+
+    ar = Mr[kk*n+kk];
+    ai = Mi[kk*n+kk];
+    br = Mr[(kk+1)*n+kk];
+    bi = Mi[(kk+1)*n+kk];
+
+    /* partial pivoting between rows kk and kk+1 */
+    if (br*br + bi*bi > ar*ar + ai*ai) {
+      for (jj=kk; jj<n; jj++) {
+        tr = Mr[kk*n+jj]; Mr[kk*n+jj] = Mr[(kk+1)*n+jj]; Mr[(kk+1)*n+jj] = tr;
+        ti = Mi[kk*n+jj]; Mi[kk*n+jj] = Mi[(kk+1)*n+jj]; Mi[(kk+1)*n+jj] = ti;
+      }
+      for (ii=0; ii<Ni; ii++) {
+        tr = Xr[kk*Ni+ii]; Xr[kk*Ni+ii] = Xr[(kk+1)*Ni+ii]; Xr[(kk+1)*Ni+ii] = tr;
+        ti = Xi[kk*Ni+ii]; Xi[kk*Ni+ii] = Xi[(kk+1)*Ni+ii]; Xi[(kk+1)*Ni+ii] = ti;
+      }
+      tr = ar; ar = br; br = tr;
+      ti = ai; ai = bi; bi = ti;
+    }
+
+    if (br == 0.0 && bi == 0.0)
+      continue;
+
+    /* l = M(kk+1,kk)/M(kk,kk) */
+    den = ar*ar + ai*ai;
+    lr  = (br*ar + bi*ai)/den;
+    li  = (bi*ar - br*ai)/den;
+
+    rowr = &(Mr[kk*n]);
+    rowi = &(Mi[kk*n]);
+    nxtr = &(Mr[(kk+1)*n]);
+    nxti = &(Mi[(kk+1)*n]);
+    for (jj=kk+1; jj<n; jj++) {
+      nxtr[jj] -= lr*rowr[jj] - li*rowi[jj];
+      nxti[jj] -= lr*rowi[jj] + li*rowr[jj];
+    }
+
+    rowr = &(Xr[kk*Ni]);
+    rowi = &(Xi[kk*Ni]);
+    nxtr = &(Xr[(kk+1)*Ni]);
+    nxti = &(Xi[(kk+1)*Ni]);
+    for (ii=0; ii<Ni; ii++) {
+      nxtr[ii] -= lr*rowr[ii] - li*rowi[ii];
+      nxti[ii] -= lr*rowi[ii] + li*rowr[ii];
+    }
+  }
+
+  /* back substitution, row by row */
+  for (kk=n-1; kk>=0; kk--) {
+    rowr = &(Xr[kk*Ni]);
+    rowi = &(Xi[kk*Ni]);
+    for (jj=kk+1; jj<n; jj++) {
+      ar = Mr[kk*n+jj];
+      ai = Mi[kk*n+jj];
+      if (ar == 0.0 && ai == 0.0)
+        continue;
+      nxtr = &(Xr[jj*Ni]);
+      nxti = &(Xi[jj*Ni]);
+      for (ii=0; ii<Ni; ii++) {
+        rowr[ii] -= ar*nxtr[ii] - ai*nxti[ii];
+        rowi[ii] -= ar*nxti[ii] + ai*nxtr[ii];
+      }
+    }
+    /* 1/M(kk,kk) */
+    ar  = Mr[kk*n+kk];
+    ai  = Mi[kk*n+kk];
+    den = ar*ar + ai*ai;
+    lr  =  ar/den;
+    li  = -ai/den;
+    for (ii=0; ii<Ni; ii++) {
+      tr = rowr[ii];
+      ti = rowi[ii];
+      rowr[ii] = lr*tr - li*ti;
+      rowi[ii] = lr*ti + li*tr;
+    }
+  }
+
+  /* G = P*X + D */
+  for (ii=0; ii<Ni; ii++) {
+    for (oo=0; oo<No; oo++) {
+      Gr[oo*ldg + ii*sdg] = D[oo + ii*No];
+      Gi[oo*ldg + ii*sdg] = 0.0;
+    }
+    for (kk=0; kk<n; kk++) {
+      tr = Xr[kk*Ni+ii];
+      ti = Xi[kk*Ni+ii];
+      for (oo=0; oo<No; oo++) {
+        Gr[oo*ldg + ii*sdg] += P[oo + kk*No]*tr;
+        Gi[oo*ldg + ii*sdg] += P[oo + kk*No]*ti;
+      }
+    }
+  }
+}
+
+void print_usage(char *version)
+{
+  mexPrintf("ltpda_ssmbode version %s\n", version);
+  mexPrintf("  usage:    G = ltpda_ssmbode(H, P, Q, D, z);\n");
+  mexPrintf("            G = ltpda_ssmbode(H, P, Q, D, z, nthreads);\n");
+  mexErrMsgTxt("### incorrect usage");
+}
@@ -0,0 +1,12 @@
+/*
+ * Header for ltpda_ssmbode.c
+ *
+ * $Id$
+ */
+
+void print_usage(char *version);
+
+void hess_response(const double *negH, const double *P, const double *Q, const double *D,
+                   long int n, long int No, long int Ni, double zr, double zi,
+                   double *Mr, double *Mi, double *Xr, double *Xi,
+                   double *Gr, double *Gi, long int ldg, long int sdg);
@@ -0,0 +1,23 @@
+
+% LTPDA_SSMBODE A mex file to compute the frequency response of a SS model in Hessenberg form.
+%
+% function G = ltpda_ssmbode(H, P, Q, D, z);
+% function G = ltpda_ssmbode(H, P, Q, D, z, nthreads);
+%
+% Computes G(:,:,k) = P * (z(k)*I - H)^-1 * Q + D for all values in z.
+%
+% Inputs:
+%          H - The A matrix in upper Hessenberg form, [T,H] = hess(A)
+%          P - The C matrix in the Hessenberg basis, C*T
+%          Q - The B matrix in the Hessenberg basis, T'*B
+%          D - The D matrix (may be empty)
+%          z - The complex frequency variable: exp(1i*w*Ts) for a
+%              discrete system, 1i*w for a continuous system
+%   nthreads - (optional) the number of threads to use
+%
+% Outputs:
+%          G - The Noutputs x Ninputs x Nfreqs response
+%
+% All matrices must be real. Each frequency costs O(n^2) operations per
+% input (or per output, whichever is fewer).
+%
@@ -0,0 +1,71 @@
+clear all;
+compile
+
+Nstates  = 50;
+Ninputs  = 3;
+Noutputs = 2;
+Nfreqs   = 1000;
+Ts       = 0.1;
+
+%% Validate against the MATLAB loop
+
+A = 0.1*randn(Nstates);
+B = randn(Nstates, Ninputs);
+C = randn(Noutputs, Nstates);
+D = randn(Noutputs, Ninputs);
+f = logspace(-3, log10(0.5/Ts), Nfreqs);
+z = exp(1i*2*pi*f*Ts);
+
+[T,H] = hess(A);
+P = C*T;
+Q = T'*B;
+
+tic
+Gx = ltpda_ssmbode(H, P, Q, D, z);
+tmex = toc
+
+tic
+G = zeros(Noutputs, Ninputs, Nfreqs);
+I = eye(Nstates);
+for ff = 1:Nfreqs
+  G(:,:,ff) = (P/(z(ff)*I - H))*Q + D;
+end
+tmat = toc
+
+max(abs(Gx(:)-G(:)))/max(abs(G(:)))
+tmat/tmex
+
+%% Transposed problem (more inputs than outputs)
+
+Gx = ltpda_ssmbode(H, P(1,:), Q, D(1,:), z);
+max(max(max(abs(Gx - G(1,:,:)))))/max(abs(G(:)))
+
+%% Run-time Vs Nstates
+
+Nstates = 10:20:210;
+tmex = zeros(length(Nstates),1);
+tmat = zeros(length(Nstates),1);
+for jj=1:length(Nstates)
+  Ns = Nstates(jj)
+  [T,H] = hess(0.1*randn(Ns));
+  P = randn(Noutputs, Ns);
+  Q = randn(Ns, Ninputs);
+  tic
+  Gx = ltpda_ssmbode(H, P, Q, D, z);
+  tmex(jj) = toc;
+  tic
+  I = eye(Ns);
+  for ff = 1:Nfreqs
+    G(:,:,ff) = (P/(z(ff)*I - H))*Q + D;
+  end
+  tmat(jj) = toc;
+end
+
+%%
+figure
+plot(Nstates, tmex, 'r-', Nstates, tmat, 'b-');
+legend('mex', 'matlab');
+ylabel('Run-time [s]');
+xlabel('Nstates')
+s = sprintf('Nfreqs=%d, Ninputs=%d, Noutputs=%d', Nfreqs, Ninputs, Noutputs);
+title(s)
@@ -7,6 +7,7 @@
 #include "matrix.h"
 #include "version.h"
 #include "ltpda_ssmsim.h"
+#include "../c_sources/philox.c"
 
 #define DEBUG 0
 /*
@@ -19,39 +20,77 @@
 
 
 /* 
- * function [y,lx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input);
+ * function [y,lx,x] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, Ndecim, avg, Bnoise.', Dnoise.', seed);
+ *
+ * The last inputs are optional. Every Ndecim samples one output sample
+ * is stored: either the first sample of the block (avg = 0) or the mean over
+ * the block (avg = 1). A trailing partial block is propagated but not stored.
+ *
+ * Bnoise and Dnoise map unit-variance white noise inputs onto the states and
+ * outputs. The noise is drawn here, sample by sample, from a counter-based
+ * generator keyed on the seed, so the same seed always gives the same noise.
+ *
+ * function [R,lx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, data, first, last);
+ *
+ * Residual mode: the outputs are compared with the measured data
+ * (Noutputs x Nsamples) and only the cross-products of the residuals
+ * r = data - y over the samples first..last (1-based) are accumulated,
+ * R = sum(r*r.'), so no output series is allocated. The propagation
+ * stops after the sample 'last'.
+ *
+ * function v = ltpda_ssmsim('version');
+ *
+ * Returns the version string, so that callers can check the interface of
+ * the compiled file before using it.
  */
 void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
 {
   
   /* outputs */
   double  *y, *yptr;
+  double  *x, *xptr;
   
   /* inputs */
   double *input, *iptr;
   double *Daos, *Dptr;
   double *Baos, *Bptr;
-  double *Cstates;
+  double *Cstates, *Csptr;
   double *Coutputs, *Coptr;
   double *A, *Aptr;
   double *lastX;
   double *SSini;
   double *tmpX;
+  double *tmpY;
+  double *Bnoise, *Bnptr;
+  double *Dnoise, *Dnptr;
+  double *noise;
+  double *data, *R, *res;
+  philox_uint64 seed;
   
-  mwSize Ninputs, Nsamples, Nstates, Nstatesout, Noutputs;
-  int kk,jj,ll;
-  int mm,nn;
-  int ki;  
+  mwSize Ninputs, Nsamples, Nstates, Nstatesout, Noutputs, Nnoise;
+  mwSize Ndecim, Nrecord;
+  mwSize first, last;
+  int    avg, resid;
+  double scale;
+  mwSize kk,jj,ll;
+  mwSize ki, kb, kr;
   
   
   /* parse input functions */
   
+  if (nrhs == 1 && mxIsChar(prhs[0]))
+  {
+    plhs[0] = mxCreateString(VERSION);
+    return;
+  }
+  
   if( (nrhs == 0) || (nlhs == 0) )
   {
     print_usage(VERSION);
   }
   
-  if( (nrhs == 7) && (nlhs == 2) )/* let's go */
+  if( ((nrhs == 7 || nrhs == 9 || nrhs == 12) && (nlhs == 2 || nlhs == 3)) ||
+      (nrhs == 10 && nlhs == 2) )/* let's go */
   {    
     /*----------------- set inputs*/
     SSini    = mxGetPr(prhs[0]);
@@ -65,15 +104,71 @@ void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     Ninputs    = mxGetM(prhs[4]);
     Nsamples   = mxGetN(prhs[6]);
     Nstates    = mxGetM(prhs[1]);
-    Nstatesout = mxGetM(prhs[3]);
+    Nstatesout = mxGetN(prhs[3]);
     Noutputs   = mxGetN(prhs[2]);    
 
+    Ndecim = 1;
+    avg    = 0;
+    if (nrhs == 9 || nrhs == 12) {
+      if (mxGetScalar(prhs[7]) < 1.0)
+        mexErrMsgTxt("### the decimation factor must be a positive integer");
+      Ndecim = (mwSize)floor(mxGetScalar(prhs[7]));
+      avg    = (mxGetScalar(prhs[8]) != 0.0);
+    }
+    Nnoise = 0;
+    Bnoise = NULL;
+    Dnoise = NULL;
+    seed   = 0;
+    if (nrhs == 12) {
+      if (mxGetScalar(prhs[11]) < 0.0)
+        mexErrMsgTxt("### the seed must be a non-negative integer");
+      seed = (philox_uint64)mxGetScalar(prhs[11]);
+      /* the noise may enter through Bnoise, Dnoise or both */
+      if (mxGetNumberOfElements(prhs[9]) > 0) {
+        Bnoise = mxGetPr(prhs[9]);
+        Nnoise = mxGetM(prhs[9]);
+        if (mxGetN(prhs[9]) != Nstates)
+          mexErrMsgTxt("### the noise matrices have inconsistent sizes");
+      }
+      if (mxGetNumberOfElements(prhs[10]) > 0) {
+        Dnoise = mxGetPr(prhs[10]);
+        if (Bnoise == NULL)
+          Nnoise = mxGetM(prhs[10]);
+        if (mxGetM(prhs[10]) != Nnoise || mxGetN(prhs[10]) != Noutputs)
+          mexErrMsgTxt("### the noise matrices have inconsistent sizes");
+      }
+    }
+    resid = 0;
+    data  = NULL;
+    first = 0;
+    last  = 0;
+    if (nrhs == 10) {
+      resid = 1;
+      data  = mxGetPr(prhs[7]);
+      if (mxGetM(prhs[7]) != Noutputs || mxGetN(prhs[7]) != Nsamples)
+        mexErrMsgTxt("### the data must be a Noutputs x Nsamples matrix");
+      if (mxGetScalar(prhs[8]) < 1.0 || mxGetScalar(prhs[9]) > (double)Nsamples ||
+          mxGetScalar(prhs[8]) > mxGetScalar(prhs[9]))
+        mexErrMsgTxt("### the residual samples must satisfy 1 <= first <= last <= Nsamples");
+      first = (mwSize)mxGetScalar(prhs[8]) - 1;
+      last  = (mwSize)mxGetScalar(prhs[9]);
+    }
+    Nrecord = resid ? 0 : Nsamples / Ndecim;
+    scale   = avg ? 1.0/(double)Ndecim : 1.0;
+
+    /* the state outputs are only computed if they are requested */
+    if (nlhs < 3)
+      Nstatesout = 0;
+
     #if DEBUG
     mexPrintf("Ninputs: %d\n", Ninputs);
     mexPrintf("Nsamples: %d\n", Nsamples);
     mexPrintf("Nstates: %d\n", Nstates);
     mexPrintf("Nstatesout: %d\n", Nstatesout);
     mexPrintf("Noutputs: %d\n", Noutputs);
+    mexPrintf("Nnoise: %d\n", Nnoise);
+    mexPrintf("Ndecim: %d\n", Ndecim);
+    mexPrintf("Nrecord: %d\n", Nrecord);
     
     mexPrintf("N Coutputs: %d\n", mxGetNumberOfElements(prhs[2]));  
     
@@ -81,39 +176,105 @@ void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     mexPrintf("D: %dx%d\n", mxGetN(prhs[5]), mxGetM(prhs[5]));    
     #endif
             
-    /* output y */
-    plhs[0] = mxCreateDoubleMatrix(Noutputs, Nsamples, mxREAL);
-    y = mxGetPr(plhs[0]);
+    /* output y, or the residual cross-products */
+    y = NULL;
+    R = NULL;
+    if (resid) {
+      plhs[0] = mxCreateDoubleMatrix(Noutputs, Noutputs, mxREAL);
+      R = mxGetPr(plhs[0]);
+    }
+    else {
+      plhs[0] = mxCreateDoubleMatrix(Noutputs, Nrecord, mxREAL);
+      y = mxGetPr(plhs[0]);
+    }
     
     /* output state vector*/
     plhs[1] = mxCreateDoubleMatrix(Nstates, 1, mxREAL);
     lastX = mxGetPr(plhs[1]);
     
+    /* output states */
+    x = NULL;
+    if (nlhs == 3) {
+      plhs[2] = mxCreateDoubleMatrix(Nstatesout, Nrecord, mxREAL);
+      x = mxGetPr(plhs[2]);
+    }
+
     tmpX  = (double*)calloc(Nstates, sizeof(double));
+    tmpY  = (double*)calloc(Noutputs+1, sizeof(double));
+    noise = (double*)calloc(Nnoise+1, sizeof(double));
+    res   = (double*)calloc(Noutputs+1, sizeof(double));
     memcpy(lastX, SSini, Nstates*sizeof(double));
     
     /* do the business */
-    yptr = &(y[0]);
     for (kk=0; kk<Nsamples; kk++) {
       
       ki = kk*Ninputs;
+      kb = kk / Ndecim;
+      kr = kk % Ndecim;
+
+      /* white noise for this sample */
+      if (Nnoise > 0)
+        philox_randn(seed, (philox_uint64)kk, 0, noise, (int)Nnoise);
       
-      /* observation equation */
-      Coptr = &(Coutputs[0]);
-      Dptr  = &(Daos[0]);
-      for (jj=0; jj<Noutputs; jj++) {
-        *yptr = 0.0;
-        for (ll=0; ll<Nstates; ll++) {
-          *yptr += *Coptr * lastX[ll] ;
-          Coptr++;
+      /* only evaluate the observation equations for samples we keep */
+      if ( resid ? (kk >= first) : ((kb < Nrecord) && (avg || kr == 0)) ) {
+
+        /* observation equation */
+        Coptr = &(Coutputs[0]);
+        Dptr  = &(Daos[0]);
+        for (jj=0; jj<Noutputs; jj++) {
+          tmpY[jj] = 0.0;
+          for (ll=0; ll<Nstates; ll++) {
+            tmpY[jj] += *Coptr * lastX[ll] ;
+            Coptr++;
+          }
+          iptr = &(input[ki]);
+          for (ll=0; ll<Ninputs; ll++) {
+            tmpY[jj] += *Dptr * (*iptr);
+            Dptr++;
+            iptr++;
+          }
+        }
+        if (Dnoise != NULL && Nnoise > 0) {
+          Dnptr = &(Dnoise[0]);
+          for (jj=0; jj<Noutputs; jj++) {
+            for (ll=0; ll<Nnoise; ll++) {
+              tmpY[jj] += *Dnptr * noise[ll];
+              Dnptr++;
+            }
+          }
         }        
-        iptr = &(input[ki]);
-        for (ll=0; ll<Ninputs; ll++) {
-          *yptr += *Dptr * (*iptr);
-          Dptr++;
-          iptr++;
+
+        if (resid) {
+          /* residuals, upper triangle of their cross-products */
+          for (jj=0; jj<Noutputs; jj++) {
+            res[jj] = data[kk*Noutputs+jj] - tmpY[jj];
+          }
+          for (ll=0; ll<Noutputs; ll++) {
+            for (jj=0; jj<=ll; jj++) {
+              R[jj+ll*Noutputs] += res[jj]*res[ll];
+            }
+          }
+        }
+        else {
+          /* the output array is zero-initialised, so we can accumulate */
+          yptr = &(y[kb*Noutputs]);
+          for (jj=0; jj<Noutputs; jj++) {
+            yptr[jj] += scale * tmpY[jj];
+          }
+        }
+
+        /* state observation */
+        if (x != NULL) {
+          Csptr = &(Cstates[0]);
+          xptr  = &(x[kb*Nstatesout]);
+          for (jj=0; jj<Nstatesout; jj++) {
+            for (ll=0; ll<Nstates; ll++) {
+              xptr[jj] += scale * (*Csptr) * lastX[ll];
+              Csptr++;
+            }
+          }
         }
-        yptr++;
       }  
             
       /* state propagation */
@@ -133,12 +294,35 @@ void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
           iptr++;
         }
       }  
+      if (Bnoise != NULL && Nnoise > 0) {
+        Bnptr = &(Bnoise[0]);
+        for (jj=0; jj<Nstates; jj++) {
+          for (ll=0; ll<Nnoise; ll++) {
+            lastX[jj] += *Bnptr * noise[ll];
+            Bnptr++;
+          }
+        }
+      }
       
+      /* the residuals are complete */
+      if (resid && kk+1 >= last)
+        break;
       
     } /* end sample loop */
     
+    /* fill the lower triangle */
+    if (resid) {
+      for (ll=0; ll<Noutputs; ll++) {
+        for (jj=ll+1; jj<Noutputs; jj++) {
+          R[jj+ll*Noutputs] = R[ll+jj*Noutputs];
+        }
+      }
+    }
     
     free(tmpX);
+    free(tmpY);
+    free(noise);
+    free(res);
     
     
   }
@@ -151,7 +335,11 @@ void  mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
 void print_usage(char *version)
 {
   mexPrintf("ltpda_ssmsim version %s\n", version);
-  mexPrintf("  usage:    [y,lx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input);");
+  mexPrintf("  usage:    [y,lx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input);\n");
+  mexPrintf("            [y,lx,x] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, Ndecim, avg);\n");
+  mexPrintf("            [y,lx,x] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, Ndecim, avg, Bnoise.', Dnoise.', seed);\n");
+  mexPrintf("            [R,lx]   = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, data, first, last);\n");
+  mexPrintf("            v        = ltpda_ssmsim('version');\n");
   mexErrMsgTxt("### incorrect usage");
 }
  
\ No newline at end of file
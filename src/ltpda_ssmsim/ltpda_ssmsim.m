@@ -2,6 +2,10 @@
 % LTPDA_SSMSIM A mex file to propagate an input signal for a given SS model.
 %
 % function [y,x] = ltpda_ssmsim(lastX, A, Coutputs, Cstates, Baos, Daos, input);
+% function [y,x,xs] = ltpda_ssmsim(lastX, A, Coutputs, Cstates, Baos, Daos, input, Ndecim, avg);
+% function [y,x,xs] = ltpda_ssmsim(lastX, A, Coutputs, Cstates, Baos, Daos, input, Ndecim, avg, Bnoise, Dnoise, seed);
+% function [R,x] = ltpda_ssmsim(lastX, A, Coutputs, Cstates, Baos, Daos, input, data, first, last);
+% function v = ltpda_ssmsim('version');
 %
 % Inputs:
 %      lastX - the initial states
@@ -11,10 +15,30 @@
 %       Baos - The B matrix with elements only for the input AOs
 %       Daos - The D matrix with elements only for the input AOs
 %      input - The input signal vector
+%     Ndecim - (optional) store one output sample every Ndecim samples
+%        avg - (optional) 0: store the first sample of each block
+%                         1: store the mean over each block
+%     Bnoise - (optional) The B matrix for unit-variance white noise inputs
+%     Dnoise - (optional) The D matrix for unit-variance white noise inputs
+%       seed - (optional) The seed of the noise generator
+%       data - (residual mode) The measured outputs, Noutputs x Nsamples
+%      first - (residual mode) The first sample of the residuals (1-based)
+%       last - (residual mode) The last sample of the residuals
 %     
 % Outputs:
 %      y = the output signal
 %      x = the output state vector
+%     xs = the selected states (Cstates*x)
+%      R = (residual mode) sum(r*r.') of the residuals r = data - y over
+%          the samples first..last. x is then the state after 'last'.
+%      v = the version of the compiled file, 1.3 or later for the forms
+%          above
+%
+% The matrices are passed transposed, e.g. A.'. A trailing partial
+% decimation block is propagated but not stored.
+%
+% The noise is drawn sample by sample from a Philox4x32-10 counter-based
+% generator: noise input j at sample k only depends on (seed, k, j).
 %
 % M Hewitson 19-08-10
 % 
@@ -15,7 +15,7 @@ Nruns = 100;
 [yx,xx,lxx,y,x,lx] = validate_mex(Nsamples, Nstates, Nstatesout, Ninputs, Noutputs);
 
 sum(sum(yx-y))
-% sum(sum(xx-x))
+sum(sum(xx-x))
 sum(sum(lxx-lx))
 
 return
@@ -9,8 +9,7 @@ function [yx,xx,lxx,y,x,lx] = validate_mex(Nsamples, Nstates, Nstatesout, Ninput
   Daos      = rand(Noutputs, Ninputs);
   input     = randn(Ninputs, Nsamples);
   
-  xx = [];
-  [yx,lxx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates, Baos.', Daos.', input);
+  [yx,lxx,xx] = ltpda_ssmsim(lastX, A.', Coutputs.', Cstates.', Baos.', Daos.', input, 1, 0);
   [y,x,lx] = mat_ssmsim(lastX, A, Coutputs, Cstates, Baos, Daos, input);
   
   
@@ -1 +1 @@
-#define VERSION "1.0"
+#define VERSION "1.3"
\ No newline at end of file